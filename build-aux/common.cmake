@@ -230,4 +230,25 @@ macro(CL_BUILD_COMPILER_PLUGIN PLUGIN ANALYZER LIBCL_PATH)
         target_link_libraries(${PLUGIN} ${CLGCC_LIB})
     endif()
     target_link_libraries(${PLUGIN} ${CL_LIB} ${ANALYZER})
+
+    # libcl runs the preprocessing of CodeStorage in multiple threads
+    find_package(Threads)
+    target_link_libraries(${PLUGIN} ${CMAKE_THREAD_LIBS_INIT})
+endmacro()
+
+# build executable RUNNER, which runs ANALYZER on a code snapshot written by the
+# dump-snapshot option of a compiler plug-in, using CL from LIBCL_PATH
+macro(CL_BUILD_SNAPSHOT_RUNNER RUNNER ANALYZER LIBCL_PATH)
+    add_executable(${RUNNER} ${CMAKE_CURRENT_SOURCE_DIR}/../cl/snaprun.cc)
+
+    if("${LIBCL_PATH}" STREQUAL "")
+        set(CL_LIB cl)
+    else()
+        find_library(CL_LIB cl PATHS ${LIBCL_PATH} NO_DEFAULT_PATH)
+    endif()
+
+    # libcl and the analyzer depend on each other
+    find_package(Threads)
+    target_link_libraries(${RUNNER} ${CL_LIB} ${ANALYZER} ${CL_LIB}
+        ${CMAKE_THREAD_LIBS_INIT})
 endmacro()
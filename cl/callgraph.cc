@@ -22,11 +22,17 @@
 
 #include <cl/cl_msg.hh>
 #include <cl/clutil.hh>
+#include <cl/phase.hh>
 #include <cl/storage.hh>
 
 #include "stopwatch.hh"
+#include "util.hh"
 #include "worklist.hh"
 
+#include <algorithm>
+#include <stack>
+#include <vector>
+
 #include <boost/foreach.hpp>
 
 namespace CodeStorage {
@@ -161,9 +167,113 @@ void buildTopList(Graph &cg)
     }
 }
 
+struct SccData {
+    int                         index;
+    int                         lowLink;
+    bool                        onStack;
+};
+
+typedef std::map<const Node *, SccData>                         TSccDataMap;
+typedef std::pair<Node *, TInsnListByFnc::const_iterator>       TDfsItem;
+
+void sccVisit(
+        TSccDataMap                 &data,
+        std::vector<Node *>         &sccStack,
+        std::stack<TDfsItem>        &dfsStack,
+        int                         &index,
+        Node                        *node)
+{
+    const SccData nd = { index, index, true };
+    data[node] = nd;
+    ++index;
+
+    sccStack.push_back(node);
+    dfsStack.push(TDfsItem(node, node->calls.begin()));
+}
+
+void sccPop(Graph &cg, std::vector<Node *> &sccStack, TSccDataMap &data,
+            Node *root)
+{
+    const unsigned idx = cg.sccs.size();
+    cg.sccs.push_back(TFncList());
+    TFncList &scc = cg.sccs.back();
+
+    std::vector<Node *> members;
+    Node *node;
+    do {
+        node = sccStack.back();
+        sccStack.pop_back();
+        data[node].onStack = false;
+        node->scc = idx;
+        members.push_back(node);
+        scc.push_back(node->fnc);
+    }
+    while (node != root);
+
+    // a single function is recursive only if it calls itself directly
+    const bool recursive = (1 < members.size())
+        || hasKey(root->calls, root->fnc);
+
+    BOOST_FOREACH(Node *member, members)
+        member->recursive = recursive;
+}
+
+/// Tarjan's algorithm, iterative so that long chains of calls are not an issue
+void buildSccList(Graph &cg, const Storage &stor)
+{
+    TSccDataMap data;
+    std::vector<Node *> sccStack;
+    std::stack<TDfsItem> dfsStack;
+    int index = 0;
+
+    BOOST_FOREACH(Fnc *fnc, stor.fncs) {
+        Node *start = fnc->cgNode;
+        if (!start || hasKey(data, start))
+            continue;
+
+        sccVisit(data, sccStack, dfsStack, index, start);
+        while (!dfsStack.empty()) {
+            TDfsItem &item = dfsStack.top();
+            Node *node = item.first;
+            if (node->calls.end() != item.second) {
+                Fnc *callee = (item.second++)->first;
+                if (!callee)
+                    // ignore indirect calls
+                    continue;
+
+                Node *next = callee->cgNode;
+                if (!hasKey(data, next))
+                    sccVisit(data, sccStack, dfsStack, index, next);
+                else if (data[next].onStack)
+                    data[node].lowLink =
+                        std::min(data[node].lowLink, data[next].index);
+
+                continue;
+            }
+
+            // all callees of the node have been processed
+            dfsStack.pop();
+            const SccData &nd = data[node];
+            if (!dfsStack.empty()) {
+                SccData &caller = data[dfsStack.top().first];
+                caller.lowLink = std::min(caller.lowLink, nd.lowLink);
+            }
+
+            if (nd.lowLink == nd.index)
+                // the node is the root of an SCC
+                sccPop(cg, sccStack, data, node);
+        }
+    }
+
+    // Tarjan's algorithm gives the SCCs in reverse topological order already
+    BOOST_FOREACH(const TFncList &scc, cg.sccs)
+        cg.bottomUpOrder.insert(cg.bottomUpOrder.end(), scc.begin(), scc.end());
+}
+
 void buildCallGraph(const Storage &stor)
 {
     StopWatch watch;
+    PhaseTimer timer("buildCallGraph");
 
     BOOST_FOREACH(Fnc *fnc, stor.fncs)
         handleFnc(fnc);
@@ -179,6 +289,9 @@ void buildCallGraph(const Storage &stor)
     // construct topological order
     buildTopList(cg);
 
+    // find strongly connected components and the bottom-up order
+    buildSccList(cg, stor);
+
     CL_DEBUG("buildCallGraph() took " << watch);
 }
 
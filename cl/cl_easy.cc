@@ -24,6 +24,7 @@
 #include <cl/easy.hh>
 #include <cl/killer.hh>
 #include <cl/memdebug.hh>
+#include <cl/phase.hh>
 #include <cl/storage.hh>
 
 #include "callgraph.hh"
@@ -79,6 +80,7 @@ class ClEasy: public ClStorageBuilder {
 
             CL_DEBUG("ClEasy is calling the analyzer...");
             StopWatch watch;
+            PhaseTimer timer("clEasyRun");
             clEasyRun(stor, configString_.c_str());
             CL_PRINT_TIME(watch);
         }
@@ -34,6 +34,9 @@ struct cl_code_listener* cl_create_listener_wrap(ICodeListener *);
  */
 ICodeListener* cl_obtain_from_wrap(struct cl_code_listener *);
 
+/// print the summary of phases and write the trace, see cl_phase_trace_init()
+void cl_phase_trace_flush(void);
+
 /**
  * evaluates as true if the given (struct cl_loc *) pLoc is valid location info
  */
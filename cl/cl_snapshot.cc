@@ -0,0 +1,1430 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This file is part of predator.
+ *
+ * predator is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * predator is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with predator.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "config_cl.h"
+#include "cl_snapshot.hh"
+
+#include <cl/cl_msg.hh>
+
+#include "cl.hh"
+#include "util.hh"
+
+#include <algorithm>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <map>
+#include <set>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <boost/foreach.hpp>
+
+#include <fcntl.h>
+#include <stdint.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// /////////////////////////////////////////////////////////////////////////////
+// snapshot file format
+//
+// The file starts with SnapHeader, which is followed by six sections:
+//  - string table (zero-terminated strings referred to by their offsets)
+//  - type table (cntTypes records, types refer to each other by uid)
+//  - variable table (cntVars records, each of them says the scope of the var)
+//  - initializer table (initializers of the variables that have any)
+//  - function table (cntFncs records, the scope and name of each function)
+//  - event stream (calls of the code listener in the order they were made)
+//
+// The variable and function tables make it possible to link several snapshots
+// together by name before any of the events is replayed.
+//
+// All values are stored in the byte order of the machine that wrote the file,
+// loading of a snapshot with a different byte order or version is refused.
+// The string table is used in place (directly from the memory mapped file).
+namespace {
+    const char      SNAP_MAGIC[8]   = { 'C', 'L', 'S', 'N', 'A', 'P', 0, 0 };
+    const uint32_t  SNAP_VERSION    = 2;
+    const uint32_t  SNAP_BYTE_ORDER = 0x01020304;
+    const uint32_t  SNAP_NO_STRING  = 0xFFFFFFFF;
+    const uint8_t   SNAP_NO_OPERAND = 0xFF;
+
+    struct SnapHeader {
+        char        magic[8];
+        uint32_t    version;
+        uint32_t    byteOrder;
+        uint32_t    cntTypes;
+        uint32_t    cntVars;
+        uint32_t    cntFncs;
+        uint32_t    reserved;
+        uint64_t    strOff,     strSize;
+        uint64_t    typeOff,    typeSize;
+        uint64_t    varOff,     varSize;
+        uint64_t    initOff,    initSize;
+        uint64_t    fncOff,     fncSize;
+        uint64_t    eventOff,   eventSize;
+    };
+
+    enum ESnapEvent {
+        SE_FILE_OPEN = 1,
+        SE_FILE_CLOSE,
+        SE_FNC_OPEN,
+        SE_FNC_ARG_DECL,
+        SE_FNC_CLOSE,
+        SE_BB_OPEN,
+        SE_INSN,
+        SE_INSN_CALL_OPEN,
+        SE_INSN_CALL_ARG,
+        SE_INSN_CALL_CLOSE,
+        SE_INSN_SWITCH_OPEN,
+        SE_INSN_SWITCH_CASE,
+        SE_INSN_SWITCH_CLOSE
+    };
+}
+
+// /////////////////////////////////////////////////////////////////////////////
+// ClSnapshotWriter
+class ClSnapshotWriter: public ICodeListener {
+    public:
+        ClSnapshotWriter(const char *fileName):
+            fileName_(fileName)
+        {
+        }
+
+        virtual void file_open(const char *file_name) {
+            this->putEvent(SE_FILE_OPEN);
+            this->putStr(events_, file_name);
+        }
+
+        virtual void file_close() {
+            this->putEvent(SE_FILE_CLOSE);
+        }
+
+        virtual void fnc_open(const struct cl_operand *fnc) {
+            this->putEvent(SE_FNC_OPEN);
+            this->putOperand(events_, fnc);
+            if (CL_OPERAND_CST == fnc->code)
+                // the function is defined in this translation unit
+                fncs_[fnc->data.cst.data.cst_fnc.uid].defined = 1;
+        }
+
+        virtual void fnc_arg_decl(int arg_id, const struct cl_operand *arg_src)
+        {
+            this->putEvent(SE_FNC_ARG_DECL);
+            this->put<int32_t>(events_, arg_id);
+            this->putOperand(events_, arg_src);
+        }
+
+        virtual void fnc_close() {
+            this->putEvent(SE_FNC_CLOSE);
+        }
+
+        virtual void bb_open(const char *bb_name) {
+            this->putEvent(SE_BB_OPEN);
+            this->putStr(events_, bb_name);
+        }
+
+        virtual void insn(const struct cl_insn *cli) {
+            this->putEvent(SE_INSN);
+            this->putInsn(events_, cli);
+        }
+
+        virtual void insn_call_open(
+            const struct cl_loc     *loc,
+            const struct cl_operand *dst,
+            const struct cl_operand *fnc)
+        {
+            this->putEvent(SE_INSN_CALL_OPEN);
+            this->putLoc(events_, loc);
+            this->putOperand(events_, dst);
+            this->putOperand(events_, fnc);
+        }
+
+        virtual void insn_call_arg(int arg_id, const struct cl_operand *arg_src)
+        {
+            this->putEvent(SE_INSN_CALL_ARG);
+            this->put<int32_t>(events_, arg_id);
+            this->putOperand(events_, arg_src);
+        }
+
+        virtual void insn_call_close() {
+            this->putEvent(SE_INSN_CALL_CLOSE);
+        }
+
+        virtual void insn_switch_open(
+            const struct cl_loc     *loc,
+            const struct cl_operand *src)
+        {
+            this->putEvent(SE_INSN_SWITCH_OPEN);
+            this->putLoc(events_, loc);
+            this->putOperand(events_, src);
+        }
+
+        virtual void insn_switch_case(
+            const struct cl_loc     *loc,
+            const struct cl_operand *val_lo,
+            const struct cl_operand *val_hi,
+            const char              *label)
+        {
+            this->putEvent(SE_INSN_SWITCH_CASE);
+            this->putLoc(events_, loc);
+            this->putOperand(events_, val_lo);
+            this->putOperand(events_, val_hi);
+            this->putStr(events_, label);
+        }
+
+        virtual void insn_switch_close() {
+            this->putEvent(SE_INSN_SWITCH_CLOSE);
+        }
+
+        virtual void acknowledge();
+
+    private:
+        struct FncInfo {
+            uint32_t                name;
+            uint8_t                 scope;
+            uint8_t                 defined;
+        };
+
+        typedef std::map<cl_uid_t, const struct cl_type *>      TTypeMap;
+        typedef std::map<cl_uid_t, const struct cl_var *>       TVarMap;
+        typedef std::map<cl_uid_t, FncInfo>                     TFncMap;
+        typedef std::map<std::string, uint32_t>                 TStrMap;
+        typedef std::pair<const struct cl_var *, enum cl_scope_e> TVarRef;
+
+        std::string             fileName_;
+        std::string             events_;
+        std::string             strTab_;
+        TStrMap                 strIdx_;
+        TTypeMap                types_;
+        TVarMap                 vars_;
+        TFncMap                 fncs_;
+        std::vector<TVarRef>    varTodo_;
+
+        template <typename T>
+        void put(std::string &dst, const T val) {
+            dst.append(reinterpret_cast<const char *>(&val), sizeof val);
+        }
+
+        void putEvent(ESnapEvent code) {
+            this->put<uint8_t>(events_, code);
+        }
+
+        void putStr(std::string &dst, const char *str) {
+            this->put<uint32_t>(dst, this->strRef(str));
+        }
+
+        uint32_t strRef(const char *str);
+        void putLoc(std::string &dst, const struct cl_loc *loc);
+        void putTypeRef(std::string &dst, const struct cl_type *clt);
+        void putVarRef(std::string &dst, const struct cl_operand *op);
+        void putCst(std::string &dst, const struct cl_operand *op);
+        void putOperand(std::string &dst, const struct cl_operand *op);
+        void putInsn(std::string &dst, const struct cl_insn *cli);
+        void putType(std::string &dst, const struct cl_type *clt);
+        void putVar(std::string &dst, const TVarRef &ref);
+        void putInitials(std::string &dst, const struct cl_var *clv);
+};
+
+uint32_t ClSnapshotWriter::strRef(const char *str)
+{
+    if (!str)
+        return SNAP_NO_STRING;
+
+    const std::string key(str);
+    TStrMap::const_iterator it = strIdx_.find(key);
+    if (strIdx_.end() != it)
+        // already in the string table
+        return it->second;
+
+    const uint32_t off = strTab_.size();
+    strTab_.append(key);
+    strTab_.push_back('\0');
+    strIdx_[key] = off;
+    return off;
+}
+
+void ClSnapshotWriter::putLoc(std::string &dst, const struct cl_loc *loc)
+{
+    if (!loc)
+        loc = &cl_loc_unknown;
+
+    this->putStr(dst, loc->file);
+    this->put<int32_t>(dst, loc->line);
+    this->put<int32_t>(dst, loc->column);
+    this->put<uint8_t>(dst, loc->sysp);
+}
+
+void ClSnapshotWriter::putTypeRef(std::string &dst, const struct cl_type *clt)
+{
+    this->put<uint8_t>(dst, !!clt);
+    if (!clt)
+        return;
+
+    this->put<int64_t>(dst, clt->uid);
+    if (!types_.insert(TTypeMap::value_type(clt->uid, clt)).second)
+        // already registered
+        return;
+
+    // register all the types this type refers to
+    std::string dummy;
+    for (int i = 0; i < clt->item_cnt; ++i)
+        this->putTypeRef(dummy, clt->items[i].type);
+}
+
+void ClSnapshotWriter::putVarRef(std::string &dst, const struct cl_operand *op)
+{
+    const struct cl_var *clv = op->data.var;
+    this->put<int64_t>(dst, clv->uid);
+    if (vars_.insert(TVarMap::value_type(clv->uid, clv)).second)
+        // the variables are going to be written out in acknowledge()
+        varTodo_.push_back(TVarRef(clv, op->scope));
+}
+
+void ClSnapshotWriter::putCst(std::string &dst, const struct cl_operand *op)
+{
+    const struct cl_cst &cst = op->data.cst;
+    this->put<uint8_t>(dst, cst.code);
+    switch (cst.code) {
+        case CL_TYPE_FNC:
+            this->put<int64_t>(dst, cst.data.cst_fnc.uid);
+            this->putStr(dst, cst.data.cst_fnc.name);
+            this->put<uint8_t>(dst, cst.data.cst_fnc.is_extern);
+            this->putLoc(dst, &cst.data.cst_fnc.loc);
+            if (!hasKey(fncs_, cst.data.cst_fnc.uid)) {
+                // register the function for the function table
+                FncInfo &fi = fncs_[cst.data.cst_fnc.uid];
+                fi.name     = this->strRef(cst.data.cst_fnc.name);
+                fi.scope    = op->scope;
+                fi.defined  = 0;
+            }
+            break;
+
+        case CL_TYPE_STRING:
+            this->putStr(dst, cst.data.cst_string.value);
+            break;
+
+        case CL_TYPE_REAL:
+            this->put<double>(dst, cst.data.cst_real.value);
+            break;
+
+        default:
+            // cst_int and cst_uint share the storage
+            this->put<int64_t>(dst, cst.data.cst_int.value);
+    }
+}
+
+void ClSnapshotWriter::putOperand(std::string &dst, const struct cl_operand *op)
+{
+    if (!op) {
+        this->put<uint8_t>(dst, SNAP_NO_OPERAND);
+        return;
+    }
+
+    this->put<uint8_t>(dst, op->code);
+    this->put<uint8_t>(dst, op->scope);
+    this->putTypeRef(dst, op->type);
+
+    uint32_t cntAccessors = 0;
+    for (const struct cl_accessor *ac = op->accessor; ac; ac = ac->next)
+        ++cntAccessors;
+
+    this->put<uint32_t>(dst, cntAccessors);
+    for (const struct cl_accessor *ac = op->accessor; ac; ac = ac->next) {
+        this->put<uint8_t>(dst, ac->code);
+        this->putTypeRef(dst, ac->type);
+        switch (ac->code) {
+            case CL_ACCESSOR_REF:
+            case CL_ACCESSOR_DEREF:
+                break;
+
+            case CL_ACCESSOR_DEREF_ARRAY:
+                this->putOperand(dst, ac->data.array.index);
+                break;
+
+            case CL_ACCESSOR_ITEM:
+                this->put<int32_t>(dst, ac->data.item.id);
+                break;
+
+            case CL_ACCESSOR_OFFSET:
+                this->put<int32_t>(dst, ac->data.offset.off);
+                break;
+        }
+    }
+
+    switch (op->code) {
+        case CL_OPERAND_VOID:
+            break;
+
+        case CL_OPERAND_VAR:
+            this->putVarRef(dst, op);
+            break;
+
+        case CL_OPERAND_CST:
+            this->putCst(dst, op);
+            break;
+    }
+}
+
+void ClSnapshotWriter::putInsn(std::string &dst, const struct cl_insn *cli)
+{
+    this->put<uint8_t>(dst, cli->code);
+    this->putLoc(dst, &cli->loc);
+
+    switch (cli->code) {
+        case CL_INSN_NOP:
+        case CL_INSN_ABORT:
+            break;
+
+        case CL_INSN_JMP:
+            this->putStr(dst, cli->data.insn_jmp.label);
+            break;
+
+        case CL_INSN_COND:
+            this->putOperand(dst, cli->data.insn_cond.src);
+            this->putStr(dst, cli->data.insn_cond.then_label);
+            this->putStr(dst, cli->data.insn_cond.else_label);
+            break;
+
+        case CL_INSN_RET:
+            this->putOperand(dst, cli->data.insn_ret.src);
+            break;
+
+        case CL_INSN_CLOBBER:
+            this->putOperand(dst, cli->data.insn_clobber.var);
+            break;
+
+        case CL_INSN_UNOP:
+            this->put<uint8_t>(dst, cli->data.insn_unop.code);
+            this->putOperand(dst, cli->data.insn_unop.dst);
+            this->putOperand(dst, cli->data.insn_unop.src);
+            break;
+
+        case CL_INSN_BINOP:
+            this->put<uint8_t>(dst, cli->data.insn_binop.code);
+            this->putOperand(dst, cli->data.insn_binop.dst);
+            this->putOperand(dst, cli->data.insn_binop.src1);
+            this->putOperand(dst, cli->data.insn_binop.src2);
+            break;
+
+        case CL_INSN_LABEL:
+            this->putStr(dst, cli->data.insn_label.name);
+            break;
+
+        case CL_INSN_CALL:
+        case CL_INSN_SWITCH:
+            CL_TRAP;
+    }
+}
+
+void ClSnapshotWriter::putType(std::string &dst, const struct cl_type *clt)
+{
+    this->put<int64_t>(dst, clt->uid);
+    this->put<uint8_t>(dst, clt->code);
+    this->putLoc(dst, &clt->loc);
+    this->put<uint8_t>(dst, clt->scope);
+    this->putStr(dst, clt->name);
+    this->put<int32_t>(dst, clt->size);
+    this->put<int32_t>(dst, clt->item_cnt);
+    for (int i = 0; i < clt->item_cnt; ++i) {
+        const struct cl_type_item &item = clt->items[i];
+        this->putTypeRef(dst, item.type);
+        this->putStr(dst, item.name);
+        this->put<int32_t>(dst, item.offset);
+    }
+    this->put<int32_t>(dst, clt->array_size);
+    this->put<uint8_t>(dst, clt->is_unsigned);
+    this->put<uint8_t>(dst, clt->is_const);
+    this->put<uint8_t>(dst, clt->ptr_type);
+}
+
+void ClSnapshotWriter::putVar(std::string &dst, const TVarRef &ref)
+{
+    const struct cl_var *clv = ref.first;
+    this->put<int64_t>(dst, clv->uid);
+    this->put<uint8_t>(dst, ref.second);
+    this->putStr(dst, clv->name);
+    this->put<uint8_t>(dst, clv->artificial);
+    this->putLoc(dst, &clv->loc);
+    this->put<uint8_t>(dst, clv->initialized);
+    this->put<uint8_t>(dst, clv->is_extern);
+}
+
+void ClSnapshotWriter::putInitials(std::string &dst, const struct cl_var *clv)
+{
+    if (!clv->initial)
+        // nothing to write
+        return;
+
+    uint32_t cntInitials = 0;
+    const struct cl_initializer *initial;
+    for (initial = clv->initial; initial; initial = initial->next)
+        ++cntInitials;
+
+    this->put<int64_t>(dst, clv->uid);
+    this->put<uint32_t>(dst, cntInitials);
+    for (initial = clv->initial; initial; initial = initial->next)
+        this->putInsn(dst, &initial->insn);
+}
+
+void ClSnapshotWriter::acknowledge()
+{
+    // write the initializers first, they may refer to more variables
+    std::string initTab;
+    for (unsigned i = 0; i < varTodo_.size(); ++i)
+        this->putInitials(initTab, varTodo_[i].first);
+
+    std::string varTab;
+    BOOST_FOREACH(const TVarRef &ref, varTodo_)
+        this->putVar(varTab, ref);
+
+    std::string fncTab;
+    BOOST_FOREACH(TFncMap::const_reference item, fncs_) {
+        const FncInfo &fi = item.second;
+        this->put<int64_t>(fncTab, item.first);
+        this->put<uint8_t>(fncTab, fi.scope);
+        this->put<uint32_t>(fncTab, fi.name);
+        this->put<uint8_t>(fncTab, fi.defined);
+    }
+
+    // the types are complete only now
+    std::string typeTab;
+    BOOST_FOREACH(TTypeMap::const_reference item, types_)
+        this->putType(typeTab, item.second);
+
+    SnapHeader hdr;
+    memset(&hdr, 0, sizeof hdr);
+    memcpy(hdr.magic, SNAP_MAGIC, sizeof hdr.magic);
+    hdr.version     = SNAP_VERSION;
+    hdr.byteOrder   = SNAP_BYTE_ORDER;
+    hdr.cntTypes    = types_.size();
+    hdr.cntVars     = vars_.size();
+    hdr.cntFncs     = fncs_.size();
+    hdr.strOff      = sizeof hdr;
+    hdr.strSize     = strTab_.size();
+    hdr.typeOff     = hdr.strOff + hdr.strSize;
+    hdr.typeSize    = typeTab.size();
+    hdr.varOff      = hdr.typeOff + hdr.typeSize;
+    hdr.varSize     = varTab.size();
+    hdr.initOff     = hdr.varOff + hdr.varSize;
+    hdr.initSize    = initTab.size();
+    hdr.fncOff      = hdr.initOff + hdr.initSize;
+    hdr.fncSize     = fncTab.size();
+    hdr.eventOff    = hdr.fncOff + hdr.fncSize;
+    hdr.eventSize   = events_.size();
+
+    std::ofstream out(fileName_.c_str(), std::ios::out | std::ios::binary);
+    out.write(reinterpret_cast<const char *>(&hdr), sizeof hdr);
+    out << strTab_ << typeTab << varTab << initTab << fncTab << events_;
+    out.close();
+
+    if (!out)
+        CL_ERROR("error writing code snapshot to '" << fileName_ << "'");
+    else
+        CL_DEBUG("code snapshot written to '" << fileName_ << "': "
+                << hdr.cntTypes << " types, " << hdr.cntVars << " variables, "
+                << hdr.cntFncs << " functions");
+}
+
+// /////////////////////////////////////////////////////////////////////////////
+// snapshot loader and linker
+namespace {
+    typedef std::map<cl_uid_t, struct cl_type *>        TTypeMap;
+    typedef std::map<cl_uid_t, struct cl_var *>         TVarMap;
+    typedef std::map<cl_uid_t, cl_uid_t>                TUidMap;
+    typedef std::map<cl_uid_t, enum cl_scope_e>         TScopeMap;
+
+    /// a single snapshot (translation unit) taking part in the linking
+    struct SnapUnit {
+        std::string                                     fileName;
+        const char                                     *base;
+        SnapHeader                                      hdr;
+        TTypeMap                                        types;  ///< by own uid
+        TVarMap                                         vars;   ///< by own uid
+        TUidMap                                         fncs;   ///< own -> linked
+    };
+
+    /// objects built from snapshots, operands of events are freed per event
+    struct SnapPool {
+        std::deque<struct cl_operand>                   operands;
+        std::deque<struct cl_accessor>                  accessors;
+        std::deque<struct cl_initializer>               initials;
+        std::deque<std::vector<struct cl_type_item> >   items;
+    };
+
+    class SnapReader {
+        public:
+            /// @param create if true, unknown types/vars are created on demand
+            SnapReader(
+                    SnapUnit               &unit,
+                    SnapPool               &pool,
+                    uint64_t                off,
+                    uint64_t                size,
+                    bool                    create = false):
+                unit_(unit),
+                pool_(pool),
+                strTab_(unit.base + unit.hdr.strOff),
+                strSize_(unit.hdr.strSize),
+                cur_(unit.base + off),
+                end_(cur_ + size),
+                create_(create),
+                ok_(true)
+            {
+            }
+
+            bool ok()       const { return ok_; }
+            bool atEnd()    const { return !ok_ || (end_ == cur_); }
+
+            template <typename T>
+            T get() {
+                T val = T();
+                if (static_cast<size_t>(end_ - cur_) < sizeof val) {
+                    ok_ = false;
+                    return val;
+                }
+
+                memcpy(&val, cur_, sizeof val);
+                cur_ += sizeof val;
+                return val;
+            }
+
+            const char* str();
+            void loc(struct cl_loc *dst);
+            struct cl_type* typeRef();
+            struct cl_var* varRef();
+            struct cl_operand* operand();
+            void insn(struct cl_insn *dst);
+            void type();
+            cl_uid_t var(enum cl_scope_e *pScope);
+            void initials();
+
+        private:
+            SnapUnit               &unit_;
+            SnapPool               &pool_;
+            const char             *strTab_;
+            uint64_t                strSize_;
+            const char             *cur_;
+            const char             *end_;
+            bool                    create_;
+            bool                    ok_;
+
+            struct cl_type* typeByUid(cl_uid_t uid);
+            struct cl_var* varByUid(cl_uid_t uid);
+    };
+
+    struct cl_type* SnapReader::typeByUid(cl_uid_t uid)
+    {
+        if (!create_) {
+            const TTypeMap::const_iterator it = unit_.types.find(uid);
+            if (unit_.types.end() != it)
+                return it->second;
+
+            // all the types are known once the type table has been read
+            ok_ = false;
+            return 0;
+        }
+
+        struct cl_type *&clt = unit_.types[uid];
+        if (!clt) {
+            clt = new struct cl_type;
+            memset(clt, 0, sizeof *clt);
+            clt->uid = uid;
+        }
+
+        return clt;
+    }
+
+    struct cl_var* SnapReader::varByUid(cl_uid_t uid)
+    {
+        if (!create_) {
+            const TVarMap::const_iterator it = unit_.vars.find(uid);
+            if (unit_.vars.end() != it)
+                return it->second;
+
+            // all the variables are known once the var table has been read
+            ok_ = false;
+            return 0;
+        }
+
+        struct cl_var *&clv = unit_.vars[uid];
+        if (!clv) {
+            clv = new struct cl_var;
+            memset(clv, 0, sizeof *clv);
+            clv->uid = uid;
+        }
+
+        return clv;
+    }
+
+    const char* SnapReader::str()
+    {
+        const uint32_t off = this->get<uint32_t>();
+        if (SNAP_NO_STRING == off)
+            return 0;
+
+        if (strSize_ <= off) {
+            ok_ = false;
+            return 0;
+        }
+
+        return strTab_ + off;
+    }
+
+    void SnapReader::loc(struct cl_loc *dst)
+    {
+        dst->file   = this->str();
+        dst->line   = this->get<int32_t>();
+        dst->column = this->get<int32_t>();
+        dst->sysp   = this->get<uint8_t>();
+    }
+
+    struct cl_type* SnapReader::typeRef()
+    {
+        if (!this->get<uint8_t>())
+            return 0;
+
+        return this->typeByUid(this->get<int64_t>());
+    }
+
+    struct cl_var* SnapReader::varRef()
+    {
+        return this->varByUid(this->get<int64_t>());
+    }
+
+    struct cl_operand* SnapReader::operand()
+    {
+        const uint8_t code = this->get<uint8_t>();
+        if (!ok_ || SNAP_NO_OPERAND == code)
+            return 0;
+
+        pool_.operands.push_back(cl_operand());
+        struct cl_operand *op = &pool_.operands.back();
+        memset(op, 0, sizeof *op);
+        op->code    = static_cast<enum cl_operand_e>(code);
+        op->scope   = static_cast<enum cl_scope_e>(this->get<uint8_t>());
+        op->type    = this->typeRef();
+
+        struct cl_accessor **pAc = &op->accessor;
+        for (uint32_t cnt = this->get<uint32_t>(); ok_ && cnt; --cnt) {
+            pool_.accessors.push_back(cl_accessor());
+            struct cl_accessor *ac = &pool_.accessors.back();
+            memset(ac, 0, sizeof *ac);
+            ac->code = static_cast<enum cl_accessor_e>(this->get<uint8_t>());
+            ac->type = this->typeRef();
+            switch (ac->code) {
+                case CL_ACCESSOR_REF:
+                case CL_ACCESSOR_DEREF:
+                    break;
+
+                case CL_ACCESSOR_DEREF_ARRAY:
+                    ac->data.array.index = this->operand();
+                    break;
+
+                case CL_ACCESSOR_ITEM:
+                    ac->data.item.id = this->get<int32_t>();
+                    break;
+
+                case CL_ACCESSOR_OFFSET:
+                    ac->data.offset.off = this->get<int32_t>();
+                    break;
+
+                default:
+                    ok_ = false;
+            }
+
+            *pAc = ac;
+            pAc = &ac->next;
+        }
+
+        struct cl_cst &cst = op->data.cst;
+        TUidMap::const_iterator it;
+        switch (op->code) {
+            case CL_OPERAND_VOID:
+                break;
+
+            case CL_OPERAND_VAR:
+                op->data.var = this->varRef();
+                break;
+
+            case CL_OPERAND_CST:
+                cst.code = static_cast<enum cl_type_e>(this->get<uint8_t>());
+                switch (cst.code) {
+                    case CL_TYPE_FNC:
+                        // translate the uid to the linked one
+                        it = unit_.fncs.find(this->get<int64_t>());
+                        if (unit_.fncs.end() == it)
+                            ok_ = false;
+                        else
+                            cst.data.cst_fnc.uid    = it->second;
+
+                        cst.data.cst_fnc.name       = this->str();
+                        cst.data.cst_fnc.is_extern  = this->get<uint8_t>();
+                        this->loc(&cst.data.cst_fnc.loc);
+                        break;
+
+                    case CL_TYPE_STRING:
+                        cst.data.cst_string.value   = this->str();
+                        break;
+
+                    case CL_TYPE_REAL:
+                        cst.data.cst_real.value     = this->get<double>();
+                        break;
+
+                    default:
+                        cst.data.cst_int.value      = this->get<int64_t>();
+                }
+                break;
+
+            default:
+                ok_ = false;
+        }
+
+        return op;
+    }
+
+    void SnapReader::insn(struct cl_insn *cli)
+    {
+        memset(cli, 0, sizeof *cli);
+        cli->code = static_cast<enum cl_insn_e>(this->get<uint8_t>());
+        this->loc(&cli->loc);
+
+        switch (cli->code) {
+            case CL_INSN_NOP:
+            case CL_INSN_ABORT:
+                break;
+
+            case CL_INSN_JMP:
+                cli->data.insn_jmp.label        = this->str();
+                break;
+
+            case CL_INSN_COND:
+                cli->data.insn_cond.src         = this->operand();
+                cli->data.insn_cond.then_label  = this->str();
+                cli->data.insn_cond.else_label  = this->str();
+                break;
+
+            case CL_INSN_RET:
+                cli->data.insn_ret.src          = this->operand();
+                break;
+
+            case CL_INSN_CLOBBER:
+                cli->data.insn_clobber.var      = this->operand();
+                break;
+
+            case CL_INSN_UNOP:
+                cli->data.insn_unop.code =
+                    static_cast<enum cl_unop_e>(this->get<uint8_t>());
+                cli->data.insn_unop.dst         = this->operand();
+                cli->data.insn_unop.src         = this->operand();
+                break;
+
+            case CL_INSN_BINOP:
+                cli->data.insn_binop.code =
+                    static_cast<enum cl_binop_e>(this->get<uint8_t>());
+                cli->data.insn_binop.dst        = this->operand();
+                cli->data.insn_binop.src1       = this->operand();
+                cli->data.insn_binop.src2       = this->operand();
+                break;
+
+            case CL_INSN_LABEL:
+                cli->data.insn_label.name       = this->str();
+                break;
+
+            default:
+                ok_ = false;
+        }
+    }
+
+    void SnapReader::type()
+    {
+        struct cl_type *clt = this->typeByUid(this->get<int64_t>());
+        clt->code = static_cast<enum cl_type_e>(this->get<uint8_t>());
+        this->loc(&clt->loc);
+        clt->scope      = static_cast<enum cl_scope_e>(this->get<uint8_t>());
+        clt->name       = this->str();
+        clt->size       = this->get<int32_t>();
+        clt->item_cnt   = this->get<int32_t>();
+        if (!ok_ || clt->item_cnt < 0) {
+            ok_ = false;
+            return;
+        }
+
+        pool_.items.push_back(std::vector<struct cl_type_item>(clt->item_cnt));
+        std::vector<struct cl_type_item> &items = pool_.items.back();
+        for (int i = 0; ok_ && i < clt->item_cnt; ++i) {
+            items[i].type   = this->typeRef();
+            items[i].name   = this->str();
+            items[i].offset = this->get<int32_t>();
+        }
+
+        clt->items = (clt->item_cnt) ? &items[0] : 0;
+        clt->array_size = this->get<int32_t>();
+        clt->is_unsigned= this->get<uint8_t>();
+        clt->is_const   = this->get<uint8_t>();
+        clt->ptr_type   = static_cast<enum cl_ptr_type_e>(this->get<uint8_t>());
+    }
+
+    cl_uid_t SnapReader::var(enum cl_scope_e *pScope)
+    {
+        const cl_uid_t uid = this->get<int64_t>();
+        struct cl_var *clv = this->varByUid(uid);
+        *pScope = static_cast<enum cl_scope_e>(this->get<uint8_t>());
+        clv->name           = this->str();
+        clv->artificial     = this->get<uint8_t>();
+        this->loc(&clv->loc);
+        clv->initialized    = this->get<uint8_t>();
+        clv->is_extern      = this->get<uint8_t>();
+        return uid;
+    }
+
+    void SnapReader::initials()
+    {
+        struct cl_var *clv = this->varRef();
+
+        struct cl_initializer *list = 0;
+        struct cl_initializer **pInit = &list;
+        for (uint32_t cnt = this->get<uint32_t>(); ok_ && cnt; --cnt) {
+            pool_.initials.push_back(cl_initializer());
+            struct cl_initializer *initial = &pool_.initials.back();
+            memset(initial, 0, sizeof *initial);
+            this->insn(&initial->insn);
+
+            *pInit = initial;
+            pInit = &initial->next;
+        }
+
+        if (ok_ && !clv->initial)
+            // if a global variable is initialized by several units, the first
+            // initializer wins
+            clv->initial = list;
+    }
+
+    // feed the code listener by the events recorded in the snapshot
+    bool replayEvents(SnapUnit &unit, struct cl_code_listener *cl)
+    {
+        // the code listeners are not allowed to keep pointers to operands, so
+        // the operands are released as soon as the callback returns
+        SnapPool scratch;
+        SnapReader rd(unit, scratch, unit.hdr.eventOff, unit.hdr.eventSize);
+
+        for (; !rd.atEnd(); scratch.operands.clear(), scratch.accessors.clear()) {
+            struct cl_loc loc;
+            struct cl_insn cli;
+            const struct cl_operand *op, *op2;
+            const char *str;
+            int id;
+
+            switch (rd.get<uint8_t>()) {
+                case SE_FILE_OPEN:
+                    str = rd.str();
+                    if (rd.ok())
+                        cl->file_open(cl, str);
+                    break;
+
+                case SE_FILE_CLOSE:
+                    cl->file_close(cl);
+                    break;
+
+                case SE_FNC_OPEN:
+                    op = rd.operand();
+                    if (rd.ok())
+                        cl->fnc_open(cl, op);
+                    break;
+
+                case SE_FNC_ARG_DECL:
+                    id = rd.get<int32_t>();
+                    op = rd.operand();
+                    if (rd.ok())
+                        cl->fnc_arg_decl(cl, id, op);
+                    break;
+
+                case SE_FNC_CLOSE:
+                    cl->fnc_close(cl);
+                    break;
+
+                case SE_BB_OPEN:
+                    str = rd.str();
+                    if (rd.ok())
+                        cl->bb_open(cl, str);
+                    break;
+
+                case SE_INSN:
+                    rd.insn(&cli);
+                    if (rd.ok())
+                        cl->insn(cl, &cli);
+                    break;
+
+                case SE_INSN_CALL_OPEN:
+                    rd.loc(&loc);
+                    op  = rd.operand();
+                    op2 = rd.operand();
+                    if (rd.ok())
+                        cl->insn_call_open(cl, &loc, op, op2);
+                    break;
+
+                case SE_INSN_CALL_ARG:
+                    id = rd.get<int32_t>();
+                    op = rd.operand();
+                    if (rd.ok())
+                        cl->insn_call_arg(cl, id, op);
+                    break;
+
+                case SE_INSN_CALL_CLOSE:
+                    cl->insn_call_close(cl);
+                    break;
+
+                case SE_INSN_SWITCH_OPEN:
+                    rd.loc(&loc);
+                    op = rd.operand();
+                    if (rd.ok())
+                        cl->insn_switch_open(cl, &loc, op);
+                    break;
+
+                case SE_INSN_SWITCH_CASE:
+                    rd.loc(&loc);
+                    op  = rd.operand();
+                    op2 = rd.operand();
+                    str = rd.str();
+                    if (rd.ok())
+                        cl->insn_switch_case(cl, &loc, op, op2, str);
+                    break;
+
+                case SE_INSN_SWITCH_CLOSE:
+                    cl->insn_switch_close(cl);
+                    break;
+
+                default:
+                    return false;
+            }
+        }
+
+        return rd.ok();
+    }
+
+    bool chkSection(uint64_t off, uint64_t size, uint64_t fileSize)
+    {
+        return (off <= fileSize) && (size <= fileSize - off);
+    }
+
+    bool mapSnapshot(SnapUnit &unit)
+    {
+        const char *file_name = unit.fileName.c_str();
+        const int fd = open(file_name, O_RDONLY);
+        if (-1 == fd) {
+            CL_ERROR("failed to open code snapshot '" << file_name << "'");
+            return false;
+        }
+
+        struct stat st;
+        void *map = MAP_FAILED;
+        if (!fstat(fd, &st)
+                && sizeof(SnapHeader) <= static_cast<size_t>(st.st_size))
+            // the string table is used directly from the mapped memory, so
+            // the file needs to stay mapped as long as the process is running
+            map = mmap(0, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+        close(fd);
+        if (MAP_FAILED == map) {
+            CL_ERROR("failed to map code snapshot '" << file_name << "'");
+            return false;
+        }
+
+        const char *base = static_cast<const char *>(map);
+        const uint64_t fileSize = st.st_size;
+
+        SnapHeader &hdr = unit.hdr;
+        memcpy(&hdr, base, sizeof hdr);
+        if (memcmp(hdr.magic, SNAP_MAGIC, sizeof hdr.magic)
+                || SNAP_BYTE_ORDER != hdr.byteOrder
+                || SNAP_VERSION != hdr.version)
+        {
+            CL_ERROR("'" << file_name << "' is not a compatible code snapshot");
+            munmap(map, st.st_size);
+            return false;
+        }
+
+        if (!chkSection(hdr.strOff,     hdr.strSize,    fileSize)
+                || !chkSection(hdr.typeOff,  hdr.typeSize,   fileSize)
+                || !chkSection(hdr.varOff,   hdr.varSize,    fileSize)
+                || !chkSection(hdr.initOff,  hdr.initSize,   fileSize)
+                || !chkSection(hdr.fncOff,   hdr.fncSize,    fileSize)
+                || !chkSection(hdr.eventOff, hdr.eventSize,  fileSize)
+                || (hdr.strSize && base[hdr.strOff + hdr.strSize - 1]))
+        {
+            CL_ERROR("code snapshot '" << file_name << "' is corrupted");
+            munmap(map, st.st_size);
+            return false;
+        }
+
+        unit.base = base;
+        return true;
+    }
+
+    typedef std::pair<const struct cl_type *, const struct cl_type *> TTypePair;
+    typedef std::set<TTypePair>                                       TTypePairSet;
+
+    bool eqNames(const char *a, const char *b)
+    {
+        if (!a || !b)
+            return (a == b);
+
+        return !strcmp(a, b);
+    }
+
+    /**
+     * compare two types structurally, including all the types they refer to
+     *
+     * The pairs of types that are being compared are collected in @b assumed
+     * and treated as equal when they are reached again, which makes it work
+     * for recursive types.  Any mismatch makes the whole comparison fail, so
+     * the assumptions never leak into a positive answer.
+     */
+    bool eqTypes(
+            const struct cl_type       *a,
+            const struct cl_type       *b,
+            TTypePairSet               &assumed)
+    {
+        if (a == b)
+            return true;
+
+        if (!a || !b)
+            return false;
+
+        if (a->code != b->code
+                || a->size != b->size
+                || a->item_cnt != b->item_cnt
+                || a->array_size != b->array_size
+                || a->is_unsigned != b->is_unsigned
+                || !eqNames(a->name, b->name))
+            return false;
+
+        if (!assumed.insert(TTypePair(a, b)).second)
+            // already being compared
+            return true;
+
+        for (int i = 0; i < a->item_cnt; ++i) {
+            const struct cl_type_item &ia = a->items[i];
+            const struct cl_type_item &ib = b->items[i];
+            if (ia.offset != ib.offset
+                    || !eqNames(ia.name, ib.name)
+                    || !eqTypes(ia.type, ib.type, assumed))
+                return false;
+        }
+
+        return true;
+    }
+
+    /**
+     * link several snapshots into a single program
+     *
+     * All the snapshots are loaded first, except their event streams.  Global
+     * functions and variables are resolved by name, named global types are
+     * shared among the snapshots if they are structurally equal.  The first snapshot
+     * keeps its uids, everything else that is not resolved to an already
+     * loaded object gets a fresh uid above all the uids seen so far.  The
+     * events are then replayed one snapshot after another, so only the
+     * declarations need to be kept in memory for all the snapshots at once.
+     */
+    class SnapLinker {
+        public:
+            SnapLinker():
+                pool_(*new SnapPool),
+                nextUid_(1),
+                nextTypeUid_(1)
+            {
+            }
+
+            bool load(const char *fileName);
+            bool replay(struct cl_code_listener *cl);
+
+        private:
+            // code, name, size, item_cnt (the candidates are then compared
+            // structurally)
+            typedef std::tuple<int, std::string, int, int>  TTypeKey;
+
+            struct TypeDef {
+                struct cl_type         *clt;
+                unsigned                unit;
+            };
+
+            typedef std::vector<TypeDef>                    TTypeDefList;
+
+            struct FncDef {
+                cl_uid_t                uid;
+                bool                    defined;
+            };
+
+            typedef std::map<TTypeKey, TTypeDefList>        TTypeDefMap;
+            typedef std::map<std::string, struct cl_var *>  TGlVarMap;
+            typedef std::map<std::string, FncDef>           TGlFncMap;
+
+            std::deque<SnapUnit>    units_;
+
+            // never released, the code listeners keep pointers to the types
+            // and to the initializers of variables
+            SnapPool               &pool_;
+
+            TTypeDefMap             types_;
+            TGlVarMap               glVars_;
+            TGlFncMap               glFncs_;
+            cl_uid_t                nextUid_;
+            cl_uid_t                nextTypeUid_;
+
+            void linkTypes(SnapUnit &unit, unsigned idx);
+            void linkVars(SnapUnit &unit, const TScopeMap &scopes, unsigned idx);
+            bool linkFncs(SnapUnit &unit, unsigned idx);
+    };
+
+    void SnapLinker::linkTypes(SnapUnit &unit, const unsigned idx)
+    {
+        typedef std::map<const struct cl_type *, struct cl_type *> TSubst;
+        TSubst subst;
+        std::vector<struct cl_type *> own;
+
+        BOOST_FOREACH(TTypeMap::reference item, unit.types) {
+            struct cl_type *clt = item.second;
+            if (clt->name && CL_SCOPE_GLOBAL == clt->scope) {
+                const TTypeKey key(clt->code, clt->name, clt->size,
+                        clt->item_cnt);
+
+                TTypeDefList &defs = types_[key];
+                const TypeDef *shared = 0;
+                BOOST_FOREACH(const TypeDef &def, defs) {
+                    TTypePairSet assumed;
+                    if (idx != def.unit && eqTypes(clt, def.clt, assumed)) {
+                        shared = &def;
+                        break;
+                    }
+                }
+
+                if (shared) {
+                    // already defined by another snapshot
+                    subst[clt] = shared->clt;
+                    item.second = shared->clt;
+                    continue;
+                }
+
+                const TypeDef def = { clt, idx };
+                defs.push_back(def);
+            }
+
+            if (idx)
+                clt->uid = nextTypeUid_++;
+            else
+                nextTypeUid_ = std::max(nextTypeUid_, clt->uid + 1);
+
+            own.push_back(clt);
+        }
+
+        if (subst.empty())
+            return;
+
+        // redirect the nested types to the shared ones
+        BOOST_FOREACH(struct cl_type *clt, own) {
+            for (int i = 0; i < clt->item_cnt; ++i) {
+                const TSubst::const_iterator it = subst.find(clt->items[i].type);
+                if (subst.end() != it)
+                    clt->items[i].type = it->second;
+            }
+        }
+    }
+
+    void SnapLinker::linkVars(
+            SnapUnit                   &unit,
+            const TScopeMap            &scopes,
+            const unsigned              idx)
+    {
+        BOOST_FOREACH(TVarMap::reference item, unit.vars) {
+            struct cl_var *clv = item.second;
+            const TScopeMap::const_iterator it = scopes.find(item.first);
+            const bool isGlobal = clv->name
+                && scopes.end() != it
+                && CL_SCOPE_GLOBAL == it->second;
+
+            if (isGlobal && hasKey(glVars_, clv->name)) {
+                // resolve the variable by name
+                struct cl_var *clvGl = glVars_[clv->name];
+                if (clvGl->is_extern && !clv->is_extern) {
+                    // the declaration is completed by the definition
+                    clvGl->artificial   = clv->artificial;
+                    clvGl->loc          = clv->loc;
+                    clvGl->is_extern    = false;
+                }
+
+                if (clv->initialized)
+                    clvGl->initialized = true;
+
+                item.second = clvGl;
+                continue;
+            }
+
+            if (idx)
+                clv->uid = nextUid_++;
+            else
+                nextUid_ = std::max(nextUid_, clv->uid + 1);
+
+            if (isGlobal)
+                glVars_[clv->name] = clv;
+        }
+    }
+
+    bool SnapLinker::linkFncs(SnapUnit &unit, const unsigned idx)
+    {
+        SnapReader rd(unit, pool_, unit.hdr.fncOff, unit.hdr.fncSize);
+        for (uint32_t i = 0; i < unit.hdr.cntFncs; ++i) {
+            const cl_uid_t uid = rd.get<int64_t>();
+            const int scope = rd.get<uint8_t>();
+            const char *name = rd.str();
+            const bool defined = rd.get<uint8_t>();
+            if (!rd.ok())
+                break;
+
+            const bool isGlobal = name && CL_SCOPE_GLOBAL == scope;
+            TGlFncMap::iterator it = glFncs_.find((isGlobal) ? name : "");
+            if (isGlobal && glFncs_.end() != it) {
+                // resolve the function by name
+                FncDef &fd = it->second;
+                if (defined && fd.defined) {
+                    CL_ERROR("multiple definitions of function " << name
+                            << "() while linking '" << unit.fileName << "'");
+                    return false;
+                }
+
+                fd.defined |= defined;
+                unit.fncs[uid] = fd.uid;
+                continue;
+            }
+
+            cl_uid_t uidLinked = uid;
+            if (idx)
+                uidLinked = nextUid_++;
+            else
+                nextUid_ = std::max(nextUid_, uid + 1);
+
+            unit.fncs[uid] = uidLinked;
+            if (isGlobal) {
+                const FncDef fd = { uidLinked, defined };
+                glFncs_[name] = fd;
+            }
+        }
+
+        if (rd.atEnd())
+            return true;
+
+        CL_ERROR("code snapshot '" << unit.fileName << "' is corrupted");
+        return false;
+    }
+
+    bool SnapLinker::load(const char *fileName)
+    {
+        const unsigned idx = units_.size();
+        units_.push_back(SnapUnit());
+        SnapUnit &unit = units_.back();
+        unit.fileName = fileName;
+        if (!mapSnapshot(unit))
+            return false;
+
+        const SnapHeader &hdr = unit.hdr;
+        SnapReader typeRd(unit, pool_, hdr.typeOff, hdr.typeSize,
+                /* create */ true);
+        for (uint32_t i = 0; typeRd.ok() && i < hdr.cntTypes; ++i)
+            typeRd.type();
+
+        TScopeMap scopes;
+        SnapReader varRd(unit, pool_, hdr.varOff, hdr.varSize,
+                /* create */ true);
+        for (uint32_t i = 0; varRd.ok() && i < hdr.cntVars; ++i) {
+            enum cl_scope_e scope;
+            const cl_uid_t uid = varRd.var(&scope);
+            scopes[uid] = scope;
+        }
+
+        if (!typeRd.atEnd() || !varRd.atEnd()) {
+            CL_ERROR("code snapshot '" << fileName << "' is corrupted");
+            return false;
+        }
+
+        this->linkTypes(unit, idx);
+        this->linkVars(unit, scopes, idx);
+        if (!this->linkFncs(unit, idx))
+            return false;
+
+        // the initializers may refer to anything above, so they go last
+        SnapReader initRd(unit, pool_, hdr.initOff, hdr.initSize);
+        while (!initRd.atEnd())
+            initRd.initials();
+
+        if (!initRd.ok()) {
+            CL_ERROR("code snapshot '" << fileName << "' is corrupted");
+            return false;
+        }
+
+        CL_DEBUG("loaded code snapshot '" << fileName << "': "
+                << hdr.cntTypes << " types, " << hdr.cntVars << " variables, "
+                << hdr.cntFncs << " functions");
+
+        return true;
+    }
+
+    bool SnapLinker::replay(struct cl_code_listener *cl)
+    {
+        BOOST_FOREACH(SnapUnit &unit, units_) {
+            CL_DEBUG("replaying code snapshot '" << unit.fileName << "'");
+            if (!replayEvents(unit, cl)) {
+                CL_ERROR("code snapshot '" << unit.fileName
+                        << "' is corrupted");
+                return false;
+            }
+        }
+
+        return true;
+    }
+}
+
+bool cl_snapshot_link(
+        const char *const               file_names[],
+        int                             cnt,
+        struct cl_code_listener         *cl)
+{
+    SnapLinker linker;
+    for (int i = 0; i < cnt; ++i)
+        if (!linker.load(file_names[i]))
+            return false;
+
+    return linker.replay(cl);
+}
+
+bool cl_snapshot_replay(const char *file_name, struct cl_code_listener *cl)
+{
+    return cl_snapshot_link(&file_name, 1, cl);
+}
+
+// /////////////////////////////////////////////////////////////////////////////
+// public interface, see cl_snapshot.hh for details
+ICodeListener* createClSnapshotWriter(const char *config_string)
+{
+    if (!config_string || !*config_string) {
+        CL_ERROR("no file name given to the snapshot code listener");
+        return 0;
+    }
+
+    return new ClSnapshotWriter(config_string);
+}
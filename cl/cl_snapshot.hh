@@ -0,0 +1,41 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This file is part of predator.
+ *
+ * predator is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * predator is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with predator.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef H_GUARD_CL_SNAPSHOT_H
+#define H_GUARD_CL_SNAPSHOT_H
+
+/**
+ * @file cl_snapshot.hh
+ * constructor createClSnapshotWriter() of the @b "snapshot" code listener
+ */
+
+class ICodeListener;
+
+/**
+ * create "snapshot" ICodeListener implementation
+ *
+ * The listener records everything it is given and writes it at the end into
+ * a binary file, which can be later on replayed into another code listener by
+ * cl_snapshot_replay() without running the compiler again.
+ * @param config_string Name of the output file is the only configuration
+ * string for now. It's an compulsory argument and can't be NULL.
+ */
+ICodeListener* createClSnapshotWriter(const char *config_string);
+
+#endif /* H_GUARD_CL_SNAPSHOT_H */
@@ -21,33 +21,101 @@
 #include "cl_storage.hh"
 
 #include <cl/clutil.hh>
+#include <cl/phase.hh>
 #include <cl/storage.hh>
 
 #include "builtins.hh"
 #include "util.hh"
 
 #include <cstring>
+#include <new>
 #include <set>
 #include <stack>
+#include <string>
+#include <unordered_set>
+#include <vector>
 
 #include <boost/foreach.hpp>
 #include <boost/tuple/tuple.hpp>
 
 namespace CodeStorage {
     /**
-     * @param str dst/src to call strdup(3) for
+     * storage-lifetime bump allocator for the objects of the intermediate code
+     *
+     * The objects are never freed one by one, the memory is released at once
+     * when the Arena is destroyed.  Destructors of the objects are not called
+     * by Arena, it is the responsibility of the owner of the object to call
+     * the destructor if there is any.
      */
-    void dupString(const char *&str) {
-        str = (str)
-            ? strdup(str)
-            : 0;
-    }
+    class Arena {
+        public:
+            Arena():
+                cur_(0),
+                end_(0)
+            {
+            }
 
-    /**
-     * @param str Legacy string to be freed, usually formerly given by dupString
-     */
-    void freeString(const char *str) {
-        free(const_cast<char *>(str));
+            ~Arena() {
+                BOOST_FOREACH(char *chunk, chunks_)
+                    delete[] chunk;
+            }
+
+            /// allocate uninitialized memory for a single object of type T
+            template <typename T>
+            T* alloc() {
+                return static_cast<T *>(this->allocRaw(sizeof(T), alignof(T)));
+            }
+
+            /// copy-construct an object of type T in the arena
+            template <typename T>
+            T* clone(const T &src) {
+                return new (this->alloc<T>()) T(src);
+            }
+
+            /// return an interned copy of the given string, or 0 for 0
+            const char* intern(const char *str) {
+                if (!str)
+                    return 0;
+
+                return strs_.insert(std::string(str)).first->c_str();
+            }
+
+        private:
+            // not copyable
+            Arena(const Arena &);
+            Arena& operator=(const Arena &);
+
+            void* allocRaw(size_t size, size_t align);
+
+            static const size_t CHUNK_SIZE = 0x10000;
+
+            std::vector<char *>                 chunks_;
+            char                               *cur_;
+            char                               *end_;
+
+            // node-based container, the strings never move once inserted
+            std::unordered_set<std::string>     strs_;
+    };
+
+    void* Arena::allocRaw(const size_t size, const size_t align)
+    {
+        const uintptr_t pos = reinterpret_cast<uintptr_t>(cur_);
+        const uintptr_t pad = (align - pos % align) % align;
+        if (!cur_ || static_cast<size_t>(end_ - cur_) < pad + size) {
+            // allocate a new chunk (bigger objects get a chunk of their own)
+            const size_t chunkSize = (size + align < CHUNK_SIZE)
+                ? CHUNK_SIZE
+                : size + align;
+            char *chunk = new char[chunkSize];
+            chunks_.push_back(chunk);
+            cur_ = chunk;
+            end_ = chunk + chunkSize;
+            return this->allocRaw(size, align);
+        }
+
+        void *addr = cur_ + pad;
+        cur_ += pad + size;
+        return addr;
     }
 
     /**
@@ -100,22 +168,23 @@ namespace CodeStorage {
     /**
      * clone a chain of cl_accessor objects and eventually push all array
      * indexes to given stack
+     * @param arena Arena to allocate the cloned objects from.
      * @param dst Where to store just cloned cl_accessor chain.
      * @param src The chain of cl_accessor objects being cloned.
      * @param opStack Stack to push all array indexes to.
      */
     template <class TStack>
-    void cloneAccessor(struct cl_accessor **dst, const struct cl_accessor *src,
-                       TStack &opStack)
+    void cloneAccessor(Arena &arena, struct cl_accessor **dst,
+                       const struct cl_accessor *src, TStack &opStack)
     {
         while (src) {
             // clone current cl_accessor object
-            *dst = new struct cl_accessor(*src);
+            *dst = arena.clone(*src);
 
             if (CL_ACCESSOR_DEREF_ARRAY == src->code) {
                 // clone array index
                 struct cl_operand const *idxSrc = src->data.array.index;
-                struct cl_operand *idxDst = new struct cl_operand(*idxSrc);
+                struct cl_operand *idxDst = arena.clone(*idxSrc);
                 (*dst)->data.array.index = idxDst;
 
                 // schedule array index as an operand for the next wheel
@@ -129,10 +198,15 @@ namespace CodeStorage {
     }
 
     /**
-     * deep copy of a cl_operand object
+     * deep copy of a cl_operand object, all the clones are allocated from the
+     * given arena and released with it, so there is no releaseOperand()
      * @note FIXME: I guess this will need a debugger first :-)
      */
-    void storeOperand(struct cl_operand &dst, const struct cl_operand *src) {
+    void storeOperand(
+            Arena                       &arena,
+            struct cl_operand           &dst,
+            const struct cl_operand     *src)
+    {
         // shallow copy
         dst = *src;
 
@@ -153,52 +227,20 @@ namespace CodeStorage {
 
             // clone list of cl_accessor objects
             // and schedule all array indexes for the next wheel eventually
-            cloneAccessor(&cDst->accessor, cSrc->accessor, opStack);
-
-            // duplicate all strings
-            handleOperandStrings(dupString, cDst);
-        }
-    }
-
-    /**
-     * free all data allocated previously by storeOperand()
-     */
-    void releaseOperand(struct cl_operand &ref) {
-        if (CL_OPERAND_VOID == ref.code)
-            // nothing to free
-            return;
-
-        // use std::stack to avoid recursion
-        std::stack<struct cl_operand *> opStack;
-        opStack.push(&ref);
-        while (!opStack.empty()) {
-            struct cl_operand *op = opStack.top();
-            opStack.pop();
-
-            // remove all duplicated strings
-            handleOperandStrings(freeString, op);
-
-            // destroy cl_accessor objects recursively
-            struct cl_accessor *ac = op->accessor;
-            while (ac) {
-                struct cl_accessor *next = ac->next;
-                if (CL_ACCESSOR_DEREF_ARRAY == ac->code)
-                    opStack.push(ac->data.array.index);
-
-                delete ac;
-                ac = next;
-            }
+            cloneAccessor(arena, &cDst->accessor, cSrc->accessor, opStack);
 
-            if (op != &ref)
-                // free cloned array index
-                delete op;
+            // intern all strings
+            handleOperandStrings(
+                    [&arena](const char *&str) { str = arena.intern(str); },
+                    cDst);
         }
-
-        // all accessors freed
-        ref.accessor = 0;
     }
 
-    void storeLabel(struct cl_operand &op, const struct cl_insn *cli) {
+    void storeLabel(
+            Arena                       &arena,
+            struct cl_operand           &op,
+            const struct cl_insn        *cli)
+    {
         const char *name = cli->data.insn_label.name;
         struct cl_operand tpl;
         tpl.code = CL_OPERAND_VOID;
@@ -212,15 +254,25 @@ namespace CodeStorage {
             tpl.data.cst.data.cst_string.value  = name;
         }
 
-        storeOperand(op, &tpl);
+        storeOperand(arena, op, &tpl);
     }
 
-    Insn* createInsn(const struct cl_insn *cli, ControlFlow *cfg) {
-        enum cl_insn_e code = cli->code;
+    /**
+     * create an empty Insn object in the arena, it needs to be destroyed by
+     * destroyInsn() before the arena goes away
+     */
+    Insn* newInsn(Arena &arena, enum cl_insn_e code, const struct cl_loc &loc) {
+        Insn *insn = new (arena.alloc<Insn>()) Insn;
+        insn->code = code;
+        insn->loc = loc;
+        insn->loc.file = arena.intern(loc.file);
+        return insn;
+    }
 
-        Insn *insn = new Insn;
-        insn->code = cli->code;
-        insn->loc = cli->loc;
+    Insn* createInsn(Arena &arena, const struct cl_insn *cli, ControlFlow *cfg)
+    {
+        enum cl_insn_e code = cli->code;
+        Insn *insn = newInsn(arena, code, cli->loc);
 
         TOperandList &operands = insn->operands;
         TTargetList &targets = insn->targets;
@@ -236,7 +288,7 @@ namespace CodeStorage {
 
             case CL_INSN_COND:
                 operands.resize(1);
-                storeOperand(operands[0], cli->data.insn_cond.src);
+                storeOperand(arena, operands[0], cli->data.insn_cond.src);
 
                 targets.resize(2);
                 targets[0] = cfg->operator[](cli->data.insn_cond.then_label);
@@ -245,12 +297,12 @@ namespace CodeStorage {
 
             case CL_INSN_CLOBBER:
                 operands.resize(1);
-                storeOperand(operands[0], cli->data.insn_clobber.var);
+                storeOperand(arena, operands[0], cli->data.insn_clobber.var);
                 break;
 
             case CL_INSN_RET:
                 operands.resize(1);
-                storeOperand(operands[0], cli->data.insn_ret.src);
+                storeOperand(arena, operands[0], cli->data.insn_ret.src);
                 // fall through!
 
             case CL_INSN_ABORT:
@@ -259,16 +311,16 @@ namespace CodeStorage {
             case CL_INSN_UNOP:
                 insn->subCode = static_cast<int> (cli->data.insn_unop.code);
                 operands.resize(2);
-                storeOperand(operands[0], cli->data.insn_unop.dst);
-                storeOperand(operands[1], cli->data.insn_unop.src);
+                storeOperand(arena, operands[0], cli->data.insn_unop.dst);
+                storeOperand(arena, operands[1], cli->data.insn_unop.src);
                 break;
 
             case CL_INSN_BINOP:
                 insn->subCode = static_cast<int> (cli->data.insn_binop.code);
                 operands.resize(3);
-                storeOperand(operands[0], cli->data.insn_binop.dst);
-                storeOperand(operands[1], cli->data.insn_binop.src1);
-                storeOperand(operands[2], cli->data.insn_binop.src2);
+                storeOperand(arena, operands[0], cli->data.insn_binop.dst);
+                storeOperand(arena, operands[1], cli->data.insn_binop.src1);
+                storeOperand(arena, operands[2], cli->data.insn_binop.src2);
                 break;
 
             case CL_INSN_CALL:
@@ -281,7 +333,7 @@ namespace CodeStorage {
 
             case CL_INSN_LABEL:
                 operands.resize(1);
-                storeLabel(operands[0], cli);
+                storeLabel(arena, operands[0], cli);
                 break;
         }
 
@@ -289,10 +341,8 @@ namespace CodeStorage {
     }
 
     void destroyInsn(Insn *insn) {
-        BOOST_FOREACH(struct cl_operand &op, insn->operands) {
-            releaseOperand(op);
-        }
-        delete insn;
+        // the memory (including the operands) is owned by the arena
+        insn->~Insn();
     }
 
     void destroyBlock(Block *bb) {
@@ -303,7 +353,6 @@ namespace CodeStorage {
     }
 
     void destroyFnc(Fnc *fnc) {
-        releaseOperand(fnc->def);
         BOOST_FOREACH(const Block *bb, fnc->cfg) {
             destroyBlock(const_cast<Block *>(bb));
         }
@@ -321,6 +370,7 @@ namespace CodeStorage {
 using namespace CodeStorage;
 
 struct ClStorageBuilder::Private {
+    Arena       arena;      ///< needs to outlive stor
     Storage     stor;
     const char  *file;
     Fnc         *fnc;
@@ -360,6 +410,15 @@ ClStorageBuilder::~ClStorageBuilder()
 
 void ClStorageBuilder::acknowledge()
 {
+    {
+        PhaseTimer timer("buildStorage");
+
+        // the storage is complete now, make the uid lookups cheap
+        d->stor.types.compact();
+        d->stor.vars.compact();
+        d->stor.fncs.compact();
+    }
+
     this->run(d->stor);
 }
 
@@ -370,7 +429,7 @@ void ClStorageBuilder::Private::digInitials(const TOp *op)
 
     const struct cl_initializer *initial;
     for (initial = clv->initial; initial; initial = initial->next) {
-        Insn *insn = createInsn(&initial->insn, /* cfg */ 0);
+        Insn *insn = createInsn(arena, &initial->insn, /* cfg */ 0);
         insn->stor = &stor;
 
         // initializer instructions are not associated with any basic block
@@ -466,7 +525,7 @@ void ClStorageBuilder::Private::digOperandCst(const struct cl_operand *op)
     // store fnc declaration if not already
     struct cl_operand &def = fnc->def;
     if (CL_OPERAND_VOID == def.code)
-        storeOperand(def, op);
+        storeOperand(arena, def, op);
 
     // select the appropriate name mapping by scope
     NameDb::TNameMap &nameMap = (CL_SCOPE_GLOBAL == scope)
@@ -578,6 +637,8 @@ void ClStorageBuilder::file_close()
 
 void ClStorageBuilder::fnc_open(const struct cl_operand *op)
 {
+    PhaseTimer timer("buildStorage");
+
     if (CL_OPERAND_CST != op->code)
         CL_TRAP;
 
@@ -598,7 +659,7 @@ void ClStorageBuilder::fnc_open(const struct cl_operand *op)
 
     // store fnc definition
     struct cl_operand &def = fnc->def;
-    storeOperand(def, op);
+    storeOperand(d->arena, def, op);
     d->digOperand(&def);
 
     // let it honestly crash if callback sequence is incorrect since this should
@@ -635,12 +696,14 @@ void ClStorageBuilder::bb_open(const char *bb_name)
 
 void ClStorageBuilder::insn(const struct cl_insn *cli)
 {
+    PhaseTimer timer("buildStorage");
+
     if (!d->bb)
         // FIXME: this simply ignores 'jump to entry' insn
         return;
 
     // serialize given insn
-    Insn *insn = createInsn(cli, &d->fnc->cfg);
+    Insn *insn = createInsn(d->arena, cli, &d->fnc->cfg);
     d->openInsn(insn);
 
     // current insn is actually already complete
@@ -653,14 +716,14 @@ void ClStorageBuilder::insn_call_open(
     const struct cl_operand *dst,
     const struct cl_operand *fnc)
 {
-    Insn *insn = new Insn;
-    insn->code = CL_INSN_CALL;
-    insn->loc = *loc;
+    PhaseTimer timer("buildStorage");
+
+    Insn *insn = newInsn(d->arena, CL_INSN_CALL, *loc);
 
     TOperandList &operands = insn->operands;
     operands.resize(2);
-    storeOperand(operands[0], dst);
-    storeOperand(operands[1], fnc);
+    storeOperand(d->arena, operands[0], dst);
+    storeOperand(d->arena, operands[1], fnc);
 
     // prevent existing reference marks '&' on operands to be taken into account
     // for operands of some internal handlers like VK_ASSERT() or PT_ASSERT().
@@ -674,11 +737,13 @@ void ClStorageBuilder::insn_call_arg(int, const struct cl_operand *arg_src)
     TOperandList &operands = d->insn->operands;
     unsigned idx = operands.size();
     operands.resize(idx + 1);
-    storeOperand(operands[idx], arg_src);
+    storeOperand(d->arena, operands[idx], arg_src);
 }
 
 void ClStorageBuilder::insn_call_close()
 {
+    PhaseTimer timer("buildStorage");
+
     d->closeInsn();
 
     // switch back preventing for next instructions
@@ -689,14 +754,14 @@ void ClStorageBuilder::insn_switch_open(
     const struct cl_loc     *loc,
     const struct cl_operand *src)
 {
-    Insn *insn = new Insn;
-    insn->code = CL_INSN_SWITCH;
-    insn->loc = *loc;
+    PhaseTimer timer("buildStorage");
+
+    Insn *insn = newInsn(d->arena, CL_INSN_SWITCH, *loc);
 
     // store src operand
     TOperandList &operands = insn->operands;
     operands.resize(1);
-    storeOperand(operands[0], src);
+    storeOperand(d->arena, operands[0], src);
 
     // reserve for default
     insn->targets.push_back(static_cast<Block *>(0));
@@ -751,7 +816,7 @@ void ClStorageBuilder::insn_switch_case(
 
         // store case value
         operands.resize(idx + 1);
-        storeOperand(operands[idx], &val);
+        storeOperand(d->arena, operands[idx], &val);
 
         // store case target
         targets.resize(idx + 1);
@@ -761,5 +826,7 @@ void ClStorageBuilder::insn_switch_case(
 
 void ClStorageBuilder::insn_switch_close()
 {
+    PhaseTimer timer("buildStorage");
+
     d->closeInsn();
 }
@@ -29,9 +29,14 @@
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <mutex>
 
 #include <unistd.h>
 
+// the messages may be emitted by multiple threads of the preprocessing
+static std::recursive_mutex msg_lock;
+#define MSG_LOCK std::lock_guard<std::recursive_mutex> msg_guard(msg_lock)
+
 #if CL_MSG_SQUEEZE_REPEATS
     static std::string last_msg;
 
@@ -93,29 +98,62 @@ static struct cl_init_data init_data = {
 
 void cl_debug(const char *msg)
 {
+    MSG_LOCK;
     init_data.debug(msg);
 }
 
+// warnings, errors and notes are suppressed while this is set
+static bool msg_muted = false;
+static int msg_muted_cnt = 0;
+
 void cl_warn(const char *msg)
 {
+    MSG_LOCK;
+    if (msg_muted) {
+        ++msg_muted_cnt;
+        return;
+    }
+
     CHK_LAST(msg, /* filter */ true);
     init_data.warn(msg);
 }
 
 void cl_error(const char *msg)
 {
+    MSG_LOCK;
+    if (msg_muted) {
+        ++msg_muted_cnt;
+        return;
+    }
+
     CHK_LAST(msg, /* filter */ true);
     init_data.error(msg);
 }
 
 void cl_note(const char *msg)
 {
+    MSG_LOCK;
+    if (msg_muted)
+        return;
+
     CHK_LAST(msg, /* filter */ false);
     init_data.note(msg);
 }
 
+int cl_mute_messages(bool mute)
+{
+    MSG_LOCK;
+    const int cnt = msg_muted_cnt;
+    if (mute)
+        msg_muted_cnt = 0;
+
+    msg_muted = mute;
+    return cnt;
+}
+
 void cl_die(const char *msg)
 {
+    MSG_LOCK;
     // this call should never return (TODO: annotation?)
     init_data.die(msg);
     abort();
@@ -164,6 +202,9 @@ void cl_global_init_defaults(const char *name, int debug_level)
 
 void cl_global_cleanup(void)
 {
+    // app_name is still needed to print the summary
+    cl_phase_trace_flush();
+
     if (app_name_allocated)
         free((char *)app_name);
 }
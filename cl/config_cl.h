@@ -83,6 +83,13 @@
  */
 #define CL_DEBUG_VAR_KILLER             0
 
+/**
+ * number of threads used for the per-function preprocessing of CodeStorage
+ * - 0 ... use as many threads as there are CPU cores available
+ * - 1 ... preprocess the functions sequentially
+ */
+#define CL_PREPROCESS_THREADS           0
+
 /**
  * if 1, show the amount of time taken by the analysis even without verbose mode
  */
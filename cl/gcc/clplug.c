@@ -216,8 +216,10 @@ static struct plugin_info cl_info = {
 "    -fplugin-arg-%s-args=PEER_ARGS                 args given to analyzer\n"
 "    -fplugin-arg-%s-dry-run                        do not run the analyzer\n"
 "    -fplugin-arg-%s-dump-pp[=OUTPUT_FILE]          dump linearized code\n"
+"    -fplugin-arg-%s-dump-snapshot=SNAPSHOT_FILE    dump code for replaying\n"
 "    -fplugin-arg-%s-dump-types                     dump also type info\n"
 "    -fplugin-arg-%s-gen-dot[=GLOBAL_CG_FILE]       generate CFGs\n"
+"    -fplugin-arg-%s-phase-trace[=TRACE_FILE]       print time spent in phases\n"
 "    -fplugin-arg-%s-pid-file=FILE                  write PID of self to FILE\n"
 "    -fplugin-arg-%s-preserve-ec                    do not affect exit code\n"
 "    -fplugin-arg-%s-type-dot=TYPE_GRAPH_FILE       generate type graphs\n"
@@ -268,7 +270,7 @@ static void init_plugin_name(const struct plugin_name_args *info)
     if (-1 == asprintf(&msg, cl_info.help, plugin_base_name,
                        name, name, name, name,
                        name, name, name, name,
-                       name, name, name, name))
+                       name, name, name, name, name))
         // OOM
         abort();
     else
@@ -2315,9 +2317,12 @@ struct cl_plug_options {
     bool                    use_typedot;
     const char              *gl_dot_file;
     const char              *pp_out_file;
+    const char              *snapshot_file;
     const char              *analyzer_args;
     const char              *type_dot_file;
     const char              *pid_file;
+    bool                    use_phase_trace;
+    const char              *phase_trace_file;
 };
 
 static int clplug_init(const struct plugin_name_args *info,
@@ -2367,6 +2372,14 @@ static int clplug_init(const struct plugin_name_args *info,
             opt->use_pp         = true;
             opt->pp_out_file    = value;
         }
+        else if (STREQ(key, "dump-snapshot")) {
+            if (value)
+                opt->snapshot_file = value;
+            else {
+                CL_ERROR("mandatory value omitted for dump-snapshot");
+                return EXIT_FAILURE;
+            }
+        }
         else if (STREQ(key, "dump-types")) {
             opt->dump_types     = true;
             // TODO: warn about ignoring extra value?
@@ -2380,6 +2393,10 @@ static int clplug_init(const struct plugin_name_args *info,
             preserve_ec = true;
             // TODO: warn about ignoring extra value?
         }
+        else if (STREQ(key, "phase-trace")) {
+            opt->use_phase_trace    = true;
+            opt->phase_trace_file   = value;
+        }
         else if (STREQ(key, "pid-file")) {
             if (value)
                 opt->pid_file = value;
@@ -2483,6 +2500,12 @@ create_cl_chain(const struct cl_plug_options *opt)
                 opt->type_dot_file, opt))
         return NULL;
 
+    // the snapshot is recorded the same way as the analyzer sees the code
+    if (opt->snapshot_file && !cl_append_listener(chain,
+                "listener=\"snapshot\" listener_args=\"%s\" "
+                "clf=\"unfold_switch,unify_labels_gl\"", opt->snapshot_file))
+        return NULL;
+
     if (opt->use_analyzer
             && !cl_append_def_listener(chain, "easy", opt->analyzer_args, opt))
         return NULL;
@@ -2562,6 +2585,9 @@ int plugin_init(struct plugin_name_args *plugin_info,
         init.debug = trivial_printer;
 
     cl_global_init(&init);
+    if (opt.use_phase_trace)
+        cl_phase_trace_init(opt.phase_trace_file);
+
     cl = create_cl_chain(&opt);
     CL_ASSERT(cl);
 
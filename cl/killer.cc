@@ -23,6 +23,8 @@
 #include <cl/cl_msg.hh>
 #include <cl/cldebug.hh>
 #include <cl/clutil.hh>
+#include <cl/parallel.hh>
+#include <cl/phase.hh>
 #include <cl/storage.hh>
 
 #include "pointsto.hh"
@@ -32,7 +34,10 @@
 
 #include <map>
 #include <set>
+#include <stack>
+#include <vector>
 
+#include <boost/dynamic_bitset.hpp>
 #include <boost/foreach.hpp>
 
 static int debugVarKiller = CL_DEBUG_VAR_KILLER;
@@ -51,24 +56,52 @@ namespace CodeStorage {
 
 namespace VarKiller {
 
-typedef CodeStorage::Storage               &TStorRef;
+typedef const CodeStorage::Storage         &TStorRef;
 typedef const CodeStorage::PointsTo::Graph &TPTGraph;
 typedef const struct cl_loc                *TLoc;
 typedef const CodeStorage::Var             *TStorVar;
 typedef const CodeStorage::Fnc             *TFnc;
 typedef const Block                        *TBlock;
-typedef std::set<TBlock>                    TBlockSet;
-typedef std::vector<TSet>                   TLivePerTarget;
+typedef boost::dynamic_bitset<>             TBitSet;
+typedef std::vector<TBitSet>                TLivePerTarget;
+typedef std::vector<unsigned>               TIdxList;
+
+/// per-block data of the fixed-point computation with variables numbered
+struct BlockBits {
+    TBitSet                                 gen;    ///< live on block entry
+    TBitSet                                 kill;
+    TIdxList                                targets;
+    TIdxList                                inbound;
+};
+
+/// statistics of killed variables per function
+struct FncStats {
+    int                                     count;
+    int                                     fullCount;
 
-typedef std::map<TBlock, BlockData>         TMap;
+    FncStats():
+        count(0),
+        fullCount(0)
+    {
+    }
+};
 
 /// shared data
 struct Data {
     TStorRef                                stor;
-    TBlockSet                               todo;
-    TMap                                    blocks;
     TFnc                                    fnc;
+    FncStats                                stats;
     TAliasMap                               derefAliases;
+    TSet                                    aliasTargets;
+
+    // basic blocks of the function numbered in reverse post-order
+    std::vector<TBlock>                     blockList;
+    std::map<TBlock, unsigned>              blockIdx;
+    std::vector<BlockBits>                  blocks;
+
+    // local variables of the function numbered in the order of their uids
+    std::vector<TVar>                       varList;
+    std::map<TVar, unsigned>                varIdx;
 
     Data(TStorRef stor_):
         stor(stor_),
@@ -114,14 +147,16 @@ PTStats *PTStats::inst = 0;
 
 void countPtStat(Data &data, cl_uid_t uid)
 {
-    PTStats *stats = PTStats::getInstance();
-    stats->fullCount++;
+    // the functions may be analyzed concurrently, killLocalVariables() sums
+    // up the per-function statistics once all the functions are done
+    FncStats &stats = data.stats;
+    stats.fullCount++;
 
     if (hasKey(data.fnc->vars, uid))
         // is local uid
         return;
 
-    stats->count ++;
+    stats.count ++;
 
     // killing pointer target
     VK_DEBUG(0, "killing " << uid << " by its pointer!");
@@ -276,48 +311,57 @@ void scanInsn(BlockData *pDst, const Insn *insn, TAliasMap *pAliasMap)
     }
 }
 
-void updateBlock(Data &data, TBlock bb)
+inline unsigned varIndex(const Data &data, TVar uid)
 {
-    VK_DEBUG_MSG(2, &bb->front()->loc, "updateBlock: " << bb->name());
-    BlockData &bData = data.blocks[bb];
-    bool anyChange = false;
-
-    // go through all variables generated by successors
-    BOOST_FOREACH(TBlock bbSrc, bb->targets()) {
-        BlockData &bDataSrc = data.blocks[bbSrc];
+    std::map<TVar, unsigned>::const_iterator it = data.varIdx.find(uid);
+    CL_BREAK_IF(data.varIdx.end() == it);
+    return it->second;
+}
 
-        // update self
-        BOOST_FOREACH(TVar uid, bDataSrc.gen) {
-            if (hasKey(bData.kill, uid))
-                // we are killing the variable
-                continue;
+bool updateBlock(Data &data, unsigned idx)
+{
+    BlockBits &bData = data.blocks[idx];
+    VK_DEBUG_MSG(2, &data.blockList[idx]->front()->loc,
+            "updateBlock: " << data.blockList[idx]->name());
 
-            if (insertOnce(bData.gen, uid))
-                anyChange = true;
-        }
-    }
+    // go through all variables generated by successors
+    TBitSet gen(data.varList.size());
+    BOOST_FOREACH(const unsigned idxSrc, bData.targets)
+        gen |= data.blocks[idxSrc].gen;
 
-    if (!anyChange)
+    // we are killing the variables from the kill set
+    gen -= bData.kill;
+    if (gen.is_subset_of(bData.gen))
         // nothing updated actually
-        return;
+        return false;
 
-    // schedule all predecessors
-    BOOST_FOREACH(TBlock bbDst, bb->inbound())
-        data.todo.insert(bbDst);
+    bData.gen |= gen;
+    return true;
 }
 
 void computeFixPoint(Data &data)
 {
+    // blocks are numbered in reverse post-order, so taking the block with the
+    // highest number first lets the (backward) information flow from the
+    // successors to the predecessors in a single pass if there are no loops
+    std::set<unsigned> todo;
+    for (unsigned idx = 0; idx < data.blocks.size(); ++idx)
+        todo.insert(idx);
+
     // fixed-point computation
     unsigned cntSteps = 1;
-    TBlockSet &todo = data.todo;
     while (!todo.empty()) {
-        TBlockSet::iterator i = todo.begin();
-        TBlock bb = *i;
+        std::set<unsigned>::iterator i = todo.end();
+        const unsigned idx = *(--i);
         todo.erase(i);
 
         // (re)compute a single basic block
-        updateBlock(data, bb);
+        if (updateBlock(data, idx)) {
+            // schedule all predecessors
+            BOOST_FOREACH(const unsigned idxDst, data.blocks[idx].inbound)
+                todo.insert(idxDst);
+        }
+
         ++cntSteps;
     }
 
@@ -326,9 +370,8 @@ void computeFixPoint(Data &data)
 
 inline bool isPointedUid(Data &data, cl_uid_t uid)
 {
-    BOOST_FOREACH(TAliasMap::const_reference item, data.derefAliases)
-        if (item.second == uid)
-            return false;
+    if (hasKey(data.aliasTargets, uid))
+        return false;
 
     return data.stor.vars[uid].mayBePointed;
 }
@@ -358,7 +401,7 @@ void killVariablePerTarget(
 void commitInsn(
         Data                    &data,
         Insn                    &insn,
-        TSet                    &live,
+        TBitSet                 &live,
         TLivePerTarget          &livePerTarget)
 {
     const TStorRef stor = data.stor;
@@ -381,9 +424,12 @@ void commitInsn(
 
     // go through variables generated by the current instruction
     BOOST_FOREACH(TVar vKill, touched) {
+        const unsigned idx = varIndex(data, vKill);
         const bool isPointed = isPointedUid(data, vKill);
 
-        if (insertOnce(live, vKill)) {
+        if (!live.test(idx)) {
+            live.set(idx);
+
             // variable was marked as dead in following instruction -- may be
             // killed after execution of this instruction
             VK_DEBUG_MSG(1, &insn.loc, "killing variable "
@@ -399,14 +445,14 @@ void commitInsn(
                 // to prevent following code to re-kill it again for particular
                 // target
                 for (unsigned i = 0; i < cntTargets; ++i)
-                    livePerTarget[i].insert(vKill);
+                    livePerTarget[i].set(idx);
             }
         }
 
         if (!hasKey(arena.gen, vKill)) {
             // this variable is killed by this instruction && is _not_ generated
             // by following instructions.  Therefore it must be marked as dead.
-            live.erase(vKill);
+            live.reset(idx);
             // NOTE: It is not possible to re-kill the 'vKill' for particular
             // targets *only* because:
             //   a) future turns: 'vKill' is is not generated => is dead for
@@ -424,39 +470,40 @@ void commitInsn(
         // means that it is "live" at least in one of the block targets) try to
         // kill it for those particular targets
         for (unsigned i = 0; i < cntTargets; ++i) {
-            if (!insertOnce(livePerTarget[i], vKill))
+            if (livePerTarget[i].test(idx))
                 continue;
 
+            livePerTarget[i].set(idx);
             killVariablePerTarget(data, bb, i, vKill);
         }
     }
 }
 
-void commitBlock(Data &data, TBlock bb)
+void commitBlock(Data &data, unsigned idxBlock)
 {
-    const TTargetList &targets = bb->targets();
+    const TBlock bb = data.blockList[idxBlock];
+    const TIdxList &targets = data.blocks[idxBlock].targets;
     const unsigned cntTargets = targets.size();
     const bool multipleTargets = (1 < cntTargets);
+    const unsigned cntVars = data.varList.size();
 
     TLivePerTarget livePerTarget;
     if (multipleTargets)
-        livePerTarget.resize(cntTargets);
+        livePerTarget.resize(cntTargets, TBitSet(cntVars));
 
     // build list of live variables coming from all successors
-    TSet live;
+    TBitSet live(cntVars);
     for (unsigned i = 0; i < cntTargets; ++i) {
-        const TBlock bbSrc = targets[i];
-        BOOST_FOREACH(TVar vLive, data.blocks[bbSrc].gen) {
-            live.insert(vLive);
-            if (multipleTargets)
-                livePerTarget[i].insert(vLive);
-        }
+        const TBitSet &liveSrc = data.blocks[targets[i]].gen;
+        live |= liveSrc;
+        if (multipleTargets)
+            livePerTarget[i] = liveSrc;
     }
 
     if (cntTargets == 0) {
         // make sure those variables are left *live* when going out of function
         BOOST_FOREACH(TAliasMap::const_reference ref, data.derefAliases)
-            live.insert(ref.second);
+            live.set(varIndex(data, ref.second));
     }
 
     // go backwards through the instructions
@@ -473,36 +520,25 @@ void commitBlock(Data &data, TBlock bb)
     // finish this block -- there may stay some variables that are untouched by
     // this block and/but these are alive only for some of targets --> lets
     // catch these these fugitives.
-
-    TSet::const_iterator liveIt, perTargetIt;
     for (unsigned target = 0; target < cntTargets; ++target) {
         TLivePerTarget::const_reference perTarget = livePerTarget[target];
 
-        liveIt = live.begin();
-        perTargetIt = perTarget.begin();
-
-        // complexity O(N) (N is number of variables in live).  Note that this
-        // needs the 'live' and 'livePerTarget' lists to be sorted
-        while (liveIt != live.end() && perTarget.end() != perTargetIt) {
-
-            cl_uid_t uidLive = *liveIt;
-            cl_uid_t uidPerTarget = *perTargetIt;
-
-            if (uidPerTarget < uidLive) {
-                // uidPerTarget is killed for particular target
-                ++perTargetIt;
-                continue;
-            }
-
-            else if (uidLive == uidPerTarget) {
-                ++perTargetIt;
-                ++liveIt;
-                continue;
-            }
+        // only the variables that precede the last variable live for this
+        // target are considered (the variables are numbered by their uids)
+        TBitSet::size_type last = perTarget.find_first();
+        if (TBitSet::npos == last)
+            continue;
+        for (TBitSet::size_type j = last; TBitSet::npos != j;
+                j = perTarget.find_next(j))
+            last = j;
 
+        const TBitSet fugitives = live - perTarget;
+        for (TBitSet::size_type j = fugitives.find_first();
+                TBitSet::npos != j && j < last; j = fugitives.find_next(j))
+        {
             // OK, now we have untouched variable 'uidLive'
+            const cl_uid_t uidLive = data.varList[j];
             killVariablePerTarget(data, bb, target, uidLive);
-            ++liveIt;
         }
     }
 }
@@ -581,10 +617,8 @@ void findAliases(Data &data, Fnc &fnc)
                 hitAlias(data, op);
 }
 
-void presetLive(Data &data, const TBlock bb)
+void presetLive(Data &data, BlockData &bData, const TBlock bb)
 {
-    BlockData &bData = data.blocks[bb];
-
     int size = bb->targets().size();
     if (size != 0)
         return;
@@ -595,7 +629,86 @@ void presetLive(Data &data, const TBlock bb)
             bData.gen.insert(pair.second);
 }
 
-void analyzeFnc(Fnc &fnc)
+// number the basic blocks in reverse post-order, unreachable blocks go last
+void numberBlocks(Data &data, const ControlFlow &cfg)
+{
+    std::vector<TBlock> postOrder;
+    std::set<TBlock> seen;
+
+    typedef std::pair<TBlock, unsigned> TDfsItem;
+    std::stack<TDfsItem> dfsStack;
+    if (cfg.size()) {
+        const TBlock entry = cfg.entry();
+        seen.insert(entry);
+        dfsStack.push(TDfsItem(entry, 0U));
+    }
+
+    while (!dfsStack.empty()) {
+        TDfsItem &item = dfsStack.top();
+        const TTargetList &targets = item.first->targets();
+        if (item.second < targets.size()) {
+            const TBlock bbNext = targets[item.second++];
+            if (insertOnce(seen, bbNext))
+                dfsStack.push(TDfsItem(bbNext, 0U));
+
+            continue;
+        }
+
+        postOrder.push_back(item.first);
+        dfsStack.pop();
+    }
+
+    data.blockList.assign(postOrder.rbegin(), postOrder.rend());
+    BOOST_FOREACH(const TBlock bb, cfg)
+        if (!hasKey(seen, bb))
+            data.blockList.push_back(bb);
+
+    const unsigned cntBlocks = data.blockList.size();
+    for (unsigned idx = 0; idx < cntBlocks; ++idx)
+        data.blockIdx[data.blockList[idx]] = idx;
+
+    data.blocks.resize(cntBlocks);
+    for (unsigned idx = 0; idx < cntBlocks; ++idx) {
+        const TBlock bb = data.blockList[idx];
+        BlockBits &bData = data.blocks[idx];
+
+        BOOST_FOREACH(const TBlock bbDst, bb->targets())
+            bData.targets.push_back(data.blockIdx[bbDst]);
+
+        BOOST_FOREACH(const TBlock bbSrc, bb->inbound())
+            bData.inbound.push_back(data.blockIdx[bbSrc]);
+    }
+}
+
+// number the variables seen in the function and convert the sets to bits
+void numberVars(Data &data, const std::vector<BlockData> &scanned)
+{
+    TSet vars = data.aliasTargets;
+    BOOST_FOREACH(const BlockData &bData, scanned) {
+        vars.insert(bData.gen.begin(), bData.gen.end());
+        vars.insert(bData.kill.begin(), bData.kill.end());
+    }
+
+    // std::set is sorted, so the numbering preserves the order of uids
+    data.varList.assign(vars.begin(), vars.end());
+    const unsigned cntVars = data.varList.size();
+    for (unsigned idx = 0; idx < cntVars; ++idx)
+        data.varIdx[data.varList[idx]] = idx;
+
+    for (unsigned idx = 0; idx < data.blocks.size(); ++idx) {
+        BlockBits &bData = data.blocks[idx];
+        bData.gen.resize(cntVars);
+        bData.kill.resize(cntVars);
+
+        BOOST_FOREACH(const TVar uid, scanned[idx].gen)
+            bData.gen.set(data.varIdx[uid]);
+
+        BOOST_FOREACH(const TVar uid, scanned[idx].kill)
+            bData.kill.set(data.varIdx[uid]);
+    }
+}
+
+void analyzeFnc(Fnc &fnc, FncStats *pStats)
 {
     // shared state info
     Data data(*fnc.stor);
@@ -603,27 +716,34 @@ void analyzeFnc(Fnc &fnc)
 
     TLoc loc = &fnc.def.data.cst.data.cst_fnc.loc;
     VK_DEBUG_MSG(2, loc, ">>> entering " << nameOf(fnc) << "()");
-    CL_BREAK_IF(!data.todo.empty());
 
     // pre-compute dereferences
     findAliases(data, fnc);
+    BOOST_FOREACH(TAliasMap::const_reference item, data.derefAliases)
+        data.aliasTargets.insert(item.second);
+
+    numberBlocks(data, fnc.cfg);
+    const unsigned cntBlocks = data.blockList.size();
 
     // go through basic blocks
-    BOOST_FOREACH(const TBlock bb, fnc.cfg) {
+    std::vector<BlockData> scanned(cntBlocks);
+    for (unsigned idx = 0; idx < cntBlocks; ++idx) {
+        const TBlock bb = data.blockList[idx];
+
         // go through instructions in forward direction
         VK_DEBUG(3, "in block " << bb->name());
 
-        BlockData &bData = data.blocks[bb];
+        BlockData &bData = scanned[idx];
         BOOST_FOREACH(const Insn *insn, *bb) {
             scanInsn(&bData, insn, &data.derefAliases);
         }
 
         // guarantee to distribute pointer-targests exist when function finishes
-        presetLive(data, bb);
-
-        data.todo.insert(bb);
+        presetLive(data, bData, bb);
     }
 
+    numberVars(data, scanned);
+
     // compute a fixed-point for a single function
     VK_DEBUG_MSG(2, loc, "computing fixed-point for " << nameOf(fnc) << "()");
     computeFixPoint(data);
@@ -631,8 +751,10 @@ void analyzeFnc(Fnc &fnc)
     // commit the results
     BOOST_FOREACH(const TBlock bb, fnc.cfg) {
         VK_DEBUG_MSG(2, &bb->front()->loc, "commitBlock: " << bb->name());
-        commitBlock(data, bb);
+        commitBlock(data, data.blockIdx[bb]);
     }
+
+    *pStats = data.stats;
 }
 
 } // namespace VarKiller
@@ -640,18 +762,23 @@ void analyzeFnc(Fnc &fnc)
 void killLocalVariables(Storage &stor)
 {
     StopWatch watch;
+    PhaseTimer timer("killLocalVariables");
 
-    // analyze all _defined_ functions
-    BOOST_FOREACH(Fnc *pFnc, stor.fncs) {
-        Fnc &fnc = *pFnc;
-        if (!isDefined(fnc))
-            continue;
-
+    // analyze all _defined_ functions (each of them on its own)
+    const std::vector<Fnc *> fncs = definedFncs(stor);
+    std::vector<VarKiller::FncStats> fncStats(fncs.size());
+    parallelFor(fncs.size(), [&fncs, &fncStats](unsigned i) {
         // analyze a single function
-        VarKiller::analyzeFnc(fnc);
-    }
+        VarKiller::analyzeFnc(*fncs[i], &fncStats[i]);
+    });
 
+    // merge the statistics in the order of functions
     VarKiller::PTStats *stats = VarKiller::PTStats::getInstance();
+    BOOST_FOREACH(const VarKiller::FncStats &fs, fncStats) {
+        stats->count        += fs.count;
+        stats->fullCount    += fs.fullCount;
+    }
+
     if (stats->count > 0) {
         VK_DEBUG(0, "there was killed " << stats->count 
                 << "/" << stats->fullCount << " variables by PointsTo");
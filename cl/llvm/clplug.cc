@@ -163,6 +163,11 @@ static cl::opt<std::string> CLPPFilename("dump-pp",
         cl::ValueOptional,
         cl::value_desc("filename"),
         cl::init("-"), cl::cat(CLOptionCategory));
+static cl::opt<std::string> CLSnapshotFilename("dump-snapshot",
+        cl::desc("Dump code for replaying"),
+        cl::ValueRequired,
+        cl::value_desc("filename"),
+        cl::cat(CLOptionCategory));
 static cl::opt<bool> CLDumpType("dump-types",
         cl::desc("Dump also type info"),
         cl::init(false), cl::cat(CLOptionCategory));
@@ -377,6 +382,14 @@ void CLPass::setup(void) {
         configCL.clear();
     }
 
+    if (!CLSnapshotFilename.empty()) {
+        // the snapshot is recorded the same way as the analyzer sees the code
+        configCL = "listener=\"snapshot\" listener_args=\""
+            + CLSnapshotFilename + "\" clf=\"unfold_switch,unify_labels_gl\"";
+        appendListener(configCL.c_str());
+        configCL.clear();
+    }
+
     if (!CLDryRun) {
         configCL = "listener=\"easy\"";
         if (!CLArgs.empty()) {
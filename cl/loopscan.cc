@@ -21,13 +21,17 @@
 #include "loopscan.hh"
 
 #include <cl/cl_msg.hh>
+#include <cl/parallel.hh>
+#include <cl/phase.hh>
 #include <cl/storage.hh>
 
 #include "util.hh"
 #include "stopwatch.hh"
 
+#include <map>
 #include <set>
 #include <stack>
+#include <vector>
 
 #include <boost/foreach.hpp>
 
@@ -141,21 +145,255 @@ void analyzeFnc(Fnc &fnc)
     }
 }
 
+typedef std::vector<unsigned>               TIdxList;
+
+static const unsigned NO_IDX = static_cast<unsigned>(-1);
+
+/// CFG of a single function numbered in DFS pre-order from its entry
+struct DfsGraph {
+    std::vector<TBlock>         blocks;     ///< pre-order index -> block
+    std::map<TBlock, unsigned>  idxOf;      ///< block -> pre-order index
+    TIdxList                    last;       ///< last descendant in pre-order
+    TIdxList                    postIdx;    ///< pre-order -> post-order
+    TIdxList                    postOrder;  ///< post-order -> pre-order
+
+    // true if the node idxA is an ancestor of idxB in the DFS tree
+    bool isAncestor(unsigned idxA, unsigned idxB) const {
+        return idxA <= idxB && idxB <= last[idxA];
+    }
+};
+
+void numberBlocks(DfsGraph &g, const TBlock entry)
+{
+    std::stack<DfsItem> dfsStack;
+    g.idxOf[entry] = 0U;
+    g.blocks.push_back(entry);
+    g.last.push_back(NO_IDX);
+    dfsStack.push(DfsItem(entry));
+
+    while (!dfsStack.empty()) {
+        DfsItem &top = dfsStack.top();
+        const TTargetList &tlist = top.bb->targets();
+        if (top.target < tlist.size()) {
+            const TBlock bbNext = tlist[top.target++];
+            if (hasKey(g.idxOf, bbNext))
+                continue;
+
+            g.idxOf[bbNext] = g.blocks.size();
+            g.blocks.push_back(bbNext);
+            g.last.push_back(NO_IDX);
+            dfsStack.push(DfsItem(bbNext));
+            continue;
+        }
+
+        // done at this level, all nodes numbered since are descendants
+        const unsigned idx = g.idxOf[top.bb];
+        g.last[idx] = g.blocks.size() - 1;
+        g.postOrder.push_back(idx);
+        dfsStack.pop();
+    }
+
+    const unsigned cnt = g.blocks.size();
+    g.postIdx.resize(cnt);
+    for (unsigned i = 0; i < cnt; ++i)
+        g.postIdx[g.postOrder[i]] = i;
+}
+
+// Cooper, Harvey, Kennedy: A Simple, Fast Dominance Algorithm
+void computeDominators(TIdxList &idom, const DfsGraph &g)
+{
+    const unsigned cnt = g.blocks.size();
+    idom.assign(cnt, NO_IDX);
+    idom[/* entry */ 0] = 0U;
+
+    bool changed = true;
+    while (changed) {
+        changed = false;
+
+        // go through the nodes in reverse post-order, skipping the entry
+        for (int i = static_cast<int>(cnt) - 2; 0 <= i; --i) {
+            const unsigned idx = g.postOrder[i];
+            unsigned dom = NO_IDX;
+
+            BOOST_FOREACH(const TBlock bbSrc, g.blocks[idx]->inbound()) {
+                const std::map<TBlock, unsigned>::const_iterator
+                    it = g.idxOf.find(bbSrc);
+                if (g.idxOf.end() == it)
+                    // unreachable predecessor
+                    continue;
+
+                unsigned pred = it->second;
+                if (NO_IDX == idom[pred])
+                    // not processed yet
+                    continue;
+
+                if (NO_IDX == dom) {
+                    dom = pred;
+                    continue;
+                }
+
+                // intersect
+                while (pred != dom) {
+                    while (g.postIdx[pred] < g.postIdx[dom])
+                        pred = idom[pred];
+                    while (g.postIdx[dom] < g.postIdx[pred])
+                        dom = idom[dom];
+                }
+            }
+
+            if (idom[idx] != dom) {
+                idom[idx] = dom;
+                changed = true;
+            }
+        }
+    }
+}
+
+unsigned findRepresentative(TIdxList &uf, unsigned idx)
+{
+    unsigned root = idx;
+    while (uf[root] != root)
+        root = uf[root];
+
+    // path compression
+    while (uf[idx] != root) {
+        const unsigned next = uf[idx];
+        uf[idx] = root;
+        idx = next;
+    }
+
+    return root;
+}
+
+enum ELoopKind {
+    LK_NONE = 0,
+    LK_REDUCIBLE,
+    LK_IRREDUCIBLE
+};
+
+// Havlak: Nesting of Reducible and Irreducible Loops
+void computeLoopHeaders(
+        TIdxList                    &header,
+        std::vector<ELoopKind>      &kind,
+        const DfsGraph              &g)
+{
+    const unsigned cnt = g.blocks.size();
+    header.assign(cnt, NO_IDX);
+    kind.assign(cnt, LK_NONE);
+
+    // classify the inbound edges
+    std::vector<TIdxList> backPreds(cnt), nonBackPreds(cnt);
+    for (unsigned w = 0; w < cnt; ++w) {
+        BOOST_FOREACH(const TBlock bbSrc, g.blocks[w]->inbound()) {
+            const std::map<TBlock, unsigned>::const_iterator
+                it = g.idxOf.find(bbSrc);
+            if (g.idxOf.end() == it)
+                // unreachable predecessor
+                continue;
+
+            const unsigned v = it->second;
+            if (g.isAncestor(w, v))
+                backPreds[w].push_back(v);
+            else
+                nonBackPreds[w].push_back(v);
+        }
+    }
+
+    TIdxList uf(cnt);
+    for (unsigned i = 0; i < cnt; ++i)
+        uf[i] = i;
+
+    // go through the nodes bottom-up, inner loops are collapsed first
+    for (int w = static_cast<int>(cnt) - 1; 0 <= w; --w) {
+        std::set<unsigned> nodePool;
+        BOOST_FOREACH(const unsigned v, backPreds[w]) {
+            kind[w] = LK_REDUCIBLE;
+            if (v != static_cast<unsigned>(w))
+                nodePool.insert(findRepresentative(uf, v));
+        }
+
+        TIdxList workList(nodePool.begin(), nodePool.end());
+        while (!workList.empty()) {
+            const unsigned x = workList.back();
+            workList.pop_back();
+
+            BOOST_FOREACH(const unsigned y, nonBackPreds[x]) {
+                const unsigned yRep = findRepresentative(uf, y);
+                if (!g.isAncestor(w, yRep)) {
+                    // the loop is entered by a path that avoids its header
+                    kind[w] = LK_IRREDUCIBLE;
+                    nonBackPreds[w].push_back(yRep);
+                    continue;
+                }
+
+                if (yRep != static_cast<unsigned>(w)
+                        && insertOnce(nodePool, yRep))
+                    workList.push_back(yRep);
+            }
+        }
+
+        // collapse the loop into its header
+        BOOST_FOREACH(const unsigned x, nodePool) {
+            header[x] = w;
+            uf[x] = w;
+        }
+    }
+}
+
+void analyzeLoops(Fnc &fnc)
+{
+    ControlFlow &cfg = fnc.cfg;
+    DfsGraph g;
+    numberBlocks(g, cfg.entry());
+
+    TIdxList idom;
+    computeDominators(idom, g);
+
+    TIdxList header;
+    std::vector<ELoopKind> kind;
+    computeLoopHeaders(header, kind, g);
+
+    // headers precede the nodes of their loops in pre-order
+    const unsigned cnt = g.blocks.size();
+    for (unsigned idx = 0; idx < cnt; ++idx) {
+        const TBlock bb = g.blocks[idx];
+        BlockLoopInfo &info = cfg.loopInfo(bb);
+        info.isReachable = true;
+        if (idx)
+            info.idom = g.blocks[idom[idx]];
+
+        info.isLoopHeader = (LK_NONE != kind[idx]);
+        info.isIrreducible = (LK_IRREDUCIBLE == kind[idx]);
+
+        const unsigned hdr = header[idx];
+        if (NO_IDX != hdr) {
+            info.loopHeader = g.blocks[hdr];
+            info.loopDepth = cfg.loopInfo(info.loopHeader).loopDepth;
+        }
+
+        if (info.isLoopHeader) {
+            ++info.loopDepth;
+            LS_DEBUG_MSG(1, &bb->front()->loc, "loop header detected: "
+                    << bb->name() << ", depth = " << info.loopDepth
+                    << ((info.isIrreducible) ? " (irreducible)" : ""));
+        }
+    }
+}
+
 } // namespace LoopScan
 
 void findLoopClosingEdges(Storage &stor)
 {
     StopWatch watch;
+    PhaseTimer timer("findLoopClosingEdges");
 
-    // go through all _defined_ functions
-    BOOST_FOREACH(Fnc *pFnc, stor.fncs) {
-        Fnc &fnc = *pFnc;
-        if (!isDefined(fnc))
-            continue;
-
+    // go through all _defined_ functions (each of them on its own)
+    const std::vector<Fnc *> fncs = definedFncs(stor);
+    parallelFor(fncs.size(), [&fncs](unsigned i) {
         // analyze a single function
-        LoopScan::analyzeFnc(fnc);
-    }
+        LoopScan::analyzeFnc(*fncs[i]);
+        LoopScan::analyzeLoops(*fncs[i]);
+    });
 
     // print time elapsed
     CL_DEBUG("findLoopClosingEdges() took " << watch);
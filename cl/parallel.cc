@@ -0,0 +1,84 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This file is part of predator.
+ *
+ * predator is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * predator is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with predator.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "config_cl.h"
+#include <cl/parallel.hh>
+
+#include <cl/storage.hh>
+
+#include <atomic>
+#include <thread>
+
+#include <boost/foreach.hpp>
+
+namespace CodeStorage {
+
+unsigned cntWorkerThreads()
+{
+    unsigned cnt = CL_PREPROCESS_THREADS;
+    if (!cnt)
+        // use all CPU cores available (if we are able to tell their count)
+        cnt = std::thread::hardware_concurrency();
+
+    return (cnt) ? cnt : 1U;
+}
+
+void parallelFor(unsigned cnt, const std::function<void (unsigned)> &job)
+{
+    unsigned cntThreads = cntWorkerThreads();
+    if (cnt < cntThreads)
+        cntThreads = cnt;
+
+    if (cntThreads < 2) {
+        // no need to spawn any threads
+        for (unsigned i = 0; i < cnt; ++i)
+            job(i);
+
+        return;
+    }
+
+    // the workers pick the jobs one by one from the shared counter
+    std::atomic<unsigned> next(0U);
+    const auto worker = [&]() {
+        for (unsigned i; (i = next++) < cnt;)
+            job(i);
+    };
+
+    std::vector<std::thread> pool;
+    for (unsigned i = 1; i < cntThreads; ++i)
+        pool.push_back(std::thread(worker));
+
+    // the calling thread works, too
+    worker();
+
+    BOOST_FOREACH(std::thread &thr, pool)
+        thr.join();
+}
+
+std::vector<Fnc *> definedFncs(Storage &stor)
+{
+    std::vector<Fnc *> fncs;
+    BOOST_FOREACH(Fnc *pFnc, stor.fncs)
+        if (isDefined(*pFnc))
+            fncs.push_back(pFnc);
+
+    return fncs;
+}
+
+} // namespace CodeStorage
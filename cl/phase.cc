@@ -0,0 +1,313 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This file is part of predator.
+ *
+ * predator is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * predator is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with predator.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "config_cl.h"
+#include <cl/phase.hh>
+
+#include <cl/cl_msg.hh>
+#include <cl/code_listener.h>
+#include <cl/memdebug.hh>
+
+#include "cl_private.hh"
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+bool clPhaseTimerActive = false;
+
+// order the phases and counters by name, not by the address of the literal
+struct NameLess {
+    bool operator()(const char *a, const char *b) const {
+        return 0 > strcmp(a, b);
+    }
+};
+
+struct PhaseNode {
+    typedef std::map<const char *, PhaseNode *, NameLess>      TChildren;
+    typedef std::map<const char *, unsigned long, NameLess>    TCounters;
+
+    const char                 *name;
+    long long                   start;      ///< used by the root only
+    long long                   total;      ///< in nanoseconds
+    unsigned long               cntCalls;
+    long long                   memTotal;   ///< growth of the heap in bytes
+    unsigned long               cntMemCalls;
+    TChildren                   children;
+    TCounters                   counters;
+
+    PhaseNode(const char *name_):
+        name(name_),
+        start(0LL),
+        total(0LL),
+        cntCalls(0UL),
+        memTotal(0LL),
+        cntMemCalls(0UL)
+    {
+    }
+
+    ~PhaseNode() {
+        for (TChildren::const_reference item : children)
+            delete item.second;
+    }
+};
+
+namespace {
+
+struct TraceEvent {
+    const char                 *name;
+    unsigned                    tid;
+    long long                   start;      ///< in nanoseconds
+    long long                   duration;   ///< in nanoseconds
+};
+
+/// the trace is truncated once it reaches this count of events
+const size_t MAX_TRACE_EVENTS = 0x100000;
+
+struct PhaseDb {
+    std::mutex                  lock;
+    PhaseNode                   root;
+    std::string                 traceFile;
+    std::vector<TraceEvent>     trace;
+    unsigned long               cntDropped;
+    std::atomic<unsigned>       lastTid;
+
+    PhaseDb():
+        root("(total)"),
+        cntDropped(0UL),
+        lastTid(0U)
+    {
+    }
+};
+
+PhaseDb *phaseDb;
+
+/// the innermost running phase of the current thread
+thread_local PhaseTimer *topTimer;
+
+/// small sequential id of the current thread, used in the trace events
+unsigned threadId()
+{
+    thread_local unsigned tid;
+    if (!tid)
+        tid = ++phaseDb->lastTid;
+
+    return tid;
+}
+
+/// current size of the heap in bytes, or a negative number if not available
+long long memNow()
+{
+    ssize_t raw;
+    if (!rawMemUsage(&raw))
+        return -1LL;
+
+    return raw;
+}
+
+long long now()
+{
+    using namespace std::chrono;
+    const steady_clock::duration time = steady_clock::now().time_since_epoch();
+    return duration_cast<nanoseconds>(time).count();
+}
+
+std::string jsonString(const char *str)
+{
+    std::string dst("\"");
+    for (const char *s = str; *s; ++s) {
+        if ('"' == *s || '\\' == *s)
+            dst.push_back('\\');
+
+        dst.push_back(*s);
+    }
+
+    dst.push_back('"');
+    return dst;
+}
+
+void writeTrace(const PhaseDb &db)
+{
+    std::ofstream str(db.traceFile.c_str(), std::ios::out | std::ios::trunc);
+    if (!str) {
+        CL_ERROR("failed to open '" << db.traceFile << "' for writing");
+        return;
+    }
+
+    // Chrome trace-event format, the time stamps are in microseconds
+    str << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    const char *sep = "\n";
+    for (const TraceEvent &ev : db.trace) {
+        str << sep << "{\"name\":" << jsonString(ev.name)
+            << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << ev.tid
+            << ",\"ts\":" << (ev.start - db.root.start) / 1000LL
+            << ",\"dur\":" << ev.duration / 1000LL << "}";
+        sep = ",\n";
+    }
+
+    str << "\n]}\n";
+    if (!str)
+        CL_ERROR("failed to write to '" << db.traceFile << "'");
+}
+
+void printSummary(const PhaseNode &node, const std::string &indent)
+{
+    long long self = node.total;
+    for (PhaseNode::TChildren::const_reference item : node.children)
+        self -= item.second->total;
+
+    if (self < 0LL)
+        // the nested phases have been running in parallel
+        self = 0LL;
+
+    std::ostringstream msg;
+    msg << std::fixed << std::setprecision(3)
+        << indent << node.name
+        << ": " << (node.total / 1e9) << " s"
+        << " (self " << (self / 1e9) << " s), "
+        << node.cntCalls << " calls";
+
+    if (node.cntMemCalls)
+        msg << ", heap " << std::showpos << (node.memTotal / 1048576.0)
+            << std::noshowpos << " MB";
+
+    for (PhaseNode::TCounters::const_reference item : node.counters)
+        msg << ", " << item.first << " = " << item.second;
+
+    CL_NOTE(msg.str());
+
+    for (PhaseNode::TChildren::const_reference item : node.children)
+        printSummary(*item.second, indent + "    ");
+}
+
+} // namespace
+
+void PhaseTimer::enter(const char *name)
+{
+    parent_ = topTimer;
+    PhaseNode *parentNode = (parent_)
+        ? parent_->node_
+        : &phaseDb->root;
+
+    {
+        std::lock_guard<std::mutex> guard(phaseDb->lock);
+        PhaseNode *&node = parentNode->children[name];
+        if (!node)
+            node = new PhaseNode(name);
+
+        node_ = node;
+
+        // rawMemUsage() is not thread-safe
+        memStart_ = memNow();
+    }
+
+    topTimer = this;
+    start_ = now();
+}
+
+void PhaseTimer::leave()
+{
+    const long long duration = now() - start_;
+    topTimer = parent_;
+
+    TraceEvent ev;
+    ev.name = node_->name;
+    ev.tid = threadId();
+    ev.start = start_;
+    ev.duration = duration;
+
+    std::lock_guard<std::mutex> guard(phaseDb->lock);
+    node_->total += duration;
+    ++node_->cntCalls;
+
+    const long long memEnd = (0LL <= memStart_)
+        ? memNow()
+        : -1LL;
+
+    if (0LL <= memEnd) {
+        node_->memTotal += memEnd - memStart_;
+        ++node_->cntMemCalls;
+    }
+
+    if (phaseDb->traceFile.empty())
+        return;
+
+    if (phaseDb->trace.size() < MAX_TRACE_EVENTS)
+        phaseDb->trace.push_back(ev);
+    else
+        ++phaseDb->cntDropped;
+}
+
+void phaseCount(const char *name, unsigned long cnt)
+{
+    if (!::clPhaseTimerActive)
+        return;
+
+    PhaseNode *node = (topTimer)
+        ? topTimer->node_
+        : &phaseDb->root;
+
+    std::lock_guard<std::mutex> guard(phaseDb->lock);
+    node->counters[name] += cnt;
+}
+
+// /////////////////////////////////////////////////////////////////////////////
+// see code_listener.h and cl_private.hh for details
+void cl_phase_trace_init(const char *file_name)
+{
+    if (!phaseDb) {
+        phaseDb = new PhaseDb;
+        phaseDb->root.start = now();
+    }
+
+    if (file_name)
+        phaseDb->traceFile = file_name;
+
+    ::clPhaseTimerActive = true;
+}
+
+void cl_phase_trace_flush(void)
+{
+    if (!phaseDb)
+        return;
+
+    // all phases have to be finished by now
+    ::clPhaseTimerActive = false;
+    CL_BREAK_IF(topTimer);
+
+    // the root covers the whole run, including the time outside of phases
+    phaseDb->root.total = now() - phaseDb->root.start;
+    printSummary(phaseDb->root, "");
+    if (phaseDb->cntDropped)
+        CL_WARN("phase trace truncated, " << phaseDb->cntDropped
+                << " events dropped");
+
+    if (!phaseDb->traceFile.empty())
+        writeTrace(*phaseDb);
+
+    delete phaseDb;
+    phaseDb = 0;
+}
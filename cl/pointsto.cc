@@ -25,12 +25,14 @@
 
 #include "pointsto.hh"
 #include "pointsto_fics.hh"
+#include "pointsto_steens.hh"
 #include "pointsto_assert.hh"
 
 #include "worklist.hh"
 #include "clplot.hh"
 
 #include <cl/clutil.hh>
+#include <cl/phase.hh>
 
 #include <algorithm>
 
@@ -541,6 +543,90 @@ Node *goDownS(Node *start, int steps)
     return node;
 }
 
+bool isNull(const cl_operand &op)
+{
+    if (op.code != CL_OPERAND_CST)
+        return false;
+
+    if (!isDataPtr(op.type))
+        return false;
+
+    return (op.data.cst.data.cst_int.value == 0);
+}
+
+bool isPtrRelatedType(const cl_type *type)
+{
+    if (!type)
+        return false;
+    if (type->code == CL_TYPE_STRUCT)
+        return true;
+    return isDataPtr(type);
+}
+
+bool isPtrRelated(const cl_operand &op)
+{
+    if (op.code == CL_OPERAND_VOID)
+        return false;
+
+    if (op.code == CL_OPERAND_CST && op.data.cst.code == CL_TYPE_STRING)
+        // we don't care about constant strings
+        return false;
+
+    return isPtrRelatedType(op.type);
+}
+
+const char *fncNameFromInsn(const Insn *insn)
+{
+    CL_BREAK_IF(insn->code != CL_INSN_CALL);
+    const cl_operand *fncOp = &insn->operands[1 /* fnc */];
+    const char *name;
+    if (!fncNameFromCst(&name, fncOp))
+        // white-list only constants?
+        return NULL;
+    return name;
+}
+
+cl_uid_t generateMallocUid(const Insn *insn)
+{
+    static int i = 0;
+    static std::map<const Insn *, int> ids;
+    if (hasKey(ids, insn))
+        return ids[insn];
+
+    ids[insn] = ++i;
+    return i;
+}
+
+// TODO: push this to separate file (it would be nice to provide some general
+//       models for known functions).
+
+bool isWhiteListedName(const char *name)
+{
+    return STREQ(name, "___sl_error")
+        || STREQ(name, "__VERIFIER_plot")
+        || STREQ(name, "__cxa_guard_acquire")
+        || STREQ(name, "__cxa_guard_release")
+        || STREQ(name, "free")
+        || STREQ(name, "malloc");
+}
+
+bool isWhiteListed(const Insn *insn)
+{
+    const char *name = fncNameFromInsn(insn);
+    if (!name)
+        // white-list only constants?
+        return false;
+
+    return isWhiteListedName(name);
+}
+
+bool isWhiteListed(const Fnc *fnc)
+{
+    const char *name = nameOf(*fnc);
+    return isWhiteListedName(name);
+}
+
+
 static void ptParseOpts(BuildCtx &ctx, const char *ptr)
 {
     CL_BREAK_IF(!ptr);
@@ -558,6 +644,10 @@ static void ptParseOpts(BuildCtx &ctx, const char *ptr)
             PT_DEBUG(0, "Request for plotting PT-graph when graph changed.");
             ctx.plot.progress = "points-to-progress";
         }
+        else if (STREQ(option, "steensgaard")) {
+            PT_DEBUG(0, "Using Steensgaard's algorithm instead of FICS.");
+            ctx.algorithm = PT_ALG_STEENSGAARD;
+        }
         else
             PT_ERROR("Bad argument '" << option << "'");
     }
@@ -656,6 +746,7 @@ bool existsError(const Storage &stor)
 void pointsToAnalyse(Storage &stor, const std::string &conf)
 {
     StopWatch watch;
+    PhaseTimer timer("pointsToAnalyse");
 
     PointsTo::BuildCtx ctx(stor);
     ptParseOpts(ctx, conf.c_str());
@@ -665,11 +756,20 @@ void pointsToAnalyse(Storage &stor, const std::string &conf)
         PT_ERROR("points-to analyse requires correct call graph");
         goto done;
     }
-    // FICS only for now
-    if (!PointsTo::runFICS(ctx)) {
-        stor.ptd.dead = true;
+    bool ok;
+    switch (ctx.algorithm) {
+        case PointsTo::PT_ALG_STEENSGAARD:
+            ok = PointsTo::runSteensgaard(ctx);
+            break;
+
+        case PointsTo::PT_ALG_FICS:
+        default:
+            ok = PointsTo::runFICS(ctx);
     }
 
+    if (!ok)
+        stor.ptd.dead = true;
+
 done:
     CL_DEBUG("pointsToAnalyse() took " << watch);
 }
@@ -48,12 +48,19 @@ namespace PointsTo {
 #define FICS_PHASE_2 0x02
 #define FICS_PHASE_3 0x04
 
+    /// algorithm used to build the points-to graphs
+    enum AlgorithmE {
+        PT_ALG_FICS = 0,        ///< field-insensitive context-sensitive
+        PT_ALG_STEENSGAARD      ///< unification-based, almost linear time
+    };
+
     // structure used for keeping building context among functions
     class BuildCtx {
         public:
             TNodeJoinTodo               joinTodo;
             CodeStorage::Storage       &stor;
             Graph                      *ptg;
+            AlgorithmE                  algorithm;
 
             struct plot {
                 // set this variable when you want to plot all points-to graphs
@@ -71,7 +78,8 @@ namespace PointsTo {
 
             BuildCtx(Storage &stor_) :
                 stor(stor_),
-                ptg(NULL)
+                ptg(NULL),
+                algorithm(PT_ALG_FICS)
             {
                 plot.progress = NULL; // disable by default
                 debug.phases = FICS_PHASE_1 | FICS_PHASE_2 | FICS_PHASE_3;
@@ -251,6 +259,29 @@ namespace PointsTo {
      */
     void addEdge(Node *from, Node *to);
 
+    /// return true if the operand is a NULL constant of a data pointer type
+    bool isNull(const cl_operand &op);
+
+    /// return true if the type is a data pointer or a structure
+    bool isPtrRelatedType(const cl_type *type);
+
+    /// return true if the operand may carry a pointer (string literals don't)
+    bool isPtrRelated(const cl_operand &op);
+
+    /// return name of the directly called function, NULL for indirect calls
+    const char *fncNameFromInsn(const Insn *insn);
+
+    /// return an unique id of the allocation site given by the call of malloc
+    cl_uid_t generateMallocUid(const Insn *insn);
+
+    /**
+     * return true for the functions that are known not to create any
+     * points-to relation (the external functions are handled as black-holes)
+     */
+    bool isWhiteListedName(const char *name);
+    bool isWhiteListed(const Insn *insn);
+    bool isWhiteListed(const Fnc *fnc);
+
     /**
      * return true when some problem occurs
      */
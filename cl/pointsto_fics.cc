@@ -148,60 +148,6 @@ class DataManager {
         TMap cont_;
 };
 
-bool isNull(const cl_operand &op)
-{
-    if (op.code != CL_OPERAND_CST)
-        return false;
-
-    if (!isDataPtr(op.type))
-        return false;
-
-    return (op.data.cst.data.cst_int.value == 0);
-}
-
-inline bool isPtrRelatedType(const cl_type *type)
-{
-    if (!type)
-        return false;
-    if (type->code == CL_TYPE_STRUCT)
-        return true;
-    return isDataPtr(type);
-}
-
-inline bool isPtrRelated(const cl_operand &op)
-{
-    if (op.code == CL_OPERAND_VOID)
-        return false;
-
-    if (op.code == CL_OPERAND_CST && op.data.cst.code == CL_TYPE_STRING)
-        // we don't care about constant strings
-        return false;
-
-    return isPtrRelatedType(op.type);
-}
-
-const char *fncNameFromInsn(const Insn *insn)
-{
-    CL_BREAK_IF(insn->code != CL_INSN_CALL);
-    const cl_operand *fncOp = &insn->operands[1 /* fnc */];
-    const char *name;
-    if (!fncNameFromCst(&name, fncOp))
-        // white-list only constants?
-        return NULL;
-    return name;
-}
-
-cl_uid_t generateMallocUid(const Insn *insn)
-{
-    static int i = 0;
-    static std::map<const Insn *, int> ids;
-    if (hasKey(ids, insn))
-        return ids[insn];
-
-    ids[insn] = ++i;
-    return i;
-}
-
 bool isKnownModel(const Insn *insn, TBindPairs &pairs)
 {
     const char *name = fncNameFromInsn(insn);
@@ -229,35 +175,6 @@ bool isKnownModel(const Insn *insn, TBindPairs &pairs)
     return false;
 }
 
-// TODO: push this to separate file (it would be nice to provide some general
-//       models for known functions).
-
-bool isWhiteListedName(const char *name)
-{
-    return STREQ(name, "___sl_error")
-        || STREQ(name, "__VERIFIER_plot")
-        || STREQ(name, "__cxa_guard_acquire")
-        || STREQ(name, "__cxa_guard_release")
-        || STREQ(name, "free")
-        || STREQ(name, "malloc");
-}
-
-bool isWhiteListed(const Insn *insn)
-{
-    const char *name = fncNameFromInsn(insn);
-    if (!name)
-        // white-list only constants?
-        return false;
-
-    return isWhiteListedName(name);
-}
-
-bool isWhiteListed(const Fnc *fnc)
-{
-    const char *name = nameOf(*fnc);
-    return isWhiteListedName(name);
-}
-
 void dumpPairs(const TBindPairs &pairs)
 {
     BOOST_FOREACH(const TBindPair &pair, pairs) {
@@ -0,0 +1,519 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This file is part of predator.
+ *
+ * predator is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * predator is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with predator.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "config_cl.h"
+#include "pointsto_steens.hh"
+
+#include "builtins.hh"
+#include "util.hh"
+
+#include <cl/clutil.hh>
+#include <cl/storage.hh>
+
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <boost/foreach.hpp>
+#include <boost/functional/hash.hpp>
+
+namespace CodeStorage {
+namespace PointsTo {
+
+namespace {
+
+/// index of an abstract memory location
+typedef unsigned                                    TLoc;
+
+const TLoc NO_LOC = static_cast<TLoc>(-1);
+
+/// (ItemCodeE, uid) -- the uids of variables and functions may collide
+typedef std::pair<int, cl_uid_t>                    TKey;
+typedef std::unordered_map<TKey, TLoc, boost::hash<TKey> >  TLocByKey;
+
+class Solver {
+    public:
+        Solver(Storage &stor):
+            stor_(stor),
+            extLoc_(NO_LOC)
+        {
+        }
+
+        bool handleInsn(const Fnc *fnc, const Insn &insn);
+        void buildGraphs();
+
+    private:
+        TLoc alloc(const Item *item);
+        TLoc find(TLoc loc);
+        void join(TLoc a, TLoc b);
+        TLoc pointee(TLoc loc);
+
+        TLoc lookup(ItemCodeE code, cl_uid_t uid) const;
+        TLoc& slot(ItemCodeE code, cl_uid_t uid);
+        TLoc varLoc(const Var *v);
+        TLoc retLoc(const Fnc *fnc);
+        TLoc heapLoc(cl_uid_t mallocId);
+        TLoc extLoc();
+        TLoc opLoc(const cl_operand &op, bool *referenced);
+
+        void assign(TLoc dst, const cl_operand &src);
+        void escape(const cl_operand &op);
+        bool handleCall(const Insn &insn);
+
+        void buildGraph(Graph &ptg, const std::vector<TLoc> &seeds,
+                const std::vector<TItemList> &itemsByClass);
+
+    private:
+        Storage                        &stor_;
+        std::vector<TLoc>               parent_;
+        std::vector<unsigned>           rank_;
+        std::vector<TLoc>               pts_;       ///< valid for roots only
+        std::vector<const Item *>       items_;     ///< NULL if anonymous
+        TLocByKey                       locByKey_;
+        TLoc                            extLoc_;    ///< unknown code
+};
+
+TLoc Solver::alloc(const Item *item)
+{
+    const TLoc loc = parent_.size();
+    parent_.push_back(loc);
+    rank_.push_back(0U);
+    pts_.push_back(NO_LOC);
+    items_.push_back(item);
+    return loc;
+}
+
+TLoc Solver::find(TLoc loc)
+{
+    TLoc root = loc;
+    while (parent_[root] != root)
+        root = parent_[root];
+
+    // path compression
+    while (parent_[loc] != root) {
+        const TLoc next = parent_[loc];
+        parent_[loc] = root;
+        loc = next;
+    }
+
+    return root;
+}
+
+void Solver::join(TLoc a, TLoc b)
+{
+    std::vector<std::pair<TLoc, TLoc> > todo;
+    todo.push_back(std::make_pair(a, b));
+
+    while (!todo.empty()) {
+        a = find(todo.back().first);
+        b = find(todo.back().second);
+        todo.pop_back();
+        if (a == b)
+            continue;
+
+        // union by rank
+        if (rank_[a] < rank_[b])
+            std::swap(a, b);
+        else if (rank_[a] == rank_[b])
+            ++rank_[a];
+
+        parent_[b] = a;
+
+        // the single pointee of the class is unified, too
+        const TLoc ptsB = pts_[b];
+        if (NO_LOC == ptsB)
+            continue;
+
+        if (NO_LOC == pts_[a])
+            pts_[a] = ptsB;
+        else
+            todo.push_back(std::make_pair(pts_[a], ptsB));
+    }
+}
+
+TLoc Solver::pointee(TLoc loc)
+{
+    loc = find(loc);
+    if (NO_LOC == pts_[loc]) {
+        const TLoc target = alloc(/* anonymous */ 0);
+        pts_[loc] = target;
+    }
+
+    return find(pts_[loc]);
+}
+
+TLoc Solver::lookup(ItemCodeE code, cl_uid_t uid) const
+{
+    const TLocByKey::const_iterator it = locByKey_.find(TKey(code, uid));
+    return (locByKey_.end() == it)
+        ? NO_LOC
+        : it->second;
+}
+
+TLoc& Solver::slot(ItemCodeE code, cl_uid_t uid)
+{
+    const TLocByKey::value_type item(TKey(code, uid), NO_LOC);
+    return locByKey_.insert(item).first->second;
+}
+
+TLoc Solver::varLoc(const Var *v)
+{
+    TLoc &loc = slot(PT_ITEM_VAR, v->uid);
+    if (NO_LOC == loc)
+        loc = alloc(new Item(v));
+
+    return loc;
+}
+
+TLoc Solver::retLoc(const Fnc *fnc)
+{
+    TLoc &loc = slot(PT_ITEM_RET, uidOf(*fnc));
+    if (NO_LOC == loc) {
+        Item *item = new Item(PT_ITEM_RET);
+        item->data.fnc = fnc;
+        loc = alloc(item);
+    }
+
+    return loc;
+}
+
+TLoc Solver::heapLoc(cl_uid_t mallocId)
+{
+    TLoc &loc = slot(PT_ITEM_MALLOC, mallocId);
+    if (NO_LOC == loc) {
+        Item *item = new Item(PT_ITEM_MALLOC);
+        item->data.mallocId = mallocId;
+        loc = alloc(item);
+    }
+
+    return loc;
+}
+
+// the location of everything that the external functions may reach
+TLoc Solver::extLoc()
+{
+    if (NO_LOC != extLoc_)
+        return extLoc_;
+
+    // a self-pointing location, the same as the black-hole of FICS
+    extLoc_ = alloc(/* anonymous */ 0);
+    pts_[extLoc_] = extLoc_;
+
+    // the external functions may reach all the global variables
+    BOOST_FOREACH(const Var &v, stor_.vars)
+        if (VAR_GL == v.code)
+            this->join(extLoc_, this->varLoc(&v));
+
+    return extLoc_;
+}
+
+// the same as nodeAccessS(), the location of the operand is returned
+TLoc Solver::opLoc(const cl_operand &op, bool *referenced)
+{
+    TLoc loc = this->varLoc(&stor_.vars[varIdFromOperand(&op)]);
+    if (referenced)
+        *referenced = false;
+
+    for (const struct cl_accessor *ac = op.accessor; ac; ac = ac->next) {
+        switch (ac->code) {
+            case CL_ACCESSOR_DEREF:
+                loc = this->pointee(loc);
+                break;
+
+            case CL_ACCESSOR_ITEM:
+            case CL_ACCESSOR_OFFSET:
+            case CL_ACCESSOR_DEREF_ARRAY:
+                // the analysis is field-insensitive
+                continue;
+
+            case CL_ACCESSOR_REF:
+                if (referenced)
+                    *referenced = true;
+                return loc;
+        }
+    }
+
+    return loc;
+}
+
+// dst = src
+void Solver::assign(TLoc dst, const cl_operand &src)
+{
+    if (CL_OPERAND_VAR != src.code)
+        // constants do not point anywhere we care about
+        return;
+
+    bool referenced;
+    TLoc loc = this->opLoc(src, &referenced);
+    if (!referenced)
+        loc = this->pointee(loc);
+
+    this->join(this->pointee(dst), loc);
+}
+
+// the operand is given to a function we know nothing about
+void Solver::escape(const cl_operand &op)
+{
+    if (CL_OPERAND_VAR != op.code)
+        return;
+
+    bool referenced;
+    TLoc loc = this->opLoc(op, &referenced);
+    if (!referenced)
+        loc = this->pointee(loc);
+
+    this->join(loc, this->extLoc());
+}
+
+bool Solver::handleCall(const Insn &insn)
+{
+    const TOperandList &opList = insn.operands;
+    const cl_operand &retOp = opList[0];
+
+    cl_uid_t uid;
+    if (!fncUidFromOperand(&uid, &opList[1])) {
+        PT_ERROR("indirect call not supported: " << insn);
+        return false;
+    }
+
+    const Fnc *callee = stor_.fncs[uid];
+    if (isBuiltInFnc(callee->def))
+        return true;
+
+    const char *name = fncNameFromInsn(&insn);
+    if (name && STREQ(name, "malloc")) {
+        if (CL_OPERAND_VAR == retOp.code) {
+            const TLoc dst = this->opLoc(retOp, /* referenced */ 0);
+            const TLoc heap = this->heapLoc(-generateMallocUid(&insn));
+            this->join(this->pointee(dst), heap);
+        }
+
+        return true;
+    }
+
+    if (isWhiteListed(&insn))
+        return true;
+
+    const bool defined = isDefined(*callee);
+    if (!defined)
+        PT_DEBUG(2, "external function: " << nameOf(*callee) << "()");
+
+    // bind the arguments to the parameters of callee
+    for (unsigned i = 2; i < opList.size(); ++i) {
+        const cl_operand &op = opList[i];
+        if (!isPtrRelated(op) || isNull(op))
+            continue;
+
+        const unsigned pos = i - 2;
+        if (!defined || callee->args.size() <= pos) {
+            // unknown code or variadic arguments
+            this->escape(op);
+            continue;
+        }
+
+        const TLoc arg = this->varLoc(&stor_.vars[callee->args[pos]]);
+        this->assign(arg, op);
+    }
+
+    if (CL_OPERAND_VAR != retOp.code || !isPtrRelated(retOp))
+        return true;
+
+    // bind the return value
+    const TLoc dst = this->opLoc(retOp, /* referenced */ 0);
+    const TLoc src = (defined)
+        ? this->pointee(this->retLoc(callee))
+        : this->extLoc();
+
+    this->join(this->pointee(dst), src);
+    return true;
+}
+
+bool Solver::handleInsn(const Fnc *fnc, const Insn &insn)
+{
+    const TOperandList &opList = insn.operands;
+
+    switch (insn.code) {
+        case CL_INSN_NOP:
+        case CL_INSN_JMP:
+        case CL_INSN_COND:
+        case CL_INSN_ABORT:
+        case CL_INSN_LABEL:
+        case CL_INSN_SWITCH:
+        case CL_INSN_CLOBBER:
+            return true;
+
+        case CL_INSN_RET:
+            if (fnc && 1 == opList.size() && isPtrRelated(opList[0]))
+                this->assign(this->retLoc(fnc), opList[0]);
+            return true;
+
+        case CL_INSN_CALL:
+            return this->handleCall(insn);
+
+        case CL_INSN_UNOP:
+            if (CL_UNOP_ASSIGN != insn.subCode)
+                return true;
+            break;
+
+        case CL_INSN_BINOP:
+            switch (insn.subCode) {
+                case CL_BINOP_EQ:
+                case CL_BINOP_NE:
+                case CL_BINOP_LT:
+                case CL_BINOP_LE:
+                case CL_BINOP_GT:
+                case CL_BINOP_GE:
+                case CL_BINOP_TRUTH_OR:
+                case CL_BINOP_TRUTH_AND:
+                    return true;
+
+                default:
+                    break;
+            }
+            break;
+    }
+
+    // assignment or arithmetic, the result may alias any of the sources
+    const cl_operand &dst = opList[0];
+    if (CL_OPERAND_VAR != dst.code)
+        return true;
+
+    const TLoc dstLoc = this->opLoc(dst, /* referenced */ 0);
+    for (unsigned i = 1; i < opList.size(); ++i) {
+        const cl_operand &src = opList[i];
+        if (isPtrRelated(dst) || isPtrRelated(src))
+            this->assign(dstLoc, src);
+    }
+
+    return true;
+}
+
+void Solver::buildGraph(
+        Graph                          &ptg,
+        const std::vector<TLoc>        &seeds,
+        const std::vector<TItemList>   &itemsByClass)
+{
+    std::unordered_map<TLoc, Node *> nodes;
+    std::vector<TLoc> todo;
+
+    const auto nodeOf = [&](TLoc root) -> Node * {
+        Node *&node = nodes[root];
+        if (!node) {
+            node = new Node;
+            BOOST_FOREACH(const Item *item, itemsByClass[root])
+                bindItem(ptg, node, item);
+
+            todo.push_back(root);
+        }
+
+        return node;
+    };
+
+    BOOST_FOREACH(const TLoc loc, seeds)
+        nodeOf(this->find(loc));
+
+    // cut out the part of the solution reachable from the seeds
+    while (!todo.empty()) {
+        const TLoc root = todo.back();
+        todo.pop_back();
+
+        const TLoc target = pts_[root];
+        if (NO_LOC == target)
+            continue;
+
+        Node *node = nodes[root];
+        addEdge(node, nodeOf(this->find(target)));
+    }
+}
+
+void Solver::buildGraphs()
+{
+    const TLoc cnt = parent_.size();
+    std::vector<TItemList> itemsByClass(cnt);
+    for (TLoc loc = 0; loc < cnt; ++loc)
+        if (items_[loc])
+            itemsByClass[this->find(loc)].push_back(items_[loc]);
+
+    // normalize the pointees, so that they are roots of their classes
+    for (TLoc loc = 0; loc < cnt; ++loc)
+        if (NO_LOC != pts_[loc])
+            pts_[loc] = this->find(pts_[loc]);
+
+    PT_DEBUG(1, "steensgaard: " << cnt << " locations");
+
+    std::vector<TLoc> seeds;
+    BOOST_FOREACH(Fnc *fnc, stor_.fncs) {
+        if (!isDefined(*fnc) || isBuiltInFnc(fnc->def))
+            continue;
+
+        seeds.clear();
+        BOOST_FOREACH(const cl_uid_t uid, fnc->vars) {
+            const TLoc loc = this->lookup(PT_ITEM_VAR, uid);
+            if (NO_LOC != loc)
+                seeds.push_back(loc);
+        }
+
+        const TLoc ret = this->lookup(PT_ITEM_RET, uidOf(*fnc));
+        if (NO_LOC != ret)
+            seeds.push_back(ret);
+
+        this->buildGraph(fnc->ptg, seeds, itemsByClass);
+    }
+
+    // the global graph starts from global variables and allocation sites
+    seeds.clear();
+    BOOST_FOREACH(TLocByKey::const_reference item, locByKey_) {
+        const Item *pItem = items_[item.second];
+        if (pItem->isGlobal())
+            seeds.push_back(item.second);
+    }
+
+    this->buildGraph(stor_.ptd.gptg, seeds, itemsByClass);
+}
+
+} // namespace
+
+bool runSteensgaard(BuildCtx &ctx)
+{
+    Storage &stor = ctx.stor;
+    Solver solver(stor);
+
+    // initializers of variables
+    BOOST_FOREACH(const Var &v, stor.vars)
+        BOOST_FOREACH(const Insn *insn, v.initials)
+            if (!solver.handleInsn(/* fnc */ 0, *insn))
+                return false;
+
+    // the analysis is flow-insensitive, the order of functions does not matter
+    BOOST_FOREACH(const Fnc *fnc, stor.fncs) {
+        if (!isDefined(*fnc) || isBuiltInFnc(fnc->def))
+            continue;
+
+        BOOST_FOREACH(const Block *bb, fnc->cfg)
+            BOOST_FOREACH(const Insn *insn, *bb)
+                if (!solver.handleInsn(fnc, *insn))
+                    return false;
+    }
+
+    solver.buildGraphs();
+    return true;
+}
+
+} /* namespace PointsTo */
+} /* namespace CodeStorage */
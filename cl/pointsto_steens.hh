@@ -0,0 +1,39 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This file is part of predator.
+ *
+ * predator is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * predator is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with predator.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef H_GUARD_CL_PT_STEENS_H
+#define H_GUARD_CL_PT_STEENS_H
+
+#include "pointsto.hh"
+
+namespace CodeStorage {
+namespace PointsTo {
+
+/**
+ * Steensgaard's unification-based points-to analysis (flow-insensitive and
+ * context-insensitive), it computes a single solution for the whole program
+ * in almost linear time.  The per-function graphs are then cut out of the
+ * solution in the same single-output shape as FICS builds them.
+ */
+bool runSteensgaard(BuildCtx &ctx);
+
+} /* namespace PointsTo */
+} /* namespace CodeStorage */
+
+#endif /* H_GUARD_CL_PT_STEENS_H */
@@ -0,0 +1,119 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This file is part of predator.
+ *
+ * predator is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * predator is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with predator.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file snaprun.cc
+ * standalone driver running an analyzer on code snapshots, which were written
+ * by the compiler plug-in (see the dump-snapshot option of the plug-in) and
+ * which are linked together first.  It is not a part of libcl,
+ * CL_BUILD_SNAPSHOT_RUNNER() links it with an analyzer.
+ */
+
+#include <cl/code_listener.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+#include <unistd.h>
+
+static void usage(const char *name)
+{
+    fprintf(stderr,
+            "Usage: %s [-v VERBOSITY_LEVEL] [-a PEER_ARGS] [-t TRACE_FILE] "
+            "SNAPSHOT_FILE...\n"
+            "\n"
+            "    Several snapshots are linked together into a single program.\n"
+            "\n"
+            "    -a PEER_ARGS           args given to analyzer\n"
+            "    -t TRACE_FILE          print time spent in phases, write trace\n"
+            "    -v VERBOSITY_LEVEL     turn on verbose mode\n",
+            name);
+}
+
+// escape the args the way the config string parser of ClFactory expects them
+static std::string escapeArgs(const char *args)
+{
+    std::string str;
+    for (const char *s = args; *s; ++s) {
+        if ('"' == *s || '\\' == *s)
+            str.push_back('\\');
+
+        str.push_back(*s);
+    }
+
+    return str;
+}
+
+int main(int argc, char *argv[])
+{
+    const char *name = argv[0];
+    const char *args = "";
+    const char *traceFile = 0;
+    int verbose = 0;
+
+    int opt;
+    while (-1 != (opt = getopt(argc, argv, "a:t:v:"))) {
+        switch (opt) {
+            case 'a':
+                args = optarg;
+                break;
+
+            case 't':
+                traceFile = optarg;
+                break;
+
+            case 'v':
+                verbose = atoi(optarg);
+                break;
+
+            default:
+                usage(name);
+                return EXIT_FAILURE;
+        }
+    }
+
+    if (optind == argc) {
+        usage(name);
+        return EXIT_FAILURE;
+    }
+
+    cl_global_init_defaults(name, verbose);
+    if (traceFile)
+        cl_phase_trace_init(traceFile);
+
+    const std::string config = "listener=\"easy\" listener_args=\""
+        + escapeArgs(args) + "\"";
+
+    struct cl_code_listener *cl = cl_code_listener_create(config.c_str());
+    if (!cl) {
+        // error message already emitted
+        cl_global_cleanup();
+        return EXIT_FAILURE;
+    }
+
+    const bool ok = cl_snapshot_link(argv + optind, argc - optind, cl);
+    if (ok)
+        // run the analyzer
+        cl->acknowledge(cl);
+
+    cl->destroy(cl);
+    cl_global_cleanup();
+    return (ok) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -25,8 +25,10 @@
 #include "cl_storage.hh"
 #include "util.hh"
 
+#include <algorithm>
 #include <map>
 #include <stack>
+#include <vector>
 
 #include <boost/foreach.hpp>
 #include <boost/tuple/tuple.hpp>
@@ -77,6 +79,142 @@ namespace {
 
         return idxTab[iter->second];
     }
+
+    /**
+     * mapping from uids to indexes into a table of values
+     *
+     * Until compact() is called, all the uids are kept in a std::map.  Once
+     * the storage is complete, compact() moves them into a flat table indexed
+     * by (uid - base), so that lookups become O(1) array accesses.  Uids out
+     * of range of the table (if any are added later on) go to the map again.
+     */
+    class UidIndex {
+        public:
+            UidIndex():
+                base_(0)
+            {
+            }
+
+            bool find(cl_uid_t uid, unsigned *pIdx) const;
+            void insert(cl_uid_t uid, unsigned idx);
+            void compact();
+
+        private:
+            static const unsigned NONE = static_cast<unsigned>(-1);
+
+            bool inTab(cl_uid_t uid) const {
+                return base_ <= uid
+                    && static_cast<size_t>(uid - base_) < tab_.size();
+            }
+
+            typedef std::map<cl_uid_t, unsigned>    TMap;
+            TMap                                    map_;
+            cl_uid_t                                base_;
+            std::vector<unsigned>                   tab_;
+    };
+
+    const unsigned UidIndex::NONE;
+
+    bool UidIndex::find(cl_uid_t uid, unsigned *pIdx) const
+    {
+        if (this->inTab(uid)) {
+            *pIdx = tab_[uid - base_];
+            return (NONE != *pIdx);
+        }
+
+        TMap::const_iterator iter = map_.find(uid);
+        if (map_.end() == iter)
+            return false;
+
+        *pIdx = iter->second;
+        return true;
+    }
+
+    void UidIndex::insert(cl_uid_t uid, unsigned idx)
+    {
+        if (!tab_.empty() && base_ <= uid
+                && static_cast<size_t>(uid - base_) < 2 * tab_.size()
+                && !this->inTab(uid)) {
+            // let the flat table grow if the uid is not too far away
+            const cl_uid_t end = base_ + tab_.size();
+            tab_.resize(uid - base_ + 1, NONE);
+
+            // move the uids now covered by the flat table out of the map
+            const TMap::iterator beg = map_.lower_bound(end);
+            const TMap::iterator last = map_.upper_bound(uid);
+            for (TMap::iterator it = beg; it != last; ++it)
+                tab_[it->first - base_] = it->second;
+
+            map_.erase(beg, last);
+        }
+
+        if (this->inTab(uid))
+            tab_[uid - base_] = idx;
+        else
+            map_[uid] = idx;
+    }
+
+    void UidIndex::compact()
+    {
+        if (map_.empty())
+            return;
+
+        cl_uid_t min = map_.begin()->first;
+        cl_uid_t max = map_.rbegin()->first;
+        if (!tab_.empty()) {
+            min = std::min(min, base_);
+            max = std::max<cl_uid_t>(max, base_ + tab_.size() - 1);
+        }
+
+        const size_t cnt = map_.size() + tab_.size();
+        const size_t range = static_cast<size_t>(
+                static_cast<long long>(max) - min + 1);
+        if (4 * cnt + /* small tables */ 0x100 < range)
+            // the uids are too sparse to be worth a flat table
+            return;
+
+        std::vector<unsigned> tab(range, NONE);
+        for (size_t i = 0; i < tab_.size(); ++i)
+            tab[base_ - min + i] = tab_[i];
+
+        BOOST_FOREACH(const TMap::value_type &item, map_)
+            tab[item.first - min] = item.second;
+
+        base_ = min;
+        tab_.swap(tab);
+        map_.clear();
+    }
+
+    template <class TTab>
+    typename TTab::value_type&
+    dbLookup(UidIndex &db, TTab &idxTab, cl_uid_t key,
+             const typename TTab::value_type &tpl
+                 = typename TTab::value_type())
+    {
+        unsigned idx;
+        if (db.find(key, &idx))
+            // key found
+            return idxTab[idx];
+
+        // allocate a new item
+        idx = idxTab.size();
+        db.insert(key, idx);
+        idxTab.push_back(tpl);
+        return idxTab[idx];
+    }
+
+    template <class TTab>
+    const typename TTab::value_type&
+    dbConstLookup(const UidIndex &db, const TTab &idxTab, cl_uid_t key)
+    {
+        unsigned idx;
+        if (!db.find(key, &idx)) {
+            CL_BREAK_IF("can't insert anything into const object");
+            return idxTab.front();
+        }
+
+        return idxTab[idx];
+    }
 }
 
 // /////////////////////////////////////////////////////////////////////////////
@@ -159,8 +297,7 @@ bool isOnStack(const Var &var)
 // /////////////////////////////////////////////////////////////////////////////
 // VarDb implementation
 struct VarDb::Private {
-    typedef std::map<cl_uid_t, unsigned> TMap;
-    TMap db;
+    UidIndex db;
 };
 
 VarDb::VarDb():
@@ -187,12 +324,16 @@ const Var& VarDb::operator[](cl_uid_t uid) const
     return dbConstLookup(d->db, vars_, uid);
 }
 
+void VarDb::compact()
+{
+    d->db.compact();
+}
+
 
 // /////////////////////////////////////////////////////////////////////////////
 // TypeDb implementation
 struct TypeDb::Private {
-    typedef std::map<cl_uid_t, const struct cl_type *> TMap;
-    TMap db;
+    UidIndex db;
 
     int codePtrSizeof;
     int dataPtrSizeof;
@@ -253,14 +394,12 @@ bool TypeDb::insert(const struct cl_type *clt)
     }
     const cl_uid_t uid = clt->uid;
 
-    typedef Private::TMap TDb;
-    TDb &db = d->db;
-    TDb::iterator iter = db.find(uid);
-    if (db.end() != iter)
+    unsigned idx;
+    if (d->db.find(uid, &idx))
         return false;
 
     // insert type into db
-    db[uid] = clt;
+    d->db.insert(uid, types_.size());
     types_.push_back(clt);
 
     d->digPtrSizeof(clt);
@@ -308,10 +447,8 @@ void readTypeTree(TypeDb &db, const struct cl_type *clt)
 
 const struct cl_type* TypeDb::operator[](cl_uid_t uid) const
 {
-    typedef Private::TMap TDb;
-    TDb &db = d->db;
-    TDb::iterator iter = db.find(uid);
-    if (db.end() == iter) {
+    unsigned idx;
+    if (!d->db.find(uid, &idx)) {
         CL_DEBUG("TypeDb::insert() is unable to find the required cl_type: #"
                 << uid);
 
@@ -320,7 +457,12 @@ const struct cl_type* TypeDb::operator[](cl_uid_t uid) const
         return 0;
     }
 
-    return iter->second;
+    return types_[idx];
+}
+
+void TypeDb::compact()
+{
+    d->db.compact();
 }
 
 
@@ -479,6 +621,9 @@ Node::~Node()
 struct ControlFlow::Private {
     typedef std::map<std::string, unsigned> TMap;
     TMap db;
+
+    typedef std::map<const Block *, BlockLoopInfo> TLoopMap;
+    TLoopMap loops;
 };
 
 ControlFlow::ControlFlow():
@@ -526,6 +671,33 @@ const Block* ControlFlow::operator[](const char *name) const
     return dbConstLookup(d->db, bbs_, name);
 }
 
+const BlockLoopInfo& ControlFlow::loopInfo(const Block *bb) const
+{
+    static const BlockLoopInfo unknown;
+    const Private::TLoopMap::const_iterator it = d->loops.find(bb);
+    return (d->loops.end() == it)
+        ? unknown
+        : it->second;
+}
+
+BlockLoopInfo& ControlFlow::loopInfo(const Block *bb)
+{
+    return d->loops[bb];
+}
+
+bool ControlFlow::dominates(const Block *bbA, const Block *bbB) const
+{
+    if (!this->loopInfo(bbA).isReachable)
+        return false;
+
+    // walk up the dominator tree
+    for (const Block *bb = bbB; bb; bb = this->loopInfo(bb).idom)
+        if (bb == bbA)
+            return true;
+
+    return false;
+}
+
 
 // /////////////////////////////////////////////////////////////////////////////
 // Fnc implementation
@@ -568,8 +740,7 @@ bool isDefined(const Fnc &fnc)
 // /////////////////////////////////////////////////////////////////////////////
 // FncDb implementation
 struct FncDb::Private {
-    typedef std::map<cl_uid_t, unsigned> TMap;
-    TMap db;
+    UidIndex db;
 };
 
 FncDb::FncDb():
@@ -611,6 +782,11 @@ const Fnc* FncDb::operator[](cl_uid_t uid) const
     return dbConstLookup(d->db, fncs_, uid);
 }
 
+void FncDb::compact()
+{
+    d->db.compact();
+}
+
 const Fnc* fncByCfg(const ControlFlow *pCfg)
 {
     const char *ptr = reinterpret_cast<const char *>(pCfg);
@@ -35,6 +35,21 @@ private:  // data members
 
 	FAE& fae_;
 
+private:  // methods
+
+	/**
+	 * @brief  Retrieves the signature of a state (empty if there is none)
+	 */
+	static const ConnectionGraph::CutpointSignature& signatureOf(
+		const ConnectionGraph::StateToCutpointSignatureMap&    stateMap,
+		size_t                                                 state)
+	{
+		static const ConnectionGraph::CutpointSignature empty;
+
+		auto iter = stateMap.find(state);
+		return (stateMap.end() == iter)?(empty):(iter->second);
+	}
+
 public:   // methods
 
 	/**
@@ -65,8 +80,8 @@ public:   // methods
 		// compute the abstraction (i.e. which states are to be merged)
 		fae_.getRoot(root)->heightAbstraction(rel, height, f, stateIndex);
 
-		ConnectionGraph::StateToCutpointSignatureMap stateMap;
-		ConnectionGraph::computeSignatures(stateMap, *fae_.getRoot(root));
+		const ConnectionGraph::StateToCutpointSignatureMap& stateMap =
+			fae_.connectionGraph.getStateSignatures(root, *fae_.getRoot(root));
 		for (Index<size_t>::iterator j = stateIndex.begin(); j != stateIndex.end(); ++j)
 		{	// go through the matrix
 			for (Index<size_t>::iterator k = stateIndex.begin(); k != stateIndex.end(); ++k)
@@ -74,7 +89,7 @@ public:   // methods
 				if (k == j)
 					continue;
 
-				if (stateMap[j->first] % stateMap[k->first])
+				if (signatureOf(stateMap, j->first) % signatureOf(stateMap, k->first))
 					continue;
 
 				rel[j->second][k->second] = false;
@@ -166,8 +181,8 @@ public:   // methods
 			assert(nullptr != fae_.getRoot(i));
 
 			// refine the relation according to cutpoints etc.
-			ConnectionGraph::StateToCutpointSignatureMap stateMap;
-			ConnectionGraph::computeSignatures(stateMap, *fae_.getRoot(i));
+			const ConnectionGraph::StateToCutpointSignatureMap& stateMap =
+				fae_.connectionGraph.getStateSignatures(i, *fae_.getRoot(i));
 			for (auto j = faeStateIndex.begin(); j != faeStateIndex.end(); ++j)
 			{	// go through the matrix
 				for (auto k = faeStateIndex.begin(); k != faeStateIndex.end(); ++k)
@@ -196,7 +211,7 @@ public:   // methods
 						continue;
 					}
 
-					if (stateMap[j->first] % stateMap[k->first])
+					if (signatureOf(stateMap, j->first) % signatureOf(stateMap, k->first))
 						continue;
 
 					rel[j->second][k->second] = false;
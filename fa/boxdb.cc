@@ -0,0 +1,772 @@
+/*
+ * This file is part of forester.
+ *
+ * forester is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * forester is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with forester.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Standard library headers
+#include <sstream>
+#include <stdexcept>
+#include <unordered_map>
+#include <unordered_set>
+
+// Forester headers
+#include "boxdb.hh"
+#include "streams.hh"
+
+/*
+ * The format of the database (one record per line, tokens are separated by
+ * white spaces):
+ *
+ *   forester-box-db <version>
+ *   box <name> <arity>
+ *   labels <count>
+ *     data <data>
+ *     node <count> <item>... (info <count> <sel>... | noinfo)
+ *   output
+ *     <ta>
+ *   inputmap <count> <selector>...
+ *   input <input index> | noinput
+ *     <ta>
+ *   selectors <count> (<forward> <backward>)...
+ *   end
+ *
+ * where
+ *
+ *   <data> ::= undef <size> | unknw <size> | void <size> <pointer size>
+ *            | ref <size> <root> <displ> | int <size> <value>
+ *            | bool <size> <value> | other <size> <value>
+ *            | struct <size> <count> (<offset> <data>)...
+ *   <item> ::= sel <sel> | type <name> <count> <selector>... | box <name>
+ *   <sel>  ::= <offset> <size> <displ> <name>
+ *   <ta>   ::= signature <count> <cutpoint>...
+ *              final <count> <state>...
+ *              trans <count> (<label> <rhs> <arity> <lhs state>...)...
+ *   <cutpoint> ::= <root> <refCount> <selCount> <refInherited> <bwdSelector>
+ *                  <count> <fwdSelector>... <count> <defines>...
+ *   <name> ::= <length> ' ' <characters>
+ */
+
+namespace
+{	// anonymous namespace
+
+const char* const BOX_DB_MAGIC = "forester-box-db";
+const unsigned BOX_DB_VERSION = 2;
+
+/**
+ * @brief  Writes boxes into a stream
+ *
+ * Boxes are written in the post-order with respect to nesting, i.e. each box is
+ * preceded by all boxes that appear in the labels of its tree automata.
+ */
+class BoxWriter
+{
+private:  // data members
+
+	std::ostream& os_;
+
+	/// boxes that have already been processed (and whether they were written)
+	std::unordered_map<const Box*, bool> done_;
+
+	size_t count_;
+
+private:  // methods
+
+	BoxWriter(const BoxWriter&);
+	BoxWriter& operator=(const BoxWriter&);
+
+	static bool writeData(std::ostream& os, const Data& data)
+	{
+		switch (data.type)
+		{
+			case data_type_e::t_undef:
+				os << "undef " << data.size;
+				return true;
+
+			case data_type_e::t_unknw:
+				os << "unknw " << data.size;
+				return true;
+
+			case data_type_e::t_void_ptr:
+				os << "void " << data.size << ' ' << data.d_void_ptr_size;
+				return true;
+
+			case data_type_e::t_ref:
+				os << "ref " << data.size << ' ' << data.d_ref.root << ' '
+					<< data.d_ref.displ;
+				return true;
+
+			case data_type_e::t_int:
+				os << "int " << data.size << ' ' << data.d_int;
+				return true;
+
+			case data_type_e::t_bool:
+				os << "bool " << data.size << ' ' << data.d_bool;
+				return true;
+
+			case data_type_e::t_other:
+				os << "other " << data.size << ' ' << data.d_void_ptr_size;
+				return true;
+
+			case data_type_e::t_struct:
+				os << "struct " << data.size << ' ' << data.d_struct->size();
+				for (const Data::item_info& item : *data.d_struct)
+				{
+					os << ' ' << item.first << ' ';
+					if (!writeData(os, item.second))
+						return false;
+				}
+				return true;
+
+			default:
+				// native pointers do not survive the current run
+				return false;
+		}
+	}
+
+	/**
+	 * @brief  Writes a name prefixed by its length
+	 *
+	 * Names of selectors and types may contain white spaces (such as
+	 * "(anon union)"), so they cannot be stored as plain tokens.
+	 */
+	static void writeName(std::ostream& os, const std::string& name)
+	{
+		os << name.size() << ' ' << name;
+	}
+
+	static void writeSel(std::ostream& os, const SelData& sel)
+	{
+		// Assertions
+		assert(!sel.name.empty());
+
+		os << ' ' << sel.offset << ' ' << sel.size << ' ' << sel.displ << ' ';
+		writeName(os, sel.name);
+	}
+
+	static void writeSignature(
+		std::ostream&                               os,
+		const ConnectionGraph::CutpointSignature&   signature)
+	{
+		os << "signature " << signature.size();
+		for (const ConnectionGraph::CutpointInfo& cutpoint : signature)
+		{
+			os << ' ' << cutpoint.root << ' ' << cutpoint.refCount << ' '
+				<< cutpoint.selCount << ' ' << cutpoint.refInherited << ' '
+				<< cutpoint.bwdSelector << ' ' << cutpoint.fwdSelectors.size();
+
+			for (size_t sel : cutpoint.fwdSelectors)
+				os << ' ' << sel;
+
+			os << ' ' << cutpoint.defines.size();
+			for (size_t sel : cutpoint.defines)
+				os << ' ' << sel;
+		}
+
+		os << '\n';
+	}
+
+	/**
+	 * @brief  Writes a label of a box into @p os
+	 *
+	 * @returns  @p false if the label cannot be stored persistently
+	 */
+	bool writeLabel(std::ostream& os, const label_type& label)
+	{
+		if (label->isData())
+		{
+			os << "data ";
+			return writeData(os, label->getData());
+		}
+
+		if (!label->isNode())
+			return false;
+
+		const std::vector<const AbstractBox*>& node = label->getNode();
+		os << "node " << node.size();
+		for (const AbstractBox* aBox : node)
+		{
+			switch (aBox->getType())
+			{
+				case box_type_e::bSel:
+					os << " sel";
+					writeSel(os, static_cast<const SelBox*>(aBox)->getData());
+					break;
+
+				case box_type_e::bTypeInfo:
+				{
+					const TypeBox* typeBox = static_cast<const TypeBox*>(aBox);
+					os << " type ";
+					writeName(os, typeBox->getName());
+					os << ' ' << typeBox->getSelectors().size();
+
+					for (size_t sel : typeBox->getSelectors())
+						os << ' ' << sel;
+
+					break;
+				}
+
+				case box_type_e::bBox:
+				{
+					const Box* box = static_cast<const Box*>(aBox);
+					if (!this->write(box))
+						return false;
+
+					os << " box ";
+					writeName(os, box->getName());
+					break;
+				}
+
+				default:
+					assert(false);      // fail gracefully
+					return false;
+			}
+		}
+
+		const std::vector<SelData>* sels = label->node.sels;
+		if (nullptr == sels)
+		{
+			os << " noinfo";
+			return true;
+		}
+
+		os << " info " << sels->size();
+		for (const SelData& sel : *sels)
+			writeSel(os, sel);
+
+		return true;
+	}
+
+	bool collectLabels(
+		std::ostream&                                    os,
+		std::unordered_map<label_type, size_t>&          labels,
+		const TreeAut&                                   ta)
+	{
+		for (const TreeAut::Transition& trans : ta)
+		{
+			if (!labels.insert(std::make_pair(trans.label(), labels.size())).second)
+				continue;
+
+			os << "  ";
+			if (!this->writeLabel(os, trans.label()))
+				return false;
+
+			os << '\n';
+		}
+
+		return true;
+	}
+
+	static void writeTA(
+		std::ostream&                                    os,
+		const std::unordered_map<label_type, size_t>&    labels,
+		const TreeAut&                                   ta,
+		const ConnectionGraph::CutpointSignature&        signature)
+	{
+		os << "  ";
+		writeSignature(os, signature);
+
+		os << "  final " << ta.getFinalStates().size();
+		for (size_t state : ta.getFinalStates())
+			os << ' ' << state;
+
+		os << "\n  trans " << ta.getTransitions().size() << '\n';
+		for (const TreeAut::Transition& trans : ta)
+		{
+			auto iter = labels.find(trans.label());
+			assert(labels.end() != iter);
+
+			os << "    " << iter->second << ' ' << trans.rhs() << ' '
+				<< trans.lhs().size();
+
+			for (size_t state : trans.lhs())
+				os << ' ' << state;
+
+			os << '\n';
+		}
+	}
+
+public:   // methods
+
+	BoxWriter(std::ostream& os) :
+		os_(os),
+		done_{},
+		count_(0)
+	{ }
+
+	/**
+	 * @brief  Writes @p box (and all boxes nested in it) unless already written
+	 *
+	 * @returns  @p false if the box cannot be stored persistently
+	 */
+	bool write(const Box* box)
+	{
+		// Assertions
+		assert(nullptr != box);
+
+		auto iterBoolPair = done_.insert(std::make_pair(box, false));
+		if (!iterBoolPair.second)
+			return iterBoolPair.first->second;
+
+		// the labels need to be written first as they may pull nested boxes
+		std::ostringstream labelStream;
+		std::unordered_map<label_type, size_t> labels;
+		if (!this->collectLabels(labelStream, labels, *box->getOutput())
+			|| (box->getInput()
+				&& !this->collectLabels(labelStream, labels, *box->getInput())))
+		{
+			FA_WARN("box database: unable to store " << box->getName());
+			return false;
+		}
+
+		std::ostream& os = os_;
+		os << "box ";
+		writeName(os, box->getName());
+		os << ' ' << box->getArity() << '\n';
+		os << "labels " << labels.size() << '\n' << labelStream.str();
+
+		os << "output\n";
+		writeTA(os, labels, *box->getOutput(), box->getOutputSignature());
+
+		os << "inputmap " << box->getInputMap().size();
+		for (size_t sel : box->getInputMap())
+			os << ' ' << sel;
+
+		os << '\n';
+
+		if (box->getInput())
+		{
+			os << "input " << box->getInputIndex() << '\n';
+			writeTA(os, labels, *box->getInput(), box->getInputSignature());
+		}
+		else
+		{
+			os << "noinput\n";
+		}
+
+		os << "selectors " << box->getSelectors().size();
+		for (const std::pair<size_t, size_t>& sel : box->getSelectors())
+			os << ' ' << sel.first << ' ' << sel.second;
+
+		os << "\nend\n";
+
+		++count_;
+		return iterBoolPair.first->second = true;
+	}
+
+	size_t count() const
+	{
+		return count_;
+	}
+};
+
+
+/**
+ * @brief  Reads boxes from a stream
+ */
+class BoxReader
+{
+private:  // data members
+
+	std::istream& is_;
+	const std::string& name_;
+	BoxMan& boxMan_;
+	TreeAut::Backend& backend_;
+
+	/// the boxes loaded so far (indexed by their name in the database)
+	std::unordered_map<std::string, const Box*> boxes_;
+
+	/// the name of the box being read
+	std::string boxName_;
+
+	/// does the box being read match the types of the current program?
+	bool valid_;
+
+	size_t count_;
+
+private:  // methods
+
+	BoxReader(const BoxReader&);
+	BoxReader& operator=(const BoxReader&);
+
+	void fail(const std::string& msg) const
+	{
+		throw std::runtime_error(name_ + ": malformed box database: " + msg);
+	}
+
+	template <class T>
+	T read()
+	{
+		T val;
+		if (!(is_ >> val))
+			this->fail("unexpected end of input");
+
+		return val;
+	}
+
+	std::string readName()
+	{
+		const size_t len = this->read<size_t>();
+		if (' ' != is_.get())
+			this->fail("expected a name");
+
+		std::string name(len, '\0');
+		if (!len || !is_.read(&name[0], len))
+			this->fail("truncated name");
+
+		return name;
+	}
+
+	void expect(const std::string& keyword)
+	{
+		const std::string token = this->read<std::string>();
+		if (token != keyword)
+			this->fail("expected '" + keyword + "', got '" + token + "'");
+	}
+
+	void invalidate(const std::string& reason)
+	{
+		if (valid_)
+			FA_NOTE("box database: skipping " << boxName_ << ": " << reason);
+
+		valid_ = false;
+	}
+
+	Data readData()
+	{
+		const std::string kind = this->read<std::string>();
+		const int size = this->read<int>();
+
+		Data data;
+		if ("undef" == kind)
+			data = Data::createUndef();
+		else if ("unknw" == kind)
+			data = Data::createUnknw();
+		else if ("void" == kind)
+			data = Data::createVoidPtr(this->read<size_t>());
+		else if ("ref" == kind)
+		{
+			const size_t root = this->read<size_t>();
+			data = Data::createRef(root, this->read<int>());
+		}
+		else if ("int" == kind)
+			data = Data::createInt(this->read<int>());
+		else if ("bool" == kind)
+			data = Data::createBool(this->read<bool>());
+		else if ("other" == kind)
+		{
+			data = Data(data_type_e::t_other);
+			data.d_void_ptr_size = this->read<size_t>();
+		}
+		else if ("struct" == kind)
+		{
+			std::vector<Data::item_info> items;
+			for (size_t cnt = this->read<size_t>(); cnt; --cnt)
+			{
+				const size_t offset = this->read<size_t>();
+				items.push_back(std::make_pair(offset, this->readData()));
+			}
+
+			data = Data::createStruct(items);
+		}
+		else
+			this->fail("unknown kind of data '" + kind + "'");
+
+		data.size = size;
+		return data;
+	}
+
+	SelData readSel()
+	{
+		const size_t offset = this->read<size_t>();
+		const int size = this->read<int>();
+		const int displ = this->read<int>();
+		return SelData(offset, size, displ, this->readName());
+	}
+
+	label_type readLabel()
+	{
+		const std::string kind = this->read<std::string>();
+		if ("data" == kind)
+			return boxMan_.lookupLabel(this->readData());
+
+		if ("node" != kind)
+			this->fail("unknown kind of label '" + kind + "'");
+
+		std::vector<const AbstractBox*> node;
+		const TypeBox* typeBox = nullptr;
+		for (size_t cnt = this->read<size_t>(); cnt; --cnt)
+		{
+			const std::string item = this->read<std::string>();
+			if ("sel" == item)
+			{
+				node.push_back(boxMan_.getSelector(this->readSel()));
+			}
+			else if ("type" == item)
+			{
+				const std::string typeName = this->readName();
+				std::vector<size_t> sels(this->read<size_t>());
+				for (size_t& sel : sels)
+					sel = this->read<size_t>();
+
+				try
+				{
+					typeBox = boxMan_.getTypeInfo(typeName);
+				}
+				catch (const std::runtime_error&)
+				{
+					this->invalidate("unknown type " + typeName);
+					continue;
+				}
+
+				if (typeBox->getSelectors() != sels)
+					this->invalidate("incompatible layout of " + typeName);
+
+				node.push_back(typeBox);
+			}
+			else if ("box" == item)
+			{
+				const std::string nested = this->readName();
+				auto iter = boxes_.find(nested);
+				if (boxes_.end() == iter)
+				{
+					this->invalidate("missing nested box " + nested);
+					continue;
+				}
+
+				node.push_back(iter->second);
+			}
+			else
+			{
+				this->fail("unknown item of a label '" + item + "'");
+			}
+		}
+
+		const std::vector<SelData>* nodeInfo = nullptr;
+		const std::string info = this->read<std::string>();
+		if ("info" == info)
+		{
+			std::vector<SelData> sels;
+			for (size_t cnt = this->read<size_t>(); cnt; --cnt)
+				sels.push_back(this->readSel());
+
+			if (valid_ && (nullptr != typeBox))
+				nodeInfo = boxMan_.LookupTypeDesc(typeBox, sels);
+		}
+		else if ("noinfo" != info)
+		{
+			this->fail("expected 'info' or 'noinfo', got '" + info + "'");
+		}
+
+		if (!valid_)
+			return label_type();
+
+		return boxMan_.lookupLabel(node, nodeInfo);
+	}
+
+	void readSignature(ConnectionGraph::CutpointSignature& signature)
+	{
+		this->expect("signature");
+		for (size_t cnt = this->read<size_t>(); cnt; --cnt)
+		{
+			ConnectionGraph::CutpointInfo cutpoint(this->read<size_t>());
+			cutpoint.refCount = this->read<size_t>();
+			cutpoint.selCount = this->read<size_t>();
+			cutpoint.refInherited = this->read<bool>();
+			cutpoint.bwdSelector = this->read<size_t>();
+
+			cutpoint.fwdSelectors.clear();
+			for (size_t i = this->read<size_t>(); i; --i)
+				cutpoint.fwdSelectors.insert(this->read<size_t>());
+
+			for (size_t i = this->read<size_t>(); i; --i)
+				cutpoint.defines.insert(this->read<size_t>());
+
+			if (cutpoint.fwdSelectors.empty())
+				this->fail("cutpoint without forward selectors");
+
+			signature.push_back(cutpoint);
+		}
+	}
+
+	std::shared_ptr<TreeAut> readTA(
+		const std::vector<label_type>&               labels,
+		ConnectionGraph::CutpointSignature&          signature)
+	{
+		std::shared_ptr<TreeAut> ta = std::shared_ptr<TreeAut>(
+			new TreeAut(backend_));
+
+		this->readSignature(signature);
+
+		this->expect("final");
+		for (size_t cnt = this->read<size_t>(); cnt; --cnt)
+			ta->addFinalState(this->read<size_t>());
+
+		this->expect("trans");
+		std::vector<size_t> lhs;
+		for (size_t cnt = this->read<size_t>(); cnt; --cnt)
+		{
+			const size_t label = this->read<size_t>();
+			if (labels.size() <= label)
+				this->fail("label out of range");
+
+			const size_t rhs = this->read<size_t>();
+			lhs.resize(this->read<size_t>());
+			for (size_t& state : lhs)
+				state = this->read<size_t>();
+
+			if (valid_)
+				ta->addTransition(lhs, labels[label], rhs);
+		}
+
+		if (valid_ && ta->getFinalStates().empty())
+			this->fail("tree automaton without final states");
+
+		return ta;
+	}
+
+	void readBox()
+	{
+		boxName_ = this->readName();
+		const size_t arity = this->read<size_t>();
+		valid_ = true;
+
+		this->expect("labels");
+		std::vector<label_type> labels;
+		for (size_t cnt = this->read<size_t>(); cnt; --cnt)
+			labels.push_back(this->readLabel());
+
+		this->expect("output");
+		ConnectionGraph::CutpointSignature outputSignature;
+		std::shared_ptr<TreeAut> output = this->readTA(labels, outputSignature);
+
+		this->expect("inputmap");
+		std::vector<size_t> inputMap(this->read<size_t>());
+		for (size_t& sel : inputMap)
+			sel = this->read<size_t>();
+
+		std::shared_ptr<TreeAut> input;
+		size_t inputIndex = 0;
+		ConnectionGraph::CutpointSignature inputSignature;
+		const std::string token = this->read<std::string>();
+		if ("input" == token)
+		{
+			inputIndex = this->read<size_t>();
+			input = this->readTA(labels, inputSignature);
+		}
+		else if ("noinput" != token)
+		{
+			this->fail("expected 'input' or 'noinput', got '" + token + "'");
+		}
+
+		this->expect("selectors");
+		std::vector<std::pair<size_t, size_t>> selectors(this->read<size_t>());
+		for (std::pair<size_t, size_t>& sel : selectors)
+		{
+			sel.first = this->read<size_t>();
+			sel.second = this->read<size_t>();
+		}
+
+		this->expect("end");
+
+		if (selectors.size() != arity)
+			this->fail("arity mismatch of " + boxName_);
+
+		if (!valid_)
+			return;
+
+		const Box* box = boxMan_.loadBox(Box(
+			"",
+			output,
+			outputSignature,
+			inputMap,
+			input,
+			inputIndex,
+			inputSignature,
+			selectors));
+
+		boxes_[boxName_] = box;
+		++count_;
+	}
+
+public:   // methods
+
+	BoxReader(
+		std::istream&                  is,
+		const std::string&             name,
+		BoxMan&                        boxMan,
+		TreeAut::Backend&              backend) :
+		is_(is),
+		name_(name),
+		boxMan_(boxMan),
+		backend_(backend),
+		boxes_{},
+		boxName_{},
+		valid_(true),
+		count_(0)
+	{ }
+
+	size_t readAll()
+	{
+		this->expect(BOX_DB_MAGIC);
+		const unsigned version = this->read<unsigned>();
+		if (BOX_DB_VERSION != version)
+		{
+			FA_WARN(name_ << ": unsupported version of box database ("
+				<< version << "), ignoring it");
+			return 0;
+		}
+
+		std::string token;
+		while (is_ >> token)
+		{
+			if ("box" != token)
+				this->fail("expected 'box', got '" + token + "'");
+
+			this->readBox();
+		}
+
+		return count_;
+	}
+};
+
+} // namespace
+
+
+size_t BoxDb::save(
+	std::ostream&                       os,
+	const BoxMan&                       boxMan)
+{
+	std::vector<const Box*> boxes;
+	boxMan.boxDatabase().asVector(boxes);
+
+	os << BOX_DB_MAGIC << ' ' << BOX_DB_VERSION << '\n';
+
+	BoxWriter writer(os);
+	for (const Box* box : boxes)
+		writer.write(box);
+
+	return writer.count();
+}
+
+
+size_t BoxDb::load(
+	std::istream&                       is,
+	const std::string&                  name,
+	BoxMan&                             boxMan,
+	TreeAut::Backend&                   backend)
+{
+	BoxReader reader(is, name, boxMan, backend);
+	return reader.readAll();
+}
@@ -0,0 +1,89 @@
+/*
+ * This file is part of forester.
+ *
+ * forester is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * forester is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with forester.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BOX_DB_H
+#define BOX_DB_H
+
+// Standard library headers
+#include <istream>
+#include <ostream>
+#include <string>
+
+// Forester headers
+#include "boxman.hh"
+
+/**
+ * @file boxdb.hh
+ * BoxDb - persistent storage of learnt boxes
+ */
+
+/// the name of the file holding the box database inside of the db-root
+#define FA_BOX_DB_FILE "boxes.db"
+
+/**
+ * @brief  Persistent storage of learnt boxes
+ *
+ * This class exports the database of boxes learnt by the box manager into a
+ * stable textual format and imports it back, so that later runs of the
+ * analysis can start with the boxes that were already discovered.  The format
+ * refers to type information and selectors by their names and offsets (not by
+ * pointers), boxes nested in other boxes are always written before the boxes
+ * they are used in.  A box whose type information does not match the types of
+ * the current program is skipped on import (and so are the boxes that use it).
+ */
+class BoxDb
+{
+public:   // methods
+
+	/**
+	 * @brief  Exports the database of boxes
+	 *
+	 * This method writes all boxes from the database of @p boxMan (including
+	 * obsolete boxes which are still referenced from active ones) to @p os.
+	 *
+	 * @param[out]  os      The output stream
+	 * @param[in]   boxMan  The box manager with the boxes to be exported
+	 *
+	 * @returns  The number of exported boxes
+	 */
+	static size_t save(
+		std::ostream&                       os,
+		const BoxMan&                       boxMan);
+
+
+	/**
+	 * @brief  Imports boxes into the database
+	 *
+	 * This method reads boxes from @p is and inserts them into the database of
+	 * @p boxMan.  Type information needs to be loaded in @p boxMan in advance.
+	 * Tree automata of the loaded boxes are allocated in @p backend.
+	 *
+	 * @param[in]      is       The input stream
+	 * @param[in]      name     The name of the input (for error messages)
+	 * @param[in,out]  boxMan   The box manager to insert the boxes into
+	 * @param[in,out]  backend  The backend for the tree automata of the boxes
+	 *
+	 * @returns  The number of imported boxes
+	 */
+	static size_t load(
+		std::istream&                       is,
+		const std::string&                  name,
+		BoxMan&                             boxMan,
+		TreeAut::Backend&                   backend);
+};
+
+#endif
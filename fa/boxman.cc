@@ -421,6 +421,8 @@ const Box* BoxMan::getBox(const Box& box)
 	{	// in the case a new box was inserted
 		Box* pBox = const_cast<Box*>(cpBox);
 
+		++generation_;
+
 		// perform initialization
 		pBox->name_ = this->getBoxName();
 		pBox->initialize();
@@ -437,6 +439,28 @@ const Box* BoxMan::getBox(const Box& box)
 }
 
 
+const Box* BoxMan::loadBox(const Box& box)
+{
+	const Box* cpBox = boxes_.get(box);
+	assert(nullptr != cpBox);
+
+	if (boxes_.modified())
+	{	// in the case a new box was inserted
+		Box* pBox = const_cast<Box*>(cpBox);
+
+		++generation_;
+
+		pBox->name_ = this->getBoxName();
+		pBox->initialize();
+
+		FA_DEBUG_AT(1, "loaded " << *static_cast<const AbstractBox*>(cpBox)
+			<< ':' << std::endl << *cpBox);
+	}
+
+	return cpBox;
+}
+
+
 void BoxMan::clear()
 {
 	utils::eraseMap(dataStore_);
@@ -447,4 +471,5 @@ void BoxMan::clear()
 	utils::eraseMap(selIndex_);
 	utils::eraseMap(typeIndex_);
 	boxes_.clear();
+	++generation_;
 }
@@ -289,6 +289,9 @@ private:  // data members
 
 	BoxDatabase boxes_;
 
+	/// incremented whenever the database of boxes changes
+	size_t generation_;
+
 	TTypeDescDict typeDescDict_;
 
 private:  // methods
@@ -448,6 +451,19 @@ public:
 	const Box* getBox(const Box& box);
 
 
+	/**
+	 * @brief  Inserts a previously learnt box into the database
+	 *
+	 * This method inserts a box loaded from a persistent box database. Unlike
+	 * BoxMan::getBox(), it never requests restart of the analysis.
+	 *
+	 * @param[in]  box  The box to be inserted into the database
+	 *
+	 * @returns  Unique pointer to the box (or to the box that subsumes it)
+	 */
+	const Box* loadBox(const Box& box);
+
+
 	const Box* lookupBox(const Box& box) const
 	{
 		return boxes_.lookup(box);
@@ -462,6 +478,7 @@ public:
 		selIndex_{},
 		typeIndex_{},
 		boxes_{},
+		generation_(0),
 		typeDescDict_{}
 	{ }
 
@@ -476,6 +493,20 @@ public:
 	{
 		return boxes_;
 	}
+
+	/**
+	 * @brief  The generation of the database of boxes
+	 *
+	 * The generation changes every time a box is inserted into the database (or
+	 * the database is cleared), so it can be used to validate results computed
+	 * with a particular set of boxes.
+	 *
+	 * @returns  The current generation of the database
+	 */
+	size_t boxGeneration() const
+	{
+		return generation_;
+	}
 };
 
 #endif
@@ -20,6 +20,7 @@
 // Standard library headers
 #include <ctime>
 #include <signal.h>
+#include <stdexcept>
 
 // Code Listener headers
 #include <cl/cl_msg.hh>
@@ -50,31 +51,6 @@ extern "C" {
     __attribute__ ((__visibility__ ("default"))) int plugin_is_GPL_compatible;
 }
 
-#if 0
-struct BoxDb {
-
-	std::unordered_map<std::string, std::string> store;
-
-	BoxDb(const std::string& root, const std::string& fileName) {
-		std::ifstream input((root + "/" + fileName).c_str());
-		if (!input.good())
-			throw std::runtime_error("Unable to open " + root + "/" + fileName);
-		std::string buf;
-		while (std::getline(input, buf)) {
-			if (buf.empty())
-				continue;
-			if (buf[0] == '#')
-				continue;
-			std::vector<std::string> data;
-			boost::split(data, buf, boost::is_from_range(':', ':'));
-			if (data.size() == 2)
-				this->store[data[0]] = root + "/" + data[1];
-		}
-	}
-
-};
-#endif
-
 void clEasyRun(const CodeStorage::Storage& stor, const char* configString)
 {
 	ssd::ColorConsole::enableForTerm(STDERR_FILENO);
@@ -126,12 +102,19 @@ void clEasyRun(const CodeStorage::Storage& stor, const char* configString)
 		FA_LOG("loading types ...");
 		se->loadTypes(stor);
 
-/*
-		if (!conf.dbRoot.empty()){
-			BoxDb db(conf.dbRoot, "index");
-			se.loadBoxes(db.store);
+		if (!conf.dbRoot.empty())
+		{
+			FA_LOG("loading boxes ...");
+			try
+			{
+				se->loadBoxes(conf.dbRoot);
+			}
+			catch (const std::runtime_error& e)
+			{	// drop whatever has been loaded before the failure
+				FA_NOTE(e.what() << ", starting with no boxes");
+				se->loadTypes(stor);
+			}
 		}
-*/
 
 		FA_LOG("compiling to microcode ...");
 		se->compile(stor, *main);
@@ -155,6 +138,16 @@ void clEasyRun(const CodeStorage::Storage& stor, const char* configString)
 		{
 			FA_LOG("starting symbolic execution ...");
 			se->run();
+
+			if (conf.dbUpdate && conf.dbRoot.empty())
+			{
+				FA_WARN("\"db-update\" requires \"db-root:<path>\", not saving boxes");
+			}
+			else if (conf.dbUpdate)
+			{
+				FA_LOG("saving boxes ...");
+				se->saveBoxes(conf.dbRoot);
+			}
 		}
 	}
 	catch (const NotImplementedException& e)
@@ -65,5 +65,16 @@
  */
 #define FA_USE_PREDICATE_ABSTRACTION     0
 
+/**
+ * use a separate store of tree automata transitions for every thread instead
+ * of a single process-wide one (default is 0)
+ */
+#define FA_TA_STORE_THREAD_LOCAL         0
+
+/**
+ * the maximal number of memoized results of normalization and folding kept by
+ * a single fixpoint instruction, 0 disables the memoization (default is 1024)
+ */
+#define FA_FIXPOINT_MEMO_SIZE            1024
 
 #endif /* CONFIG_H */
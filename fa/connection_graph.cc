@@ -503,25 +503,27 @@ void ConnectionGraph::mergeCutpoint(size_t dst, size_t src)
 
 void ConnectionGraph::normalizeSignature(CutpointSignature& signature)
 {
-	std::unordered_map<size_t, CutpointInfo*> m;
-
 	size_t offset = 0;
 
 	for (size_t i = 0; i < signature.size(); ++i)
 	{	// for each CutpointInfo
-		auto itBoolPair = m.insert(
-			std::make_pair(signature[i].root, &signature[offset]));
+		// signatures are short, so a linear search for the record is cheaper
+		// than any kind of index
+		size_t j = 0;
+		while ((j < offset) && (signature[j].root != signature[i].root))
+			++j;
+
+		if (j == offset)
+		{	// in case there is no record for the given root yet
+			if (offset != i)
+				signature[offset] = signature[i];
 
-		if (itBoolPair.second)
-		{	// in case there is no record for the given root in 'm'
-			signature[offset] = signature[i];
 			signature[offset].refInherited = signature[offset].refCount > 1;
 
 			++offset;
 		} else
-		{	// in case there already is a record for the given root in 'm'
-			assert(nullptr != itBoolPair.first->second);
-			CutpointInfo& cutpoint = *itBoolPair.first->second;
+		{	// in case there already is a record for the given root
+			CutpointInfo& cutpoint = signature[j];
 
 			cutpoint.refCount = std::min(cutpoint.refCount + signature[i].refCount,
 				static_cast<size_t>(FA_REF_CNT_TRESHOLD));
@@ -764,25 +766,48 @@ void ConnectionGraph::updateRoot(
 	assert(!this->data[root].valid);
 	assert(ta.getFinalStates().size() > 0);
 
-	StateToCutpointSignatureMap stateMap;
-
-	ConnectionGraph::computeSignatures(stateMap, ta);
+	const StateToCutpointSignatureMap& stateMap =
+		this->getStateSignatures(root, ta);
 
 	auto iter = ta.getFinalStates().begin();
 	assert(stateMap.find(*iter) != stateMap.end());
 
-	this->data[root].signature = stateMap[*iter];
+	this->data[root].signature = stateMap.find(*iter)->second;
 
 	for (++iter; iter != ta.getFinalStates().end(); ++iter)
 	{
 		assert(stateMap.find(*iter) != stateMap.end());
-		assert(this->data[root].signature == stateMap[*iter]);
+		assert(this->data[root].signature == stateMap.find(*iter)->second);
 	}
 
 	this->updateBackwardData(root);
 }
 
 
+const ConnectionGraph::StateToCutpointSignatureMap&
+ConnectionGraph::getStateSignatures(
+	size_t           root,
+	const TreeAut&   ta)
+{
+	// Assertions
+	assert(root < this->data.size());
+
+	RootInfo& info = this->data[root];
+	if (!info.stateMap || (info.taVersion != ta.version()))
+	{	// in case the signatures are not known for this version of the TA
+		std::shared_ptr<StateToCutpointSignatureMap> stateMap(
+			new StateToCutpointSignatureMap());
+
+		ConnectionGraph::computeSignatures(*stateMap, ta);
+
+		info.stateMap = stateMap;
+		info.taVersion = ta.version();
+	}
+
+	return *info.stateMap;
+}
+
+
 void ConnectionGraph::updateBackwardData(size_t root)
 {
 	// Assertions
@@ -32,6 +32,7 @@
 #include <cassert>
 
 // Forester headers
+#include "flatset.hh"
 #include "types.hh"
 #include "treeaut_label.hh"
 #include "abstractbox.hh"
@@ -53,6 +54,9 @@ private:  // data type
 
 public:
 
+	/// a (small) set of selectors
+	typedef FlatSet<size_t> SelectorSet;
+
 	struct CutpointInfo
 	{
 		/// cutpoint number
@@ -68,7 +72,7 @@ public:
 		bool refInherited;
 
 		/// a set of selectors which reach the given cutpoint
-		std::set<size_t> fwdSelectors;
+		SelectorSet fwdSelectors;
 
 		/// lowest selector of 'root' from which the state can be reached in the
 		/// opposite direction
@@ -76,7 +80,7 @@ public:
 
 		/// set of selectors of the cutpoint hidden in the subtree (includes
 		/// backwardSelector if exists)
-		std::set<size_t> defines;
+		SelectorSet defines;
 
 		CutpointInfo(size_t root = 0) :
 			root(root),
@@ -173,10 +177,18 @@ public:
 		CutpointSignature signature;
 		std::map<size_t, size_t> bwdMap;
 
+		/// the version of the tree automaton @p stateMap was computed for
+		size_t taVersion;
+
+		/// signatures of all states of the tree automaton (shared by copies)
+		std::shared_ptr<const StateToCutpointSignatureMap> stateMap;
+
 		RootInfo() :
 			valid(),
 			signature(),
-			bwdMap()
+			bwdMap(),
+			taVersion(0),
+			stateMap()
 		{ }
 
 		size_t backwardLookup(size_t selector) const
@@ -262,16 +274,25 @@ public:
 	}
 
 	static bool areDisjoint(
-		const std::set<size_t>&    s1,
-		const std::set<size_t>&    s2)
+		const SelectorSet&         s1,
+		const SelectorSet&         s2)
 	{
-		std::vector<size_t> v(s1.size());
+		auto i = s1.begin();
+		auto j = s2.begin();
+		while ((i != s1.end()) && (j != s2.end()))
+		{
+			if (*i < *j)
+				++i;
+			else if (*j < *i)
+				++j;
+			else
+				return false;
+		}
 
-		return std::set_intersection(s1.begin(), s1.end(),
-			s2.begin(), s2.end(), v.begin()) == v.begin();
+		return true;
 	}
 
-	static bool isSubset(const std::set<size_t>& s1, const std::set<size_t>& s2)
+	static bool isSubset(const SelectorSet& s1, const SelectorSet& s2)
 	{
 		return std::includes(s1.begin(), s1.end(), s2.begin(), s2.end());
 	}
@@ -421,6 +442,23 @@ public:
 		this->data.push_back(RootInfo());
 	}
 
+	/**
+	 * @brief  Retrieves signatures of all states of a root
+	 *
+	 * This method returns the signatures of all states of the tree automaton
+	 * @p ta at the index @p root.  The signatures are kept with the root and
+	 * recomputed only when the version of @p ta changes (they stay valid even
+	 * when the root itself is invalidated).
+	 *
+	 * @param[in]  root  Index of the tree automaton in the forest automaton
+	 * @param[in]  ta    The tree automaton at the index @p root
+	 *
+	 * @returns  Mapping of states of @p ta to their signatures
+	 */
+	const StateToCutpointSignatureMap& getStateSignatures(
+		size_t              root,
+		const TreeAut&      ta);
+
 	bool hasReference(size_t root, size_t target) const
 	{
 		// Assertions
@@ -0,0 +1,212 @@
+/*
+ * This file is part of forester.
+ *
+ * forester is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * forester is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with forester.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef FAE_MEMO_H
+#define FAE_MEMO_H
+
+// Standard library headers
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+// Boost headers
+#include <boost/functional/hash.hpp>
+
+// Forester headers
+#include "config.h"
+#include "forestautext.hh"
+
+/**
+ * @file faememo.hh
+ * FAEMemo - memo table of results of normalization and folding
+ */
+
+/**
+ * @brief  Memo table of results of normalization and folding of FAs
+ *
+ * The table maps a forest automaton entering a fixpoint instruction to the
+ * forest automaton obtained from it by normalization, folding (and possibly
+ * abstraction).  Forest automata are compared by their canonical form: the
+ * transitions of tree automata are hash-consed in the store shared by all
+ * backends, hence two structurally equal roots consist of the very same
+ * transitions.  The connection graph is not a part of the key as it is fully
+ * determined by the roots.
+ *
+ * Every entry is tagged by a @e version supplied by the caller, which needs to
+ * change whenever anything else the result depends on changes (e.g. the
+ * database of boxes).
+ */
+class FAEMemo
+{
+private:  // data types
+
+	/// canonical form of a forest automaton
+	struct Key
+	{
+		/// roots (addresses of transitions and final states) and the version
+		std::vector<size_t> code;
+
+		/// variables
+		DataArray vars;
+
+		bool operator==(const Key& rhs) const
+		{
+			return (code == rhs.code) && (vars == rhs.vars);
+		}
+
+		friend size_t hash_value(const Key& key)
+		{
+			size_t seed = boost::hash_range(key.code.begin(), key.code.end());
+			boost::hash_combine(seed, key.vars);
+			return seed;
+		}
+	};
+
+	struct Entry
+	{
+		/// the input (keeps the transitions referred to by the key alive)
+		std::shared_ptr<const FAE> input;
+
+		/// the result
+		std::shared_ptr<const FAE> result;
+	};
+
+	typedef std::unordered_map<Key, Entry, boost::hash<Key>> TMemo;
+
+private:  // data members
+
+	TMemo memo_;
+
+	size_t hits_;
+
+	size_t misses_;
+
+private:  // methods
+
+	static void buildKey(
+		Key&                     key,
+		const FAE&               fae,
+		size_t                   version)
+	{
+		key.code.push_back(version);
+		key.code.push_back(fae.nextState());
+		key.code.push_back(fae.getRootCount());
+		for (size_t i = 0; i < fae.getRootCount(); ++i)
+		{
+			const std::shared_ptr<TreeAut>& root = fae.getRoot(i);
+			if (!root)
+			{	// a missing root
+				key.code.push_back(static_cast<size_t>(-1));
+				continue;
+			}
+
+			key.code.push_back(root->transitions.size());
+			for (const TreeAut::TransIDPair* trans : root->transitions)
+			{	// equal transitions share the address
+				key.code.push_back(reinterpret_cast<size_t>(trans));
+			}
+
+			key.code.push_back(root->getFinalStates().size());
+			key.code.insert(key.code.end(),
+				root->getFinalStates().begin(), root->getFinalStates().end());
+		}
+
+		key.vars = fae.GetVariables();
+	}
+
+	FAEMemo(const FAEMemo&);
+	FAEMemo& operator=(const FAEMemo&);
+
+public:   // methods
+
+	FAEMemo() :
+		memo_{},
+		hits_(0),
+		misses_(0)
+	{ }
+
+	/**
+	 * @brief  Looks up the result for a forest automaton
+	 *
+	 * @param[in]  fae      The input forest automaton
+	 * @param[in]  version  The version of the data the result depends on
+	 *
+	 * @returns  The memoized result or @p nullptr if there is none
+	 */
+	std::shared_ptr<const FAE> lookup(
+		const FAE&               fae,
+		size_t                   version)
+	{
+		Key key;
+		buildKey(key, fae, version);
+
+		TMemo::const_iterator i = memo_.find(key);
+		if (memo_.end() == i)
+		{
+			++misses_;
+			return std::shared_ptr<const FAE>();
+		}
+
+		++hits_;
+		return i->second.result;
+	}
+
+	/**
+	 * @brief  Stores the result for a forest automaton
+	 *
+	 * @param[in]  input    The input forest automaton
+	 * @param[in]  version  The version of the data the result depends on
+	 * @param[in]  result   The result computed from @p input
+	 */
+	void insert(
+		const std::shared_ptr<const FAE>&    input,
+		size_t                               version,
+		const std::shared_ptr<const FAE>&    result)
+	{
+		if (0 == FA_FIXPOINT_MEMO_SIZE)
+			return;
+
+		if (memo_.size() >= FA_FIXPOINT_MEMO_SIZE)
+		{	// keep the table bounded
+			memo_.clear();
+		}
+
+		Key key;
+		buildKey(key, *input, version);
+
+		Entry& entry = memo_[key];
+		entry.input = input;
+		entry.result = result;
+	}
+
+	void clear()
+	{
+		memo_.clear();
+	}
+
+	size_t hits() const
+	{
+		return hits_;
+	}
+
+	size_t misses() const
+	{
+		return misses_;
+	}
+};
+
+#endif
@@ -21,6 +21,7 @@
 #include <ostream>
 
 // Code Listener headers
+#include <cl/phase.hh>
 #include <cl/storage.hh>
 
 // Forester headers
@@ -178,6 +179,7 @@ bool normalize(
 	const std::set<size_t>&   forbidden,
 	bool                      extended)
 {
+	PhaseTimer timer("normalize");
 	Normalization norm(fae, state);
 
 	std::vector<size_t> order;
@@ -211,6 +213,7 @@ bool fold(
 	BoxMan&                      boxMan,
 	const std::set<size_t>&      forbidden)
 {
+	PhaseTimer timer("fold");
 	std::vector<size_t> order;
 	std::vector<bool> marked;
 
@@ -476,61 +479,131 @@ void FI_abs::abstract(
 // FI_abs
 void FI_abs::execute(ExecutionManager& execMan, SymState& state)
 {
-	std::shared_ptr<FAE> fae = std::shared_ptr<FAE>(new FAE(*(state.GetFAE())));
+	PhaseTimer timer("fixpoint");
+	std::shared_ptr<FAE> fae;
 
-	fae->updateConnectionGraph();
+	// the result depends on the boxes and on the fixpoint (used for fusion),
+	// the memo table is cleared whenever the fixpoint changes
+	const size_t boxGeneration = boxMan_.boxGeneration();
+	std::shared_ptr<const FAE> memoized = memo_.lookup(
+		*state.GetFAE(), boxGeneration);
+
+	if (memoized)
+	{	// the same configuration has already been processed
+		FA_DEBUG_AT(3, "normalization memo hit");
+
+		fae = std::shared_ptr<FAE>(new FAE(*memoized));
+	} else
+	{
+		fae = std::shared_ptr<FAE>(new FAE(*(state.GetFAE())));
+		this->normalizeAndFold(state, *fae);
+		memo_.insert(state.GetFAE(), boxGeneration,
+			std::shared_ptr<const FAE>(new FAE(*fae)));
+	}
+
+	// test inclusion
+	if (testInclusion(*fae, fwdConf_, fwdConfWrapper_))
+	{
+		FA_DEBUG_AT(3, "hit");
+
+		execMan.pathFinished(&state);
+	} else
+	{
+		FA_DEBUG_AT_MSG(1, &this->insn()->loc, "extending fixpoint\n" << *fae);
+
+		// the fixpoint has changed, so have the results of fusion
+		memo_.clear();
+
+		SymState* tmpState = execMan.createChildState(state, next_);
+		tmpState->SetFAE(fae);
+
+		execMan.enqueue(tmpState);
+	}
+}
+
+void FI_abs::normalizeAndFold(
+	const SymState&      state,
+	FAE&                 fae)
+{
+	fae.updateConnectionGraph();
 
 	std::set<size_t> forbidden;
 #if FA_ALLOW_FOLDING
 	// reorder components into the canonical form (no merging!)
-	reorder(&state, *fae);
+	reorder(&state, fae);
 
 	if (!boxMan_.boxDatabase().empty())
 	{	// in the case there are some boxes, try to fold immediately before
 		// normalization
 		for (size_t i = 0; i < FIXED_REG_COUNT; ++i)
 		{
-			forbidden.insert(VirtualMachine(*fae).varGet(i).d_ref.root);
+			forbidden.insert(VirtualMachine(fae).varGet(i).d_ref.root);
 		}
 
 		// fold already discovered boxes
-		fold(*fae, boxMan_, forbidden);
+		fold(fae, boxMan_, forbidden);
 	}
 
-	learn2(*fae, boxMan_);
+	learn2(fae, boxMan_);
 #endif
-	forbidden = Normalization::computeForbiddenSet(*fae);
+	forbidden = Normalization::computeForbiddenSet(fae);
 
-	normalize(*fae, &state, forbidden, true);
+	normalize(fae, &state, forbidden, true);
 
-	abstract(*fae);
+	abstract(fae);
 #if FA_ALLOW_FOLDING
-	learn1(*fae, boxMan_);
+	learn1(fae, boxMan_);
 
 	if (boxMan_.boxDatabase().size())
 	{
-		FAE old(*fae->backend, boxMan_);
+		FAE old(*fae.backend, boxMan_);
 
 		do
 		{
-			forbidden = Normalization::computeForbiddenSet(*fae);
+			forbidden = Normalization::computeForbiddenSet(fae);
 
-			normalize(*fae, &state, forbidden, true);
+			normalize(fae, &state, forbidden, true);
 
-			abstract(*fae);
+			abstract(fae);
 
 			forbidden.clear();
 			for (size_t i = 0; i < FIXED_REG_COUNT; ++i)
 			{
-				forbidden.insert(VirtualMachine(*fae).varGet(i).d_ref.root);
+				forbidden.insert(VirtualMachine(fae).varGet(i).d_ref.root);
 			}
 
-			old = *fae;
+			old = fae;
 
-		} while (fold(*fae, boxMan_, forbidden) && !FAE::subseteq(*fae, old));
+		} while (fold(fae, boxMan_, forbidden) && !FAE::subseteq(fae, old));
 
 	}
 #endif
+}
+
+// FI_fix
+void FI_fix::execute(ExecutionManager& execMan, SymState& state)
+{
+	PhaseTimer timer("fixpoint");
+	std::shared_ptr<FAE> fae;
+
+	// the result depends only on the boxes
+	const size_t boxGeneration = boxMan_.boxGeneration();
+	std::shared_ptr<const FAE> memoized = memo_.lookup(
+		*state.GetFAE(), boxGeneration);
+
+	if (memoized)
+	{	// the same configuration has already been processed
+		FA_DEBUG_AT(3, "normalization memo hit");
+
+		fae = std::shared_ptr<FAE>(new FAE(*memoized));
+	} else
+	{
+		fae = std::shared_ptr<FAE>(new FAE(*(state.GetFAE())));
+		this->normalizeAndFold(state, *fae);
+		memo_.insert(state.GetFAE(), boxGeneration,
+			std::shared_ptr<const FAE>(new FAE(*fae)));
+	}
+
 	// test inclusion
 	if (testInclusion(*fae, fwdConf_, fwdConfWrapper_))
 	{
@@ -548,30 +621,29 @@ void FI_abs::execute(ExecutionManager& execMan, SymState& state)
 	}
 }
 
-// FI_fix
-void FI_fix::execute(ExecutionManager& execMan, SymState& state)
+void FI_fix::normalizeAndFold(
+	const SymState&      state,
+	FAE&                 fae)
 {
-	std::shared_ptr<FAE> fae = std::shared_ptr<FAE>(new FAE(*(state.GetFAE())));
-
-	fae->updateConnectionGraph();
+	fae.updateConnectionGraph();
 
 	std::set<size_t> forbidden;
 #if FA_ALLOW_FOLDING
-	reorder(&state, *fae);
+	reorder(&state, fae);
 
 	if (!boxMan_.boxDatabase().size())
 	{
 		for (size_t i = 0; i < FIXED_REG_COUNT; ++i)
 		{
-			forbidden.insert(VirtualMachine(*fae).varGet(i).d_ref.root);
+			forbidden.insert(VirtualMachine(fae).varGet(i).d_ref.root);
 		}
 
-		fold(*fae, boxMan_, forbidden);
+		fold(fae, boxMan_, forbidden);
 	}
 #endif
-	forbidden = Normalization::computeForbiddenSet(*fae);
+	forbidden = Normalization::computeForbiddenSet(fae);
 
-	normalize(*fae, &state, forbidden, true);
+	normalize(fae, &state, forbidden, true);
 #if FA_ALLOW_FOLDING
 	if (boxMan_.boxDatabase().size())
 	{
@@ -579,37 +651,22 @@ void FI_fix::execute(ExecutionManager& execMan, SymState& state)
 
 		for (size_t i = 0; i < FIXED_REG_COUNT; ++i)
 		{
-			forbidden.insert(VirtualMachine(*fae).varGet(i).d_ref.root);
+			forbidden.insert(VirtualMachine(fae).varGet(i).d_ref.root);
 		}
 
-		while (fold(*fae, boxMan_, forbidden))
+		while (fold(fae, boxMan_, forbidden))
 		{
-			forbidden = Normalization::computeForbiddenSet(*fae);
+			forbidden = Normalization::computeForbiddenSet(fae);
 
-			normalize(*fae, &state, forbidden, true);
+			normalize(fae, &state, forbidden, true);
 
 			forbidden.clear();
 
 			for (size_t i = 0; i < FIXED_REG_COUNT; ++i)
 			{
-				forbidden.insert(VirtualMachine(*fae).varGet(i).d_ref.root);
+				forbidden.insert(VirtualMachine(fae).varGet(i).d_ref.root);
 			}
 		}
 	}
 #endif
-	// test inclusion
-	if (testInclusion(*fae, fwdConf_, fwdConfWrapper_))
-	{
-		FA_DEBUG_AT(3, "hit");
-
-		execMan.pathFinished(&state);
-	} else
-	{
-		FA_DEBUG_AT_MSG(1, &this->insn()->loc, "extending fixpoint\n" << *fae);
-
-		SymState* tmpState = execMan.createChildState(state, next_);
-		tmpState->SetFAE(fae);
-
-		execMan.enqueue(tmpState);
-	}
 }
@@ -26,6 +26,7 @@
 
 // Forester headers
 #include "boxman.hh"
+#include "faememo.hh"
 #include "fixpointinstruction.hh"
 #include "forestautext.hh"
 #include "ufae.hh"
@@ -48,6 +49,9 @@ protected:
 
 	BoxMan& boxMan_;
 
+	/// results of normalization and folding of incoming forest automata
+	FAEMemo memo_;
+
 public:
 
 	virtual void extendFixpoint(const std::shared_ptr<const FAE>& fae)
@@ -60,6 +64,7 @@ public:
 		fixpoint_.clear();
 		fwdConf_.clear();
 		fwdConfWrapper_.clear();
+		memo_.clear();
 	}
 
 #if 0
@@ -95,7 +100,8 @@ public:
 		fwdConfWrapper_(fwdConf_, boxMan),
 		fixpoint_{},
 		taBackend_(taBackend),
-		boxMan_(boxMan)
+		boxMan_(boxMan),
+		memo_{}
 	{ }
 
 	virtual ~FixpointBase()
@@ -106,6 +112,11 @@ public:
 		return fwdConf_;
 	}
 
+	const FAEMemo& getMemo() const
+	{
+		return memo_;
+	}
+
 	virtual SymState* reverseAndIsect(
 		ExecutionManager&                      execMan,
 		const SymState&                        fwdPred,
@@ -138,6 +149,19 @@ private:  // methods
 	void abstract(
 		FAE&             fae);
 
+	/**
+	 * @brief  Normalizes and folds the given automaton
+	 *
+	 * This method brings the forest automaton entering the instruction into
+	 * the form in which it is added into the fixpoint.
+	 *
+	 * @param[in]      state  The symbolic state (for error reporting)
+	 * @param[in,out]  fae    The forest automaton to be processed
+	 */
+	void normalizeAndFold(
+		const SymState&  state,
+		FAE&             fae);
+
 public:   // methods
 
 	FI_abs(
@@ -160,6 +184,9 @@ public:   // methods
 	void addPredicate(const std::shared_ptr<const FAE>& predicate)
 	{
 		predicates_.push_back(predicate);
+
+		// results memoized so far were computed without the new predicate
+		memo_.clear();
 	}
 
 	/**
@@ -188,6 +215,21 @@ public:   // methods
  */
 class FI_fix : public FixpointBase
 {
+private:  // methods
+
+	/**
+	 * @brief  Normalizes and folds the given automaton
+	 *
+	 * This method brings the forest automaton entering the instruction into
+	 * the form in which it is added into the fixpoint.
+	 *
+	 * @param[in]      state  The symbolic state (for error reporting)
+	 * @param[in,out]  fae    The forest automaton to be processed
+	 */
+	void normalizeAndFold(
+		const SymState&  state,
+		FAE&             fae);
+
 public:
 
 	FI_fix(
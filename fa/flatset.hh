@@ -0,0 +1,134 @@
+/*
+ * This file is part of forester.
+ *
+ * forester is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * forester is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with forester.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef FLAT_SET_H
+#define FLAT_SET_H
+
+// Standard library headers
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+// Boost headers
+#include <boost/functional/hash.hpp>
+
+/**
+ * @file flatset.hh
+ * FlatSet - a set stored in a sorted vector
+ */
+
+/**
+ * @brief  A set stored in a sorted vector
+ *
+ * This is a replacement of @p std::set for small sets of elements that are
+ * frequently copied, compared, and iterated over but rarely modified (e.g.
+ * the sets of selectors in cutpoint signatures).  The interface is a subset of
+ * the interface of @p std::set.
+ */
+template <class T>
+class FlatSet
+{
+public:   // data types
+
+	typedef typename std::vector<T>::const_iterator const_iterator;
+	typedef const_iterator iterator;
+	typedef T value_type;
+
+private:  // data members
+
+	std::vector<T> elems_;
+
+public:   // methods
+
+	FlatSet() :
+		elems_{}
+	{ }
+
+	template <class InputIterator>
+	FlatSet(InputIterator first, InputIterator last) :
+		elems_(first, last)
+	{
+		std::sort(elems_.begin(), elems_.end());
+		elems_.erase(std::unique(elems_.begin(), elems_.end()), elems_.end());
+	}
+
+	const_iterator begin() const { return elems_.begin(); }
+	const_iterator end() const { return elems_.end(); }
+	const_iterator cbegin() const { return elems_.begin(); }
+	const_iterator cend() const { return elems_.end(); }
+
+	size_t size() const { return elems_.size(); }
+	bool empty() const { return elems_.empty(); }
+	void clear() { elems_.clear(); }
+
+	std::pair<const_iterator, bool> insert(const T& x)
+	{
+		typename std::vector<T>::iterator i =
+			std::lower_bound(elems_.begin(), elems_.end(), x);
+
+		if ((elems_.end() != i) && !(x < *i))
+			return std::make_pair(const_iterator(i), false);
+
+		return std::make_pair(const_iterator(elems_.insert(i, x)), true);
+	}
+
+	template <class InputIterator>
+	void insert(InputIterator first, InputIterator last)
+	{
+		const size_t oldSize = elems_.size();
+		elems_.insert(elems_.end(), first, last);
+		if (elems_.size() == oldSize)
+			return;
+
+		std::sort(elems_.begin() + oldSize, elems_.end());
+		std::inplace_merge(elems_.begin(), elems_.begin() + oldSize, elems_.end());
+		elems_.erase(std::unique(elems_.begin(), elems_.end()), elems_.end());
+	}
+
+	size_t count(const T& x) const
+	{
+		return std::binary_search(elems_.begin(), elems_.end(), x);
+	}
+
+	const_iterator find(const T& x) const
+	{
+		const_iterator i = std::lower_bound(elems_.begin(), elems_.end(), x);
+		return ((elems_.end() != i) && !(x < *i))?(i):(elems_.end());
+	}
+
+	bool operator==(const FlatSet& rhs) const
+	{
+		return elems_ == rhs.elems_;
+	}
+
+	bool operator!=(const FlatSet& rhs) const
+	{
+		return elems_ != rhs.elems_;
+	}
+
+	bool operator<(const FlatSet& rhs) const
+	{
+		return elems_ < rhs.elems_;
+	}
+
+	friend size_t hash_value(const FlatSet& s)
+	{
+		return boost::hash_range(s.elems_.begin(), s.elems_.end());
+	}
+};
+
+#endif
@@ -261,27 +261,6 @@ std::pair<Folding::TreeAutShPtr, Folding::TreeAutShPtr> Folding::separateCutpoin
 }
 
 
-const ConnectionGraph::StateToCutpointSignatureMap& Folding::getSignatures(
-	size_t      root)
-{
-	// Preconditions
-	assert(root < signatureMap_.size());
-
-	if (!signatureMap_[root].first)
-	{	// if the signature is not valid, recompute it
-		ConnectionGraph::computeSignatures(
-			signatureMap_[root].second, *fae_.getRoot(root)
-		);
-
-		signatureMap_[root].first = true;
-	}
-
-	assert(signatureMap_[root].first);
-
-	return signatureMap_[root].second;
-}
-
-
 bool Folding::discover1(
 	size_t                       root,
 	const std::set<size_t>&      forbidden,
@@ -733,8 +712,6 @@ const Box* Folding::makeType1Box(
 
 	fae_.connectionGraph.invalidate(root);
 
-	this->invalidateSignatures(root);
-
 	return boxPtr;
 }
 
@@ -892,13 +869,9 @@ const Box* Folding::makeType2Box(
 
 	fae_.connectionGraph.invalidate(root);
 
-	this->invalidateSignatures(root);
-
 	fae_.setRoot(aux, auxP.first);
 	fae_.connectionGraph.invalidate(aux);
 
-	this->invalidateSignatures(aux);
-
 	return boxPtr;
 }
 
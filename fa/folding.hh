@@ -48,8 +48,6 @@ private:  // data members
 	FAE& fae_;
 	BoxMan& boxMan_;
 
-	std::vector<std::pair<bool, ConnectionGraph::StateToCutpointSignatureMap>> signatureMap_;
-
 protected:
 
 	/**
@@ -106,29 +104,17 @@ protected:
 	/**
 	 * @brief  Returns valid signatures for given root
 	 *
-	 * This method returns valid signatures for given root.
+	 * This method returns valid signatures for given root (they are cached in
+	 * the connection graph of the forest automaton).
 	 *
 	 * @param[in]  root  The root the signatures of which are to be obtained
 	 *
 	 * @returns  Signatures of @p root
 	 */
 	const ConnectionGraph::StateToCutpointSignatureMap& getSignatures(
-		size_t        root);
-
-
-	/**
-	 * @brief  Invalidates the signature of given root
-	 *
-	 * Invalidates the signature of given root.
-	 *
-	 * @param[in]  root  Index of the root to be invalidated
-	 */
-	void invalidateSignatures(size_t root)
+		size_t        root)
 	{
-		// Preconditions
-		assert(root < signatureMap_.size());
-
-		signatureMap_[root].first = false;
+		return fae_.connectionGraph.getStateSignatures(root, *fae_.getRoot(root));
 	}
 
 
@@ -415,8 +401,7 @@ public:
 		FAE&           fae,
 		BoxMan&        boxMan) :
 		fae_(fae),
-		boxMan_(boxMan),
-		signatureMap_(fae.getRootCount())
+		boxMan_(boxMan)
 	{ }
 };
 
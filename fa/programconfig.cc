@@ -71,6 +71,19 @@ void ProgramConfig::processArg(const std::string& arg)
 		return;
 	}
 
+	if (std::string("db-update") == key)
+	{
+		this->dbUpdate = true;
+		FA_LOG("Config::processArg: \"db-update\" mode requested");
+		return;
+	}
+
+	if (std::string("steensgaard") == key)
+	{
+		// consumed by the points-to analysis of Code Listener
+		return;
+	}
+
 	//      ***************  binary arguments ****************
 	if (std::string("db-root") == key)
 	{
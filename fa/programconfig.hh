@@ -31,6 +31,7 @@ struct ProgramConfig
 public:   // data members
 
 	std::string dbRoot;             ///< box database root directory
+	bool        dbUpdate;           ///< saving learnt boxes into the database?
 	bool        printUcode;         ///< printing microcode?
 	bool        printOrigCode;      ///< printing the original code?
 	bool        onlyCompile;        ///< only compiling?
@@ -45,6 +46,7 @@ public:   // methods
 
 	ProgramConfig(const std::string& confStr = "") :
 		dbRoot(""),
+		dbUpdate(false),
 		printUcode(false),
 		printOrigCode(false),
 		onlyCompile(false),
@@ -36,6 +36,7 @@ void reportErrorNoLocation(const char* errMsg)
 
 
 // Standard library headers
+#include <fstream>
 #include <sstream>
 #include <vector>
 #include <list>
@@ -52,6 +53,7 @@ void reportErrorNoLocation(const char* errMsg)
 
 // Forester headers
 #include "backward_run.hh"
+#include "boxdb.hh"
 #include "executionmanager.hh"
 #include "fixpoint.hh"
 #include "fixpointinstruction.hh"
@@ -548,23 +550,35 @@ public:   // methods
 			<< *boxMan_.getTypeInfo(GLOBAL_VARS_BLOCK_STR));
 	}
 
-#if 0
-	void loadBoxes(const std::unordered_map<std::string, std::string>& db) {
+	void loadBoxes(const std::string& dbRoot)
+	{
+		const std::string fileName = dbRoot + "/" FA_BOX_DB_FILE;
+		std::ifstream input(fileName.c_str());
+		if (!input.good())
+		{
+			FA_NOTE("box database " << fileName << " not found, starting with"
+				" no boxes");
+			return;
+		}
 
 		FA_DEBUG_AT(2, "loading boxes ...");
 
-		for (auto p : db) {
+		const size_t cnt = BoxDb::load(input, fileName, boxMan_, taBackend_);
 
-			this->boxes.push_back((const Box*)boxMan_.loadBox(p.first, db));
-
-			FA_DEBUG(p.first << ':' << std::endl << *(const FA*)this->boxes.back());
+		FA_LOG("loaded " << cnt << " box(es) from " << fileName);
+	}
 
-		}
+	void saveBoxes(const std::string& dbRoot) const
+	{
+		const std::string fileName = dbRoot + "/" FA_BOX_DB_FILE;
+		std::ofstream output(fileName.c_str());
+		if (!output.good())
+			throw std::runtime_error("unable to write " + fileName);
 
-		boxMan_.buildBoxHierarchy(this->hierarchy, this->basicBoxes);
+		const size_t cnt = BoxDb::save(output, boxMan_);
 
+		FA_LOG("saved " << cnt << " box(es) into " << fileName);
 	}
-#endif
 
 	void compile(const CodeStorage::Storage& stor, const CodeStorage::Fnc& entry)
 	{
@@ -615,6 +629,20 @@ public:   // methods
 			FA_DEBUG_AT(1, "forester has generated " << execMan_.statesEvaluated()
 				<< " symbolic configuration(s) in " << execMan_.pathsEvaluated()
 				<< " path(s) using " << boxMan_.boxDatabase().size() << " box(es)");
+
+			size_t memoHits = 0, memoMisses = 0;
+			for (auto instr : assembly_.code_)
+			{	// sum up the statistics of memoized normalization
+				const FixpointBase* fix = dynamic_cast<const FixpointBase*>(instr);
+				if (nullptr == fix)
+					continue;
+
+				memoHits += fix->getMemo().hits();
+				memoMisses += fix->getMemo().misses();
+			}
+
+			FA_DEBUG_AT(1, "normalization memo: " << memoHits << " hit(s), "
+				<< memoMisses << " miss(es)");
 		}
 		catch (const ProgramError& e)
 		{ }
@@ -683,11 +711,21 @@ void SymExec::loadTypes(const CodeStorage::Storage& stor)
 	this->engine->loadTypes(stor);
 }
 
-#if 0
-void SymExec::loadBoxes(const std::unordered_map<std::string, std::string>& db) {
-	this->engine->loadBoxes(db);
+void SymExec::loadBoxes(const std::string& dbRoot)
+{
+	// Assertions
+	assert(engine != nullptr);
+
+	this->engine->loadBoxes(dbRoot);
+}
+
+void SymExec::saveBoxes(const std::string& dbRoot) const
+{
+	// Assertions
+	assert(engine != nullptr);
+
+	this->engine->saveBoxes(dbRoot);
 }
-#endif
 
 const Compiler::Assembly& SymExec::GetAssembly() const
 {
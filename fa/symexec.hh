@@ -21,7 +21,7 @@
 #define SYM_EXEC_H
 
 // Standard library headers
-#include <unordered_map>
+#include <string>
 
 // Forester headers
 #include "compiler.hh"
@@ -77,7 +77,26 @@ public:   // methods
 	 */
 	void loadTypes(const CodeStorage::Storage& stor);
 
-//	void loadBoxes(const std::unordered_map<std::string, std::string>& db);
+	/**
+	 * @brief  Loads previously learnt boxes
+	 *
+	 * Loads boxes from the box database stored in the directory @p dbRoot (if
+	 * there is any).  The types need to be loaded first by the method @p
+	 * loadTypes.
+	 *
+	 * @param[in]  dbRoot  The directory with the box database
+	 */
+	void loadBoxes(const std::string& dbRoot);
+
+	/**
+	 * @brief  Saves learnt boxes
+	 *
+	 * Saves all boxes known to the analysis into the box database stored in the
+	 * directory @p dbRoot, so that subsequent runs may load them.
+	 *
+	 * @param[in]  dbRoot  The directory with the box database
+	 */
+	void saveBoxes(const std::string& dbRoot) const;
 
 
 	/**
@@ -24,12 +24,16 @@
 #include <vector>
 #include <set>
 #include <map>
+#include <memory>
+#include <unordered_map>
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <stdexcept>
 
 // Forester headers
 #include "cache.hh"
+#include "config.h"
 #include "lts.hh"
 #include "streams.hh"
 #include "utils.hh"
@@ -247,16 +251,67 @@ public:   // data types
 		std::is_same<typename trans_cache_type::value_type, TransIDPair>::value,
 		"Incompatible types!");
 
-	// this is the place where transitions are stored
-	struct Backend
+	/**
+	 * @brief  The store of hash-consed left-hand sides and transitions
+	 *
+	 * Every transition (and every left-hand side) is kept in a store exactly
+	 * once, so equal transitions of automata sharing a store are represented by
+	 * the same pointer and copying an automaton only increments the reference
+	 * counters of its transitions.
+	 */
+	struct Store
 	{
 		typename TTBase<T>::lhs_cache_type lhsCache;
 		trans_cache_type transCache;
 
-		Backend() :
+		Store() :
 			lhsCache{},
 			transCache{}
 		{ }
+
+	private:  // methods
+
+		Store(const Store&);
+		Store& operator=(const Store&);
+	};
+
+	/**
+	 * @brief  Returns the store shared by all backends (of the current thread)
+	 *
+	 * The process-wide store is intentionally never destroyed so that automata
+	 * with static storage duration may safely outlive it.
+	 */
+	static Store& sharedStore()
+	{
+#if FA_TA_STORE_THREAD_LOCAL
+		static thread_local Store store;
+		return store;
+#else
+		static Store* store = new Store;
+		return *store;
+#endif
+	}
+
+	/**
+	 * @brief  A handle to the place where transitions are stored
+	 *
+	 * By default, all backends refer to the shared store, hence temporary
+	 * backends (e.g. in minimization or in the inclusion check) do not need to
+	 * intern the transitions they work with once again.
+	 */
+	struct Backend
+	{
+		typename TTBase<T>::lhs_cache_type& lhsCache;
+		trans_cache_type& transCache;
+
+		Backend() :
+			Backend(TA<T>::sharedStore())
+		{ }
+
+		explicit Backend(Store& store) :
+			lhsCache(store.lhsCache),
+			transCache(store.transCache)
+		{ }
 	};
 
 	struct CmpF
@@ -369,6 +424,236 @@ public:   // data types
 
 	typedef std::unordered_map<T, std::vector<const Transition*>> lt_cache_type;
 
+	/**
+	 * @brief  Compact indexes of transitions of an automaton
+	 *
+	 * The table keeps the transitions of an automaton (in the order of the
+	 * automaton, i.e. sorted by their parent states) in a struct-of-arrays
+	 * layout where states and labels are numbered densely.  Transitions are
+	 * referred to by their position in the table.  Besides the flattened
+	 * left-hand sides, the table contains CSR-style indexes of transitions by
+	 * their parent state, by their label, and by the states occurring in their
+	 * left-hand side (every transition is listed once for every distinct state).
+	 *
+	 * A table is built on the first request by TA<T>::getTable() and kept (and
+	 * shared with copies of the automaton) until the automaton changes.
+	 */
+	class Table
+	{
+	public:   // data types
+
+		/// a range of positions (or of dense state identifiers)
+		struct Range
+		{
+			const size_t* first;
+			const size_t* last;
+
+			const size_t* begin() const { return first; }
+			const size_t* end() const { return last; }
+			size_t size() const { return last - first; }
+			bool empty() const { return first == last; }
+		};
+
+		/// the value denoting a state or label not present in the table
+		static const size_t npos = static_cast<size_t>(-1);
+
+	private:  // data members
+
+		/// the transitions
+		std::vector<const TransIDPair*> trans_;
+		/// dense parent states of the transitions
+		std::vector<size_t> rhs_;
+		/// dense labels of the transitions
+		std::vector<size_t> label_;
+		/// offsets of the left-hand sides of the transitions in @p lhs_
+		std::vector<size_t> lhsOffset_;
+		/// flattened dense left-hand sides of the transitions
+		std::vector<size_t> lhs_;
+
+		/// dense identifier -> state
+		std::vector<size_t> states_;
+		/// state -> dense identifier
+		std::unordered_map<size_t, size_t> stateIds_;
+		/// dense identifier -> label
+		std::vector<T> labels_;
+		/// label -> dense identifier
+		std::unordered_map<T, size_t> labelIds_;
+
+		/// transitions by the parent state
+		std::vector<size_t> byRhsOffset_, byRhs_;
+		/// transitions by the label
+		std::vector<size_t> byLabelOffset_, byLabel_;
+		/// transitions by the states of the left-hand side
+		std::vector<size_t> byLhsOffset_, byLhs_;
+
+	private:  // methods
+
+		Table(const Table&);
+		Table& operator=(const Table&);
+
+		size_t addState(size_t state)
+		{
+			std::pair<std::unordered_map<size_t, size_t>::iterator, bool> p =
+				stateIds_.insert(std::make_pair(state, states_.size()));
+			if (p.second)
+				states_.push_back(state);
+
+			return p.first->second;
+		}
+
+		size_t addLabel(const T& label)
+		{
+			std::pair<typename std::unordered_map<T, size_t>::iterator, bool> p =
+				labelIds_.insert(std::make_pair(label, labels_.size()));
+			if (p.second)
+				labels_.push_back(label);
+
+			return p.first->second;
+		}
+
+		/**
+		 * @brief  Builds a CSR index using counting sort
+		 *
+		 * Entry @p i maps the key @p keys[i] to the position @p pos[i] (or to
+		 * @p i if @p pos is empty); the order of positions of a key is kept.
+		 */
+		static void buildIndex(
+			size_t                             keyCount,
+			const std::vector<size_t>&         keys,
+			const std::vector<size_t>&         pos,
+			std::vector<size_t>&               offset,
+			std::vector<size_t>&               index)
+		{
+			offset.assign(keyCount + 1, 0);
+			for (size_t key : keys)
+				++offset[key + 1];
+
+			for (size_t i = 1; i <= keyCount; ++i)
+				offset[i] += offset[i - 1];
+
+			std::vector<size_t> next(offset.begin(), offset.end() - 1);
+			index.resize(keys.size());
+			for (size_t i = 0; i < keys.size(); ++i)
+				index[next[keys[i]]++] = (pos.empty())?(i):(pos[i]);
+		}
+
+		static Range range(
+			const std::vector<size_t>&         offset,
+			const std::vector<size_t>&         index,
+			size_t                             key)
+		{
+			const size_t* base = index.data();
+			Range r = { base + offset[key], base + offset[key + 1] };
+			return r;
+		}
+
+	public:   // methods
+
+		explicit Table(const TA<T>& ta) :
+			trans_(ta.transitions.begin(), ta.transitions.end()),
+			rhs_{},
+			label_{},
+			lhsOffset_{},
+			lhs_{},
+			states_{},
+			stateIds_{},
+			labels_{},
+			labelIds_{},
+			byRhsOffset_{},
+			byRhs_{},
+			byLabelOffset_{},
+			byLabel_{},
+			byLhsOffset_{},
+			byLhs_{}
+		{
+			rhs_.reserve(trans_.size());
+			label_.reserve(trans_.size());
+			lhsOffset_.reserve(trans_.size() + 1);
+			lhsOffset_.push_back(0);
+
+			std::vector<size_t> lhsKeys, lhsPos;
+			for (size_t i = 0; i < trans_.size(); ++i)
+			{
+				const Transition& t = trans_[i]->first;
+				rhs_.push_back(this->addState(t.rhs()));
+				label_.push_back(this->addLabel(t.label()));
+				for (size_t state : t.lhs())
+				{
+					const size_t id = this->addState(state);
+					if (std::find(lhs_.begin() + lhsOffset_.back(), lhs_.end(), id) == lhs_.end())
+					{	// list the transition only once for every state
+						lhsKeys.push_back(id);
+						lhsPos.push_back(i);
+					}
+
+					lhs_.push_back(id);
+				}
+
+				lhsOffset_.push_back(lhs_.size());
+			}
+
+			buildIndex(states_.size(), rhs_, std::vector<size_t>(), byRhsOffset_, byRhs_);
+			buildIndex(labels_.size(), label_, std::vector<size_t>(), byLabelOffset_, byLabel_);
+			buildIndex(states_.size(), lhsKeys, lhsPos, byLhsOffset_, byLhs_);
+		}
+
+		/// the number of transitions
+		size_t size() const { return trans_.size(); }
+
+		/// the number of (distinct) states occurring in the transitions
+		size_t stateCount() const { return states_.size(); }
+
+		/// the number of (distinct) labels occurring in the transitions
+		size_t labelCount() const { return labels_.size(); }
+
+		const TransIDPair* transIDPair(size_t i) const { return trans_[i]; }
+
+		const Transition& transition(size_t i) const { return trans_[i]->first; }
+
+		/// the dense parent state of the @p i-th transition
+		size_t rhs(size_t i) const { return rhs_[i]; }
+
+		/// the dense label of the @p i-th transition
+		size_t label(size_t i) const { return label_[i]; }
+
+		/// the dense left-hand side of the @p i-th transition
+		Range lhs(size_t i) const
+		{
+			const size_t* base = lhs_.data();
+			Range r = { base + lhsOffset_[i], base + lhsOffset_[i + 1] };
+			return r;
+		}
+
+		/// the state with the dense identifier @p id
+		size_t state(size_t id) const { return states_[id]; }
+
+		/// the label with the dense identifier @p id
+		const T& labelValue(size_t id) const { return labels_[id]; }
+
+		/// the dense identifier of @p state (or @p npos)
+		size_t findState(size_t state) const
+		{
+			std::unordered_map<size_t, size_t>::const_iterator i = stateIds_.find(state);
+			return (i == stateIds_.end())?(npos):(i->second);
+		}
+
+		/// the dense identifier of @p label (or @p npos)
+		size_t findLabel(const T& label) const
+		{
+			typename std::unordered_map<T, size_t>::const_iterator i = labelIds_.find(label);
+			return (i == labelIds_.end())?(npos):(i->second);
+		}
+
+		/// positions of transitions with the parent state @p id
+		Range byRhs(size_t id) const { return range(byRhsOffset_, byRhs_, id); }
+
+		/// positions of transitions with the label @p id
+		Range byLabel(size_t id) const { return range(byLabelOffset_, byLabel_, id); }
+
+		/// positions of transitions with the state @p id in their left-hand side
+		Range byLhs(size_t id) const { return range(byLhsOffset_, byLhs_, id); }
+	};
+
 	typedef Iterator iterator;
 	typedef TDIterator td_iterator;
 
@@ -377,6 +662,12 @@ private:  // data members
 	size_t nextState_;
 	std::set<size_t> finalStates_;
 
+	/// compact indexes of the transitions (built on demand)
+	mutable std::shared_ptr<const Table> table_;
+
+	/// the version of the content of the automaton (0 if not assigned yet)
+	mutable size_t version_;
+
 public:   // data members
 
 	Backend* backend;
@@ -391,6 +682,8 @@ public:
 		Backend&             backend) :
 		nextState_(0),
 		finalStates_{},
+		table_{},
+		version_(0),
 		backend(&backend),
 		maxRank(0),
 		transitions{}
@@ -401,6 +694,8 @@ public:
 		bool                 copyFinalStates = true) :
 		nextState_(ta.nextState_),
 		finalStates_{},
+		table_(ta.table_),
+		version_((copyFinalStates)?(ta.version_):(0)),
 		backend(ta.backend),
 		maxRank(ta.maxRank),
 		transitions(ta.transitions)
@@ -423,6 +718,8 @@ public:
 		bool                 copyFinalStates = true) :
 		nextState_(ta.nextState_),
 		finalStates_(),
+		table_{},
+		version_(0),
 		backend(ta.backend),
 		maxRank(ta.maxRank),
 		transitions()
@@ -456,6 +753,8 @@ public:
 		TransIDPair* x = this->transCache().lookup(t);
 		if (this->transitions.insert(x).second)
 		{
+			table_.reset();
+			version_ = 0;
 			if (t.lhs().size() > this->maxRank)
 				this->maxRank = t.lhs().size();
 		} else
@@ -547,6 +846,8 @@ public:
 		this->backend = rhs.backend;
 		this->transitions = rhs.transitions;
 		finalStates_ = rhs.finalStates_;
+		table_ = rhs.table_;
+		version_ = rhs.version_;
 
 		for (TransIDPair* trans : this->transitions)
 		{	// copy transitions
@@ -566,6 +867,44 @@ public:
 		}
 		this->transitions.clear();
 		finalStates_.clear();
+		table_.reset();
+		version_ = 0;
+	}
+
+	/**
+	 * @brief  Returns the version of the content of the automaton
+	 *
+	 * The version is a process-wide unique number identifying the current
+	 * transitions and final states of the automaton: it changes whenever the
+	 * automaton is modified and it is shared by its (unmodified) copies, so it
+	 * can be used to validate data computed from the automaton.
+	 *
+	 * @returns  The version of the automaton
+	 */
+	size_t version() const
+	{
+		static std::atomic<size_t> lastVersion(0);
+
+		if (!version_)
+			version_ = ++lastVersion;
+
+		return version_;
+	}
+
+	/**
+	 * @brief  Returns compact indexes of the transitions of the automaton
+	 *
+	 * The table is built on the first call and reused until the set of
+	 * transitions of the automaton changes.
+	 *
+	 * @returns  The table of transitions of the automaton
+	 */
+	const Table& getTable() const
+	{
+		if (!table_)
+			table_ = std::shared_ptr<const Table>(new Table(*this));
+
+		return *table_;
 	}
 
 	size_t newState()
@@ -712,6 +1051,21 @@ public:
 	const TransIDPair* addTransition(
 		const TransIDPair*       transition)
 	{
+		if (&transition->first.lhsCache == &this->lhsCache())
+		{	// the transition is already interned in our store
+			TransIDPair* x = const_cast<TransIDPair*>(transition);
+			if (this->transitions.insert(x).second)
+			{
+				table_.reset();
+				version_ = 0;
+				this->transCache().addRef(x);
+				if (x->first.lhs().size() > this->maxRank)
+					this->maxRank = x->first.lhs().size();
+			}
+
+			return x;
+		}
+
 		return this->internalAdd(Transition(transition->first, this->lhsCache()));
 	}
 
@@ -724,6 +1078,9 @@ public:
 
 	const TransIDPair* addTransition(const Transition& transition)
 	{
+		if (&transition.lhsCache == &this->lhsCache())
+			return this->internalAdd(transition);
+
 		return this->internalAdd(Transition(transition, this->lhsCache()));
 	}
 
@@ -736,26 +1093,31 @@ public:
 
 	void addFinalState(size_t state)
 	{
+		version_ = 0;
 		finalStates_.insert(state);
 	}
 
 	void addFinalStates(const std::vector<size_t>& states)
 	{
+		version_ = 0;
 		finalStates_.insert(states.begin(), states.end());
 	}
 
 	void addFinalStates(const std::set<size_t>& states)
 	{
+		version_ = 0;
 		finalStates_.insert(states.begin(), states.end());
 	}
 
 	void removeFinalState(size_t state)
 	{
+		version_ = 0;
 		finalStates_.erase(state);
 	}
 
 	void clearFinalStates()
 	{
+		version_ = 0;
 		finalStates_.clear();
 	}
 
@@ -903,6 +1265,89 @@ public:
 		return product.size();
 	}
 
+	/**
+	 * @brief  Bottom-up product of two automata
+	 *
+	 * This is a variant of the above function working on the tables of
+	 * transitions of the automata.  For every pair of matching transitions
+	 * (i.e. with the same label and pairwise reachable children), the functor
+	 * @p f is called with the transitions, the left-hand side in the product,
+	 * and the parent state in the product.
+	 *
+	 * @returns  The number of states of the product
+	 */
+	template <class F>
+	static size_t buProduct(
+		const Table&                              table1,
+		const Table&                              table2,
+		F                                         f,
+		size_t                                    stateOffset = 0)
+	{
+		typedef std::unordered_map<std::pair<size_t, size_t>, size_t,
+			boost::hash<std::pair<size_t, size_t>>> product_type;
+
+		// pairs of matching labels
+		std::vector<std::pair<size_t, size_t>> labels;
+		for (size_t i = 0; i < table1.labelCount(); ++i)
+		{
+			const size_t j = table2.findLabel(table1.labelValue(i));
+			if (Table::npos != j)
+				labels.push_back(std::make_pair(i, j));
+		}
+
+		product_type product;
+		std::vector<size_t> lhs;
+		bool changed = true;
+		bool leaves = true;
+		while (changed)
+		{
+			changed = false;
+			for (const std::pair<size_t, size_t>& label : labels)
+			{
+				for (size_t k : table1.byLabel(label.first))
+				{
+					const typename Table::Range lhs1 = table1.lhs(k);
+					if (leaves != lhs1.empty())
+						continue;
+
+					for (size_t l : table2.byLabel(label.second))
+					{
+						const typename Table::Range lhs2 = table2.lhs(l);
+						assert(lhs1.size() == lhs2.size());
+						lhs.clear();
+						for (size_t m = 0; m < lhs1.size(); ++m)
+						{
+							typename product_type::const_iterator n = product.find(
+								std::make_pair(lhs1.first[m], lhs2.first[m]));
+							if (n == product.end())
+								break;
+
+							lhs.push_back(n->second);
+						}
+
+						if (lhs.size() < lhs1.size())
+							continue;
+
+						std::pair<typename product_type::iterator, bool> p = product.insert(
+							std::make_pair(std::make_pair(table1.rhs(k), table2.rhs(l)),
+							product.size() + stateOffset));
+						f(&table1.transition(k), &table2.transition(l), lhs, p.first->second);
+						if (p.second && !leaves)
+							changed = true;
+					}
+				}
+			}
+
+			if (leaves)
+			{	// leaf transitions are processed only once
+				leaves = false;
+				changed = true;
+			}
+		}
+
+		return product.size();
+	}
+
 	struct IntersectF
 	{
 		TA<T>& dst;
@@ -936,10 +1381,8 @@ public:
 		const TA<T>&                     src2,
 		size_t                           stateOffset = 0)
 	{
-		lt_cache_type cache1, cache2;
-		src1.buildLTCache(cache1);
-		src2.buildLTCache(cache2);
-		return TA<T>::buProduct(cache1, cache2, TA<T>::IntersectF(dst, src1, src2), stateOffset);
+		return TA<T>::buProduct(src1.getTable(), src2.getTable(),
+			TA<T>::IntersectF(dst, src1, src2), stateOffset);
 	}
 
 	struct PredicateF
@@ -969,10 +1412,8 @@ public:
 		std::vector<size_t>&                 dst,
 		const TA<T>&                         predicate) const
 	{
-		lt_cache_type cache1, cache2;
-		this->buildLTCache(cache1);
-		predicate.buildLTCache(cache2);
-		TA<T>::buProduct(cache1, cache2, TA<T>::PredicateF(dst, predicate));
+		TA<T>::buProduct(this->getTable(), predicate.getTable(),
+			TA<T>::PredicateF(dst, predicate));
 	}
 
 
@@ -1145,40 +1586,48 @@ public:
 
 	TA<T>& uselessFree(TA<T>& dst) const
 	{
-		std::vector<const TransIDPair*> v1(this->transitions.begin(), this->transitions.end()), v2;
-		std::set<size_t> states;
-		bool changed = true;
-		while (changed)
+		const Table& table = this->getTable();
+
+		// the number of distinct states of the left-hand side not known to be
+		// useful yet (for every transition)
+		std::vector<size_t> pending(table.size());
+		std::vector<size_t> queue;
+		for (size_t i = 0; i < table.size(); ++i)
 		{
-			changed = false;
-			for (const TransIDPair* trans : v1)
+			const typename Table::Range lhs = table.lhs(i);
+			for (const size_t* j = lhs.begin(); j != lhs.end(); ++j)
 			{
-				bool matches = true;
-				for (const size_t state : trans->first.lhs())
-				{
-					if (!states.count(state))
-					{
-						matches = false;
-						break;
-					}
-				}
-				if (matches)
-				{
-					if (states.insert(trans->first.rhs()).second)
-						changed = true;
-					dst.addTransition(trans);
-				} else
-				{
-					v2.push_back(trans);
-				}
+				if (std::find(lhs.begin(), j, *j) == j)
+					++pending[i];
+			}
+
+			if (!pending[i])
+				queue.push_back(i);
+		}
+
+		std::vector<bool> useful(table.stateCount(), false);
+		while (!queue.empty())
+		{
+			const size_t i = queue.back();
+			queue.pop_back();
+			dst.addTransition(table.transIDPair(i));
+
+			const size_t state = table.rhs(i);
+			if (useful[state])
+				continue;
+
+			useful[state] = true;
+			for (size_t j : table.byLhs(state))
+			{
+				if (!--pending[j])
+					queue.push_back(j);
 			}
-			v1.clear();
-			std::swap(v1, v2);
 		}
 
 		for (const size_t& state : finalStates_)
 		{
-			if (states.count(state))
+			const size_t id = table.findState(state);
+			if ((Table::npos != id) && useful[id])
 				dst.addFinalState(state);
 		}
 
@@ -1187,37 +1636,39 @@ public:
 
 	TA<T>& unreachableFree(TA<T>& dst) const
 	{
-		std::vector<const TransIDPair*> v1(
-			transitions.begin(), this->transitions.end()), v2;
-		std::set<size_t> states(finalStates_.begin(), finalStates_.end());
+		const Table& table = this->getTable();
+
+		std::vector<bool> reachable(table.stateCount(), false);
+		std::vector<size_t> queue;
 		for (size_t finState : finalStates_)
 		{
 			dst.addFinalState(finState);
+			const size_t id = table.findState(finState);
+			if ((Table::npos != id) && !reachable[id])
+			{
+				reachable[id] = true;
+				queue.push_back(id);
+			}
 		}
 
-		bool changed = true;
-		while (changed)
+		while (!queue.empty())
 		{
-			changed = false;
-			for (const TransIDPair* trans : v1)
+			const size_t state = queue.back();
+			queue.pop_back();
+			for (size_t i : table.byRhs(state))
 			{
-				if (states.count(trans->first.rhs()))
+				dst.addTransition(table.transIDPair(i));
+				for (size_t child : table.lhs(i))
 				{
-					dst.addTransition(trans);
-					for (size_t state : trans->first.lhs())
+					if (!reachable[child])
 					{
-						if (states.insert(state).second)
-						{
-							changed = true;
-						}
+						reachable[child] = true;
+						queue.push_back(child);
 					}
-				} else {
-					v2.push_back(trans);
 				}
 			}
-			v1.clear();
-			std::swap(v1, v2);
 		}
+
 		return dst;
 	}
 
@@ -1291,35 +1742,36 @@ public:
 		const std::vector<std::vector<bool>>&     cons,
 		const Index<size_t>&                      stateIndex) const
 	{
-		td_cache_type cache = this->buildTDCache();
+		const Table& table = this->getTable();
 
 		for (size_t state : finalStates_)
 			dst.addFinalState(state);
 
-		for (typename td_cache_type::iterator i = cache.begin(); i != cache.end(); ++i)
+		std::list<size_t> tmp;
+		for (size_t state = 0; state < table.stateCount(); ++state)
 		{
-			std::list<const Transition*> tmp;
-			for (typename std::vector<const Transition*>::iterator j = i->second.begin(); j != i->second.end(); ++j)
+			tmp.clear();
+			for (size_t j : table.byRhs(state))
 			{
 				bool noskip = true;
-				for (typename std::list<const Transition*>::iterator k = tmp.begin(); k != tmp.end(); )
+				for (typename std::list<size_t>::iterator k = tmp.begin(); k != tmp.end(); )
 				{
-					if ((*j)->llhsLessThan(**k, cons, stateIndex))
+					if (table.transition(j).llhsLessThan(table.transition(*k), cons, stateIndex))
 					{
 						noskip = false;
 						break;
 					}
-					if ((*k)->llhsLessThan(**j, cons, stateIndex))
+					if (table.transition(*k).llhsLessThan(table.transition(j), cons, stateIndex))
 					{
-						typename std::list<const Transition*>::iterator l = k++;
+						typename std::list<size_t>::iterator l = k++;
 						tmp.erase(l);
 					} else ++k;
 				}
 				if (noskip)
-					tmp.push_back(*j);
+					tmp.push_back(j);
 			}
-			for (typename std::list<const Transition*>::iterator j = tmp.begin(); j != tmp.end(); ++j)
-				dst.addTransition(**j);
+			for (size_t j : tmp)
+				dst.addTransition(table.transIDPair(j));
 		}
 		return dst;
 	}
@@ -1705,7 +2157,7 @@ public:
 		TA<T>* clone(TA<T>* src, bool copyFinalStates = true)
 		{
 			assert(src);
-			assert(src->backend == &this->backend);
+			assert(&src->transCache() == &this->backend.transCache);
 			return this->taCache.lookup(new TA<T>(*src, copyFinalStates))->first;
 		}
 
@@ -24,10 +24,13 @@
 #include <cl/clutil.hh>
 #include <cl/storage.hh>
 
+#include <algorithm>
 #include <map>
-#include <queue>
 #include <set>
+#include <stack>
+#include <vector>
 
+#include <boost/dynamic_bitset.hpp>
 #include <boost/foreach.hpp>
 
 // required by the gcc plug-in API
@@ -60,12 +63,14 @@ typedef const CodeStorage::TOperandList                 TOperandList;
 typedef const CodeStorage::TTargetList                  TTargetList;
 typedef const CodeStorage::Block                       *TBlock;
 typedef const CodeStorage::Insn                        *TInsn;
+typedef boost::dynamic_bitset<>                         TBitSet;
 
 /// state of variable (scope of its validity is basic block)
 struct VarState {
     EVarState           code;   ///< current state (valid per current block)
     TLoc                loc;    ///< location where the state became valid
-    TVar                peer;   ///< used only for VS_NULL_IFF, VS_NOT_NULL_IFF
+    TVar                peer;   ///< index of the variable compared with NULL,
+                                ///< used only for VS_NULL_IFF, VS_NOT_NULL_IFF
 
     VarState():
         code(VS_UNDEF),
@@ -75,26 +80,75 @@ struct VarState {
     }
 };
 
-typedef std::map<TVar, VarState>                        TState;
+/// states of all variables of a function (indexed as given by Data::varIdx)
+typedef std::vector<VarState>                           TState;
+
+/// number of codes that can be propagated from one basic block to another
+const unsigned CNT_BLOCK_CODES = VS_TRUE;
+
+/**
+ * states of all variables at the entry of a basic block
+ *
+ * Each of the codes VS_UNKNOWN .. VS_TRUE has its own bit-plane indexed by
+ * variables.  A variable has more codes set if it comes with different states
+ * from different predecessors, so that states are merged by OR-ing the planes
+ * word by word.  See codeBySet() for how the codes are combined back.
+ */
+struct BlockState {
+    TBitSet             planes[CNT_BLOCK_CODES];
+    std::vector<TLoc>   locs;   ///< where the first incoming state became valid
+};
+
+/**
+ * uid of variable -> its index in TState of the function being analyzed
+ *
+ * The table is allocated once for all variables of the program and shared by
+ * all functions.  Each function overwrites the entries of the variables it
+ * uses, so the stale entries of other functions are never read.
+ */
+struct VarIdxTable {
+    TVar                    uidBase;    ///< the lowest uid of a variable
+    std::vector<unsigned>   idxByUid;   ///< indexed by uid minus uidBase
+
+    VarIdxTable():
+        uidBase(0)
+    {
+    }
+};
 
 /// state of computation at function level
 struct Data {
-    typedef std::queue<TBlock>                          TSched;
-    typedef std::set<TBlock>                            TSchedLookup;
-    typedef std::map<TBlock, TState>                    TStateMap;
+    typedef std::set<unsigned>                          TSched;
+    typedef std::map<TBlock, unsigned>                  TBlockIdx;
+
+    TSched          todo;       ///< indexes of blocks scheduled for processing
+    VarIdxTable     &varIdx;    ///< uid of variable -> its index in TState
+    TBlockIdx       blockIdx;   ///< block -> its index in blockList
 
-    TSched          todo;       ///< block scheduled for processing
-    TSchedLookup    todoLookup; ///< block scheduled for processing
-    TStateMap       stateMap;   ///< holds states of all vars per each block
+    /// basic blocks of the function numbered in reverse post-order
+    std::vector<TBlock>         blockList;
+
+    std::vector<BlockState>     entryStates;///< states of vars per block entry
+    BlockState      exitState;  ///< states of vars leaving the current block
     TState          localState; ///< holds intermediate state between insns
     bool            silent;     ///< if true, do not print diagnostic messages
 
-    Data():
+    Data(VarIdxTable &varIdx_):
+        varIdx(varIdx_),
         silent(true)
     {
     }
 };
 
+/// return index of the variable given by the operand (as used in TState)
+inline unsigned varIndex(const Data &data, TOperand *op)
+{
+    const VarIdxTable &vt = data.varIdx;
+    const unsigned pos = varIdFromOperand(op) - vt.uidBase;
+    CL_BREAK_IF(vt.idxByUid.size() <= pos);
+    return vt.idxByUid[pos];
+}
+
 /**
  * @param data state of computation per current function
  * @param op either source or destination operand that contains a dereference
@@ -105,8 +159,7 @@ void handleVarDeref(
         TOperand                   *op,
         const TLoc                  loc)
 {
-    const TVar uid = varIdFromOperand(op);
-    VarState &vs = data.localState[uid];
+    VarState &vs = data.localState[varIndex(data, op)];
     const EVarState code = vs.code;
     switch (code) {
         case VS_UNDEF:
@@ -237,8 +290,7 @@ void handleInsnUnop(Data &data, const TInsn insn)
         return;
 
     // resolve state of the variable
-    const TVar uid = varIdFromOperand(&dst);
-    VarState &vs = data.localState[uid];
+    VarState &vs = data.localState[varIndex(data, &dst)];
 
     const enum cl_unop_e code = static_cast<enum cl_unop_e>(insn->subCode);
     if (CL_UNOP_ASSIGN != code) {
@@ -277,8 +329,7 @@ void handleInsnUnop(Data &data, const TInsn insn)
     }
 
     // single assignment ... let's just propagate the value
-    const TVar uidSrc = varIdFromOperand(&src);
-    mergeValues(vs, data.localState[uidSrc]);
+    mergeValues(vs, data.localState[varIndex(data, &src)]);
 }
 
 /**
@@ -304,8 +355,8 @@ bool handleInsnCmpNull(
         // we're interested only in pointers comparison here
         return false;
 
-    const TVar uidSrc = varIdFromOperand(src);
-    const VarState &vsSrc = data.localState[uidSrc];
+    const TVar idxSrc = varIndex(data, src);
+    const VarState &vsSrc = data.localState[idxSrc];
     const EVarState code = vsSrc.code;
     switch (code) {
         case VS_NULL:
@@ -338,7 +389,7 @@ bool handleInsnCmpNull(
         ? VS_NOT_NULL_IFF
         : VS_NULL_IFF;
 
-    vsDst.peer = uidSrc;
+    vsDst.peer = idxSrc;
     vsDst.loc  = loc;
     return true;
 
@@ -373,8 +424,7 @@ void handleInsnBinop(Data &data, const TInsn insn)
     // resolve operands
     TOperand &dst = opList[0];
     CL_BREAK_IF(dst.accessor);
-    const TVar uidDst = varIdFromOperand(&dst);
-    VarState &vs = data.localState[uidDst];
+    VarState &vs = data.localState[varIndex(data, &dst)];
 
     TOperand &src1 = opList[1];
     TOperand &src2 = opList[2];
@@ -435,18 +485,17 @@ void handleInsnCall(Data &data, const TInsn insn)
         return;
 
     // abstract out the return value
-    const TVar uid = varIdFromOperand(&dst);
-    VarState &vs = data.localState[uid];
+    VarState &vs = data.localState[varIndex(data, &dst)];
     vs.code = VS_UNKNOWN;
 }
 
 /**
  * abstract out any reasoning in case of direct reference of an operand
- * @param state state valid per current instruction
+ * @param data state of computation per current function
  * @param opList list of operands to check for direct references
  */
 void treatRefAsSideEffect(
-        TState                     &state,
+        Data                       &data,
         TOperandList               &opList)
 {
     // for each operand
@@ -461,8 +510,7 @@ void treatRefAsSideEffect(
             continue;
 
         // kill any up to now reasoning about the variable
-        const TVar uid = varIdFromOperand(&op);
-        state[uid].code = VS_UNKNOWN;
+        data.localState[varIndex(data, &op)].code = VS_UNKNOWN;
     }
 }
 
@@ -473,7 +521,7 @@ void treatRefAsSideEffect(
  */
 void handleInsnNonterm(Data &data, const TInsn insn)
 {
-    treatRefAsSideEffect(data.localState, insn->operands);
+    treatRefAsSideEffect(data, insn->operands);
 
     const enum cl_insn_e code = insn->code;
     switch (code) {
@@ -498,6 +546,143 @@ void handleInsnNonterm(Data &data, const TInsn insn)
     }
 }
 
+/// position of the given code in the set of codes of a variable
+inline unsigned codeBit(const EVarState code)
+{
+    return 1U << (code - VS_UNKNOWN);
+}
+
+/**
+ * combine the set of codes a variable comes with to a basic block into a single
+ * code the same way as mergeValues() does for a pair of states
+ * @param set set of codes with positions given by codeBit()
+ */
+EVarState codeBySet(const unsigned set)
+{
+    CL_BREAK_IF(!set);
+    if (!(set & (set - 1))) {
+        // only one code has been propagated
+        unsigned pos = 0U;
+        while (!(set & (1U << pos)))
+            ++pos;
+
+        return static_cast<EVarState>(VS_UNKNOWN + pos);
+    }
+
+    const unsigned notNull = codeBit(VS_NOT_NULL) | codeBit(VS_NOT_NULL_DEDUCED);
+    const unsigned mightBeNull = notNull
+        | codeBit(VS_NULL_DEDUCED)
+        | codeBit(VS_MIGHT_BE_NULL);
+
+    if (set & ~mightBeNull)
+        // let's over-approximate everything else
+        return VS_UNKNOWN;
+
+    if ((set & codeBit(VS_MIGHT_BE_NULL))
+            || ((set & codeBit(VS_NULL_DEDUCED)) && (set & notNull)))
+        // merge NULL and not-NULL alternatives together
+        return VS_MIGHT_BE_NULL;
+
+    // VS_NOT_NULL and VS_NOT_NULL_DEDUCED
+    return VS_UNKNOWN;
+}
+
+/// allocate the bit-planes of a block state for the given count of variables
+void initBlockState(BlockState &bs, const unsigned cntVars)
+{
+    for (unsigned i = 0; i < CNT_BLOCK_CODES; ++i)
+        bs.planes[i].resize(cntVars);
+
+    bs.locs.resize(cntVars);
+}
+
+/**
+ * convert state of variables at the end of a basic block to bit-planes
+ * @param dst destination block state (already initialized by initBlockState())
+ * @param state state valid per current instruction
+ */
+void encodeState(BlockState &dst, const TState &state)
+{
+    for (unsigned i = 0; i < CNT_BLOCK_CODES; ++i)
+        dst.planes[i].reset();
+
+    const unsigned cntVars = state.size();
+    for (unsigned idx = 0; idx < cntVars; ++idx) {
+        const VarState &vs = state[idx];
+        switch (vs.code) {
+            case VS_UNDEF:
+            case VS_NULL_IFF:
+            case VS_NOT_NULL_IFF:
+                // we use these only block-locally
+                continue;
+
+            default:
+                break;
+        }
+
+        dst.planes[vs.code - VS_UNKNOWN].set(idx);
+        dst.locs[idx] = vs.loc;
+    }
+}
+
+/**
+ * convert state of variables at the entry of a basic block from bit-planes
+ * @param state destination state (with one item per each variable)
+ * @param src state of variables at the entry of the block
+ */
+void decodeState(TState &state, const BlockState &src)
+{
+    state.assign(state.size(), VarState());
+
+    TBitSet defined = src.planes[0];
+    for (unsigned i = 1; i < CNT_BLOCK_CODES; ++i)
+        defined |= src.planes[i];
+
+    for (TBitSet::size_type idx = defined.find_first(); TBitSet::npos != idx;
+            idx = defined.find_next(idx))
+    {
+        unsigned set = 0U;
+        for (unsigned i = 0; i < CNT_BLOCK_CODES; ++i)
+            if (src.planes[i].test(idx))
+                set |= 1U << i;
+
+        VarState &vs = state[idx];
+        vs.code = codeBySet(set);
+        vs.loc  = src.locs[idx];
+    }
+}
+
+/**
+ * merge block states (used for Y nodes of CFG)
+ * @param dst destination state (used in read-write mode)
+ * @param src source state (used in read-only mode)
+ * @return true if the destination state has changed
+ */
+bool mergeState(BlockState &dst, const BlockState &src)
+{
+    // variables not defined in the target block yet take the location from src
+    TBitSet fresh = src.planes[0];
+    for (unsigned i = 1; i < CNT_BLOCK_CODES; ++i)
+        fresh |= src.planes[i];
+    for (unsigned i = 0; i < CNT_BLOCK_CODES; ++i)
+        fresh -= dst.planes[i];
+
+    bool changed = false;
+    for (unsigned i = 0; i < CNT_BLOCK_CODES; ++i) {
+        if (src.planes[i].is_subset_of(dst.planes[i]))
+            continue;
+
+        dst.planes[i] |= src.planes[i];
+        changed = true;
+    }
+
+    for (TBitSet::size_type idx = fresh.find_first(); TBitSet::npos != idx;
+            idx = fresh.find_next(idx))
+        dst.locs[idx] = src.locs[idx];
+
+    return changed;
+}
+
 /**
  * merge states (used for Y nodes of CFG)
  * @param data state of computation per current function
@@ -510,30 +695,23 @@ void updateState(
         const TState               &state,
         const TBlock                block)
 {
-    // target state
-    TState &dstState = data.stateMap[block];
-
-    // for each variable
-    bool changed = false;
-    BOOST_FOREACH(TState::const_reference item, state) {
-        if (mergeValues(dstState[item.first], item.second))
-            changed = true;
-    }
+    encodeState(data.exitState, state);
 
-    if (changed && data.todoLookup.insert(block)./* not already in */second)
-        data.todo.push(block);
+    const unsigned idx = data.blockIdx[block];
+    if (mergeState(data.entryStates[idx], data.exitState))
+        data.todo.insert(idx);
 }
 
 /**
  * replace state of the branch-by variable by VS_NULL_DEDUCED or
  * VS_NOT_NULL_DEDUCED
  * @param state state valid per current instruction
- * @param uid CodeStorage uid of the branch-by variable
+ * @param idx index of the branch-by variable in the state
  * @param val true in 'then' branch, false in 'else' branch
  */
-void replaceInBranch(TState &state, const TVar uid, bool val)
+void replaceInBranch(TState &state, const TVar idx, bool val)
 {
-    VarState &vs = state[uid];
+    VarState &vs = state[idx];
     bool isNull;
 
     const EVarState code = vs.code;
@@ -584,9 +762,9 @@ void handleInsnCondNondet(
     TState stateElse(state);
 
     // reflect the value of branch-by variable (if possible)
-    const TVar uid = varIdFromOperand(&cond);
-    replaceInBranch(stateThen, uid, true);
-    replaceInBranch(stateElse, uid, false);
+    const TVar idx = varIndex(data, &cond);
+    replaceInBranch(stateThen, idx, true);
+    replaceInBranch(stateElse, idx, false);
 
     // go to both targets and update the state there
     updateState(data, stateThen, targets[0]);
@@ -604,8 +782,7 @@ void handleInsnCond(
     // resolve branch-by operand
     TOperand &cond = insn->operands[0];
     TState &state = data.localState;
-    const TVar uid = varIdFromOperand(&cond);
-    const VarState &vs = state[uid];
+    const VarState &vs = state[varIndex(data, &cond)];
 
     // now check if we know the value
     const EVarState code = vs.code;
@@ -654,11 +831,11 @@ void handleInsnTerm(
     }
 }
 
-void handleBlock(Data &data, const TBlock bb)
+void handleBlock(Data &data, const unsigned idx)
 {
     // go through the sequence of instructions of the current basic block
-    data.localState = data.stateMap[bb];
-    BOOST_FOREACH(const TInsn insn, *bb) {
+    decodeState(data.localState, data.entryStates[idx]);
+    BOOST_FOREACH(const TInsn insn, *data.blockList[idx]) {
         if (cl_is_term_insn(insn->code))
             // terminal instruction
             handleInsnTerm(data, insn);
@@ -669,33 +846,114 @@ void handleBlock(Data &data, const TBlock bb)
     }
 }
 
-void handleFnc(const CodeStorage::Fnc &fnc)
+// number the basic blocks in reverse post-order, unreachable blocks go last
+void numberBlocks(Data &data, const CodeStorage::ControlFlow &cfg)
 {
-    Data data;
+    std::vector<TBlock> postOrder;
+    std::set<TBlock> seen;
+
+    typedef std::pair<TBlock, unsigned> TDfsItem;
+    std::stack<TDfsItem> dfsStack;
+    if (cfg.size()) {
+        const TBlock entry = cfg.entry();
+        seen.insert(entry);
+        dfsStack.push(TDfsItem(entry, 0U));
+    }
+
+    while (!dfsStack.empty()) {
+        TDfsItem &item = dfsStack.top();
+        TTargetList &targets = item.first->targets();
+        if (item.second < targets.size()) {
+            const TBlock bbNext = targets[item.second++];
+            if (seen.insert(bbNext)./* not already in */second)
+                dfsStack.push(TDfsItem(bbNext, 0U));
+
+            continue;
+        }
+
+        postOrder.push_back(item.first);
+        dfsStack.pop();
+    }
+
+    data.blockList.assign(postOrder.rbegin(), postOrder.rend());
+    BOOST_FOREACH(const TBlock bb, cfg)
+        if (!seen.count(bb))
+            data.blockList.push_back(bb);
+
+    const unsigned cntBlocks = data.blockList.size();
+    for (unsigned idx = 0; idx < cntBlocks; ++idx)
+        data.blockIdx[data.blockList[idx]] = idx;
+}
+
+// allocate the flat table for the uids of all variables in the program
+void initVarIdxTable(VarIdxTable &vt, const CodeStorage::VarDb &vars)
+{
+    if (vars.begin() == vars.end())
+        return;
+
+    TVar uidMin = vars.begin()->uid;
+    TVar uidMax = uidMin;
+    BOOST_FOREACH(const CodeStorage::Var &var, vars) {
+        const TVar uid = var.uid;
+        uidMin = std::min(uidMin, uid);
+        uidMax = std::max(uidMax, uid);
+    }
+
+    vt.uidBase = uidMin;
+    vt.idxByUid.resize(uidMax - uidMin + 1);
+}
+
+// number the variables used in the function and allocate the dense states
+void numberVars(Data &data, const CodeStorage::ControlFlow &cfg)
+{
+    std::set<TVar> vars;
+    BOOST_FOREACH(const TBlock bb, cfg)
+        BOOST_FOREACH(const TInsn insn, *bb)
+            BOOST_FOREACH(TOperand &op, insn->operands)
+                if (CL_OPERAND_VAR == op.code)
+                    vars.insert(varIdFromOperand(&op));
+
+    // std::set is sorted, so the numbering preserves the order of uids
+    unsigned cntVars = 0U;
+    BOOST_FOREACH(const TVar uid, vars)
+        data.varIdx.idxByUid[uid - data.varIdx.uidBase] = cntVars++;
+
+    data.localState.resize(cntVars);
+    initBlockState(data.exitState, cntVars);
+
+    data.entryStates.resize(data.blockList.size());
+    BOOST_FOREACH(BlockState &bs, data.entryStates)
+        initBlockState(bs, cntVars);
+}
+
+void handleFnc(VarIdxTable &varIdx, const CodeStorage::Fnc &fnc)
+{
+    Data data(varIdx);
     Data::TSched &todo = data.todo;
     const CodeStorage::ControlFlow &cfg = fnc.cfg;
+    numberBlocks(data, cfg);
+    numberVars(data, cfg);
 
-    // block-level scheduler
-    TBlock bb = cfg.entry();
-    todo.push(bb);
-    data.todoLookup.insert(bb);
+    // block-level scheduler, blocks are numbered in reverse post-order so that
+    // taking the lowest index first processes a block after its predecessors
+    // unless they are connected by a loop
+    todo.insert(/* entry */ 0U);
     while (!todo.empty()) {
-        bb = todo.front();
-        todo.pop();
-        if (1 != data.todoLookup.erase(bb))
-            CL_BREAK_IF("BlockScheduler malfunction");
+        const unsigned idx = *todo.begin();
+        todo.erase(todo.begin());
 
         // process one basic block
+        const TBlock bb = data.blockList[idx];
         CL_BREAK_IF(!bb || !bb->size());
         const TInsn insn = bb->front();
         CL_DEBUG_MSG(&insn->loc, "analyzing block " << bb->name() << "...");
-        handleBlock(data, bb);
+        handleBlock(data, idx);
     }
 
     // finally report all errors/warning over the already computed fixed-point
     data.silent = false;
     BOOST_FOREACH(const TBlock bb, cfg)
-        handleBlock(data, bb);
+        handleBlock(data, data.blockIdx[bb]);
 }
 
 // /////////////////////////////////////////////////////////////////////////////
@@ -704,6 +962,9 @@ void clEasyRun(const CodeStorage::Storage &stor, const char *)
 {
     using namespace CodeStorage;
 
+    VarIdxTable varIdx;
+    initVarIdxTable(varIdx, stor.vars);
+
     BOOST_FOREACH(const Fnc *pFnc, stor.callGraph.topOrder) {
         const Fnc &fnc = *pFnc;
         if (!isDefined(fnc))
@@ -712,6 +973,6 @@ void clEasyRun(const CodeStorage::Storage &stor, const char *)
         const struct cl_loc *loc = locationOf(fnc);
         CL_DEBUG_MSG(loc, "analyzing function " << nameOf(fnc) << "()...");
 
-        handleFnc(fnc);
+        handleFnc(varIdx, fnc);
     }
 }
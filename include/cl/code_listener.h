@@ -146,6 +146,28 @@ void cl_global_init_defaults(
  */
 void cl_global_cleanup(void);
 
+/**
+ * suppress (or resume) printing of warnings, errors and notes
+ *
+ * Debug messages and fatal errors are printed regardless of this setting.
+ * @param mute - true to suppress the messages, false to print them again
+ * @return count of the warnings and errors suppressed since the messages were
+ * muted last time
+ */
+int cl_mute_messages(bool mute);
+
+/**
+ * start measuring time spent in the phases of the analysis
+ *
+ * The summary of phases is printed (as notes) by cl_global_cleanup(), which
+ * also writes the trace of the phases to a file if a name of the file is given.
+ * @param file_name - name of the file to write the trace into, in the trace
+ * event format of Chrome, or NULL to print the summary only
+ * @note This should be called before creating any code listener, it is not
+ * thread-safe.
+ */
+void cl_phase_trace_init(const char *file_name);
+
 /**
  * symbol scope enumeration (linearly ordered)
  */
@@ -983,6 +1005,40 @@ void cl_chain_append(
         struct cl_code_listener         *chain,
         struct cl_code_listener         *listener);
 
+/**
+ * feed cl_code_listener object by a code snapshot
+ * @param file_name Name of the file written by the "snapshot" listener.
+ * @param listener Object ought to be fed by the recorded code. Neither its
+ * acknowledge() nor destroy() method is called by this function.
+ * @return true on success, false if the snapshot could not be replayed
+ * @note The data of the snapshot stay allocated until the process exits, as
+ * listeners are allowed to keep pointers to types and variables.
+ */
+bool cl_snapshot_replay(
+        const char                      *file_name,
+        struct cl_code_listener         *listener);
+
+/**
+ * link several code snapshots and feed cl_code_listener object by the result
+ *
+ * Global functions and variables are resolved by name across the snapshots,
+ * named global types that look the same are shared, and everything else gets
+ * a uid that does not collide with the other snapshots.  The declarations are
+ * loaded from all the snapshots first, the code is then replayed one snapshot
+ * after another.
+ * @param file_names Names of the files written by the "snapshot" listener.
+ * @param cnt Count of the file names.
+ * @param listener Object ought to be fed by the recorded code. Neither its
+ * acknowledge() nor destroy() method is called by this function.
+ * @return true on success, false if the snapshots could not be linked
+ * @note The same as for cl_snapshot_replay(), the data stay allocated until
+ * the process exits.
+ */
+bool cl_snapshot_link(
+        const char *const               file_names[],
+        int                             cnt,
+        struct cl_code_listener         *listener);
+
 #ifdef __cplusplus
 }
 #endif
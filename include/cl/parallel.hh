@@ -0,0 +1,50 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This file is part of predator.
+ *
+ * predator is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * predator is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with predator.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef H_GUARD_PARALLEL_H
+#define H_GUARD_PARALLEL_H
+
+/**
+ * @file parallel.hh
+ * a minimal pool of threads for the preprocessing of CodeStorage, analyzers
+ * may use it to process independent functions concurrently
+ */
+
+#include <functional>
+#include <vector>
+
+namespace CodeStorage {
+    struct Fnc;
+    struct Storage;
+
+    /// return the number of threads used by parallelFor()
+    unsigned cntWorkerThreads();
+
+    /**
+     * run job(0), ..., job(cnt - 1), possibly concurrently by a pool of threads
+     * @note the jobs need to be independent of each other, the function returns
+     * once all of them are done
+     */
+    void parallelFor(unsigned cnt, const std::function<void (unsigned)> &job);
+
+    /// return the list of _defined_ functions in the order they appear in stor
+    std::vector<Fnc *> definedFncs(Storage &stor);
+}
+
+#endif /* H_GUARD_PARALLEL_H */
@@ -0,0 +1,79 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This file is part of predator.
+ *
+ * predator is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * predator is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with predator.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef H_GUARD_PHASE_H
+#define H_GUARD_PHASE_H
+
+/**
+ * @file phase.hh
+ * PhaseTimer - hierarchical timer of the analysis phases, see also
+ * cl_phase_trace_init()
+ */
+
+/// set by cl_phase_trace_init(), nothing is measured unless it is true
+extern bool clPhaseTimerActive;
+
+struct PhaseNode;
+
+/**
+ * measure the time spent in a scope, the phases nest per thread
+ *
+ * Unless cl_phase_trace_init() has been called, an instance costs just a test
+ * of a global flag.  Otherwise the time is added to the node of the phase in
+ * the tree of phases (phases of the same name that are nested in the same
+ * phase share the node) and a trace event is recorded.  If memory debugging
+ * is enabled (DEBUG_MEM_USAGE), the growth of the heap over the phase is
+ * accumulated in the node, too.  Note that the heap is shared by all threads,
+ * so the phases running in parallel affect each other's numbers.
+ */
+class PhaseTimer {
+    public:
+        /// start the phase, the name needs to outlive the program (a literal)
+        PhaseTimer(const char *name):
+            node_(0)
+        {
+            if (::clPhaseTimerActive)
+                this->enter(name);
+        }
+
+        ~PhaseTimer() {
+            if (node_)
+                this->leave();
+        }
+
+    private:
+        // not copyable
+        PhaseTimer(const PhaseTimer &);
+        PhaseTimer& operator=(const PhaseTimer &);
+
+        void enter(const char *name);
+        void leave();
+
+        friend void phaseCount(const char *, unsigned long);
+
+        PhaseNode                  *node_;
+        PhaseTimer                 *parent_;
+        long long                   start_;
+        long long                   memStart_;  ///< negative if not available
+};
+
+/// add cnt to the counter of the given name in the innermost running phase
+void phaseCount(const char *name, unsigned long cnt = 1UL);
+
+#endif /* H_GUARD_PHASE_H */
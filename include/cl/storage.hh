@@ -154,6 +154,12 @@ class VarDb {
          */
         const Var& operator[](cl_uid_t uid) const;
 
+        /**
+         * index the IDs in a flat table, which makes the lookup O(1)
+         * @note useful only for builder, called once all variables are known
+         */
+        void compact();
+
         /**
          * return STL-like iterator to go through the container
          */
@@ -215,6 +221,12 @@ class TypeDb {
          */
         const struct cl_type* operator[](cl_uid_t) const;
 
+        /**
+         * index the IDs in a flat table, which makes the lookup O(1)
+         * @note useful only for builder, called once all types are known
+         */
+        void compact();
+
         /**
          * return STL-like iterator to go through the container
          */
@@ -544,6 +556,43 @@ class Block {
         std::string name_;
 };
 
+/**
+ * position of a basic block in the dominator tree and the loop nesting forest
+ * of its ControlFlow, see ControlFlow::loopInfo()
+ */
+struct BlockLoopInfo {
+    /// false for blocks that can't be reached from the entry block
+    bool                        isReachable;
+
+    /// immediate dominator, zero for the entry block and unreachable blocks
+    const Block                 *idom;
+
+    /// true if the block is the header of a loop
+    bool                        isLoopHeader;
+
+    /// true if the loop headed by this block has more than one entry
+    bool                        isIrreducible;
+
+    /**
+     * header of the innermost loop that contains the block, zero if there is
+     * no such loop.  For a loop header, this is the header of the parent loop.
+     */
+    const Block                 *loopHeader;
+
+    /// count of loops that contain the block (a header is in its own loop)
+    unsigned                    loopDepth;
+
+    BlockLoopInfo():
+        isReachable(false),
+        idom(0),
+        isLoopHeader(false),
+        isIrreducible(false),
+        loopHeader(0),
+        loopDepth(0)
+    {
+    }
+};
+
 /**
  * Control flow graph - an easy to analyse representation of the intermediate
  * code. Nodes of the graph are basic blocks - instances of Block
@@ -600,6 +649,19 @@ class ControlFlow {
          */
         size_t size()                         const { return bbs_.size();  }
 
+        /**
+         * return the dominator tree and loop nesting info of the given block
+         * @note the info is computed by findLoopClosingEdges(), all blocks
+         * look unreachable until then
+         */
+        const BlockLoopInfo& loopInfo(const Block *) const;
+
+        /// write access to the loop info, used by findLoopClosingEdges()
+        BlockLoopInfo& loopInfo(const Block *);
+
+        /// return true if bbA dominates bbB (each block dominates itself)
+        bool dominates(const Block *bbA, const Block *bbB) const;
+
     private:
         TList bbs_;
         struct Private;
@@ -795,6 +857,12 @@ class FncDb {
          */
         const Fnc* operator[](cl_uid_t uid) const;
 
+        /**
+         * index the IDs in a flat table, which makes the lookup O(1)
+         * @note useful only for builder, called once all functions are known
+         */
+        void compact();
+
         /**
          * return STL-like iterator to go through all functions inside
          */
@@ -835,14 +903,25 @@ namespace CallGraph {
         /// insns that take address of this function, zero key means initializer
         TInsnListByFnc              callbacks;
 
+        /// index of the strongly connected component in Graph::sccs
+        unsigned                    scc;
+
+        /// true if the function may (directly or indirectly) call itself
+        bool                        recursive;
+
         Node(Fnc *fnc_):
-            fnc(fnc_)
+            fnc(fnc_),
+            scc(0),
+            recursive(false)
         {
         }
     };
 
     typedef std::set<Node *>                        TNodeList;
 
+    /// list of SCCs, each of them given as a list of functions
+    typedef std::vector<TFncList>                   TSccList;
+
     struct Graph {
         TNodeList                   roots;
         TNodeList                   leaves;
@@ -852,6 +931,15 @@ namespace CallGraph {
 
         TFncList                    topOrder;
 
+        /**
+         * strongly connected components of the graph (direct calls only),
+         * sorted such that each SCC comes after all the SCCs it calls into
+         */
+        TSccList                    sccs;
+
+        /// all functions in the order given by sccs (callees go first)
+        TFncList                    bottomUpOrder;
+
         Graph():
             hasIndirectCall(false),
             hasCallback(false)
@@ -35,6 +35,7 @@
 #include "symtrace.hh"
 #include "symutil.hh"
 #include "util.hh"
+#include "vra_proxy.hh"
 
 #include <stdexcept>
 #include <string>
@@ -46,23 +47,6 @@ extern "C" {
     __attribute__ ((__visibility__ ("default"))) int plugin_is_GPL_compatible;
 }
 
-void initGlVars(SymHeap &sh)
-{
-    using namespace CodeStorage;
-    TStorRef stor = sh.stor();
-
-    BOOST_FOREACH(const Var &var, stor.vars) {
-        if (VAR_GL != var.code)
-            continue;
-
-        const std::string varString = varToString(stor, var.uid);
-        CL_DEBUG_MSG(&var.loc, "(g) initializing gl variable: " << varString);
-
-        const CVar cv(var.uid, /* gl var */ 0);
-        initGlVar(sh, cv);
-    }
-}
-
 void digGlJunk(SymHeap &sh)
 {
     const SymBackTrace *bt = sh.exitPoint();
@@ -170,6 +154,10 @@ void clEasyRun(const CodeStorage::Storage &stor, const char *configString)
     // read parameters of symbolic execution
     GlConf::loadConfigString(configString);
 
+    if (GlConf::data.vraRanges)
+        // let the value-range analysis decide some of the conditions
+        VraProxy::computeRanges(stor);
+
     // run symbolic execution
     try {
         launchSymExec(stor);
@@ -21,6 +21,7 @@
 #include "glconf.hh"
 
 #include "fixed_point_proxy.hh"
+#include "vra_proxy.hh"
 
 #include <cl/cl_msg.hh>
 
@@ -52,6 +53,8 @@ Options::Options():
     stateLiveOrdering(SE_STATE_ON_THE_FLY_ORDERING),
     exitLeaks(SE_EXIT_LEAKS),
     detectContainers(false),
+    prewarmCallCache(false),
+    vraRanges(false),
     fixedPoint(0)
 {
 }
@@ -214,12 +217,35 @@ void handleOOM(const string &name, const string &value)
     data.oomSimulation = true;
 }
 
+void handlePrewarmCallCache(const string &name, const string &value)
+{
+    assumeNoValue(name, value);
+    data.prewarmCallCache = true;
+}
+
+void handleSteensgaard(const string &name, const string &value)
+{
+    // consumed by pointsToAnalyse() in Code Listener, nothing to do here
+    assumeNoValue(name, value);
+}
+
 void handleTrackUninit(const string &name, const string &value)
 {
     assumeNoValue(name, value);
     data.trackUninit = true;
 }
 
+void handleVraRanges(const string &name, const string &value)
+{
+    assumeNoValue(name, value);
+    if (!VraProxy::isAvailable()) {
+        CL_ERROR("option \"" << name << "\" requires Predator built with vra");
+        return;
+    }
+
+    data.vraRanges = true;
+}
+
 void handleDetectContainers(const string &name, const string &value)
 {
 #if !SH_PREVENT_AMBIGUOUS_ENT_ID
@@ -251,9 +277,12 @@ ConfigStringParser::ConfigStringParser()
     tbl_["no_error_recovery"]       = handleNoErrorRecovery;
     tbl_["no_plot"]                 = handleNoPlot;
     tbl_["oom"]                     = handleOOM;
+    tbl_["prewarm_call_cache"]      = handlePrewarmCallCache;
     tbl_["state_live_ordering"]     = handleStateLiveOrdering;
+    tbl_["steensgaard"]             = handleSteensgaard;
     tbl_["track_uninit"]            = handleTrackUninit;
     tbl_["verifier_error_is_error"] = handleVerifierErrorIsError;
+    tbl_["vra_ranges"]              = handleVraRanges;
 }
 
 void ConfigStringParser::handleRawOption(const string &raw) const
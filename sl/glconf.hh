@@ -46,6 +46,8 @@ struct Options {
     int stateLiveOrdering;  ///< @copydoc config.h::SE_STATE_ON_THE_FLY_ORDERING
     bool exitLeaks;         ///< @copydoc config.h::SE_EXIT_LEAKS
     bool detectContainers;  ///< detect containers and operations over them
+    bool prewarmCallCache;  ///< execute callees bottom-up before the root fnc
+    bool vraRanges;         ///< decide conditions by the ranges of vra
     FixedPoint::StateByInsn *fixedPoint;  ///< fixed-point plotter (0 if unused)
 
     Options();
@@ -23,6 +23,7 @@
 
 #include <cl/cl_msg.hh>
 #include <cl/clutil.hh>
+#include <cl/phase.hh>
 #include <cl/storage.hh>
 
 #include "prototype.hh"
@@ -475,12 +476,15 @@ void abstractIfNeeded(SymHeap &sh)
 #if SE_DISABLE_SLS && SE_DISABLE_DLS
     return;
 #endif
+    PhaseTimer timer("abstract");
     Shape shape;
     while (discoverBestAbstraction(&shape, sh)) {
         if (!applyAbstraction(sh, shape))
             // the best abstraction given is unfortunately not good enough
             break;
 
+        phaseCount("abstractions");
+
         // some part of the symbolic heap has just been successfully abstracted,
         // let's look if there remains anything else suitable for abstraction
     }
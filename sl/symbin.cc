@@ -119,7 +119,7 @@ void emitPrototypeError(const struct cl_loc *lw, const char *name)
             << "() not recognized as built-in");
 }
 
-/// insert the given heap to dst if sane (after killing the given instruction)
+/// move the heap of core to dst if sane (after killing the given instruction)
 void insertCoreHeap(
         SymState                                    &dst,
         SymProc                                     &core,
@@ -130,8 +130,8 @@ void insertCoreHeap(
 
     core.killInsn(insn);
 
-    const SymHeap &sh = core.sh();
-    dst.insert(sh);
+    SymHeap &sh = core.sh();
+    dst.insertBySwap(sh);
 }
 
 bool resolveCallocSize(
@@ -386,7 +386,7 @@ bool handleFree(
     core.killInsn(insn);
 
     if (!core.hasFatalError())
-        dst.insert(core.sh());
+        dst.insertBySwap(core.sh());
 
     return true;
 }
@@ -905,8 +905,10 @@ bool handleExpect(
 
     // set the returned value to a condition
     const struct cl_operand &opDst = opList[0];
-    const FldHandle fldDst = core.fldByOperand(opDst);
-    core.setValueOf(fldDst, val);
+    {
+        const FldHandle fldDst = core.fldByOperand(opDst);
+        core.setValueOf(fldDst, val);
+    }
 
     // insert the resulting heap
     insertCoreHeap(dst, core, insn);
@@ -983,11 +985,13 @@ bool handleNondetInt(
 
     // set the returned value to a new value
     const struct cl_operand &opDst = opList[0];
-    const FldHandle fldDst = core.fldByOperand(opDst);
-    core.setValueOf(fldDst, val);
+    {
+        const FldHandle fldDst = core.fldByOperand(opDst);
+        core.setValueOf(fldDst, val);
+    }
 
     // insert the resulting heap
-    dst.insert(sh);
+    dst.insertBySwap(sh);
     return true;
 }
 
@@ -459,7 +459,7 @@ void SymCallCtx::flushCallResults(SymState &dst)
         LDP_PLOT(symcall, sh);
 #endif
         // flush the result
-        dst.insert(sh);
+        dst.insertBySwap(sh);
     }
 
     // mark as done
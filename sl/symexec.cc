@@ -24,6 +24,7 @@
 #include <cl/cldebug.hh>
 #include <cl/clutil.hh>
 #include <cl/memdebug.hh>
+#include <cl/phase.hh>
 #include <cl/storage.hh>
 
 #include "fixed_point_proxy.hh"
@@ -37,7 +38,9 @@
 #include "symutil.hh"
 #include "symtrace.hh"
 #include "util.hh"
+#include "vra_proxy.hh"
 
+#include <map>
 #include <queue>
 #include <set>
 #include <sstream>
@@ -55,6 +58,14 @@ bool installSignalHandlers(void)
         && SignalCatcher::install(SIGTERM);
 }
 
+/// thrown by SymExecEngine on a signal that terminates the analysis
+struct SignalledToDie: public std::runtime_error {
+    SignalledToDie():
+        std::runtime_error("signalled to die")
+    {
+    }
+};
+
 // /////////////////////////////////////////////////////////////////////////////
 // ExecStack
 class SymExecEngine;
@@ -86,6 +97,8 @@ class SymExec: public IStatsProvider {
                 const CodeStorage::Insn     &insn,
                 const CodeStorage::Fnc      &fnc);
 
+        bool /* clean */ prewarmCallCache(const CodeStorage::Fnc &root);
+
         virtual void printStats() const;
 
     private:
@@ -188,7 +201,9 @@ class SymExecEngine: public IStatsProvider {
         void execCondInsn();
         void execTermInsn();
         bool execNontermInsn();
+        bool execNontermInsnOn(SymHeap &, const CodeStorage::Insn &);
         bool execInsn();
+        bool execInsnInPlace();
         bool execBlock();
         void processPendingSignals();
         void pruneOrigin();
@@ -285,7 +300,7 @@ void SymExecEngine::execReturn()
     core.execStackRestore();
 
     // commit one of the function results
-    dst_.insert(sh);
+    dst_.insertBySwap(sh);
     endReached_ = true;
 }
 
@@ -317,8 +332,9 @@ void SymExecEngine::updateState(SymHeap &sh, const CodeStorage::Block *ofBlock)
     if (!GlConf::data.joinOnLoopEdgesOnly)
         closingLoop = true;
 
-    // update _target_ state and check if anything has changed
-    if (stateMap_.insert(ofBlock, sh, closingLoop)) {
+    // update _target_ state and check if anything has changed, sh is not
+    // needed by any of the callers afterwards, so we can avoid cloning it
+    if (stateMap_.insertBySwap(ofBlock, sh, closingLoop)) {
         const SymStateMarked &target = stateMap_[ofBlock];
 
         // schedule for next wheel (if not already)
@@ -520,6 +536,15 @@ void SymExecEngine::execCondInsn()
         return;
     }
 
+    bool branch;
+    if (VraProxy::isCondDecided(&branch, *insnCnd)) {
+        // the value-range analysis shows that the other branch is infeasible
+        CL_DEBUG_MSG(lw_, "-" << ((branch) ? "T" : "F")
+                << "- CL_INSN_COND decided by vra");
+        this->updateStateInBranch(sh, branch, *insnCmp, *insnCnd, v1, v2);
+        return;
+    }
+
     if (this->bypassNonPointers(proc, *insnCmp, *insnCnd, v1, v2))
         // do not track relations over data we are not interested in
         return;
@@ -593,22 +618,35 @@ void SymExecEngine::execTermInsn()
 bool /* handled */ SymExecEngine::execNontermInsn()
 {
     const CodeStorage::Insn *insn = block_->operator[](insnIdx_);
+    SymHeap &origin = *localState_.begin()[heapIdx_];
+    if (CL_INSN_CALL != insn->code)
+        // localState_ is dropped once the insn is executed, so there is no
+        // need to clone the heap, it can be used as the working area directly
+        return this->execNontermInsnOn(origin, *insn);
+
+    // the heap has to stay intact in case it becomes the entry of a call
+    SymHeap sh(origin);
 
+    // drop the unnecessary Trace::CloneNode node in the trace graph
+    Trace::waiveCloneOperation(sh);
+
+    return this->execNontermInsnOn(sh, *insn);
+}
+
+bool /* handled */ SymExecEngine::execNontermInsnOn(
+        SymHeap                     &sh,
+        const CodeStorage::Insn     &insn)
+{
     // initialize execution properties based on the global configuration
     const SymExecCoreParams ep(GlConf::data);
 
     // working area for non-terminal instructions
-    const SymHeap &origin = localState_[heapIdx_];
-    SymHeap sh(origin);
     SymExecCore core(sh, &bt_, ep);
     core.setLocation(lw_);
 
-    // drop the unnecessary Trace::CloneNode node in the trace graph
-    Trace::waiveCloneOperation(sh);
-
     // execute the instruction
-    if (!core.exec(nextLocalState_, *insn)) {
-        CL_BREAK_IF(CL_INSN_CALL != insn->code);
+    if (!core.exec(nextLocalState_, insn)) {
+        CL_BREAK_IF(CL_INSN_CALL != insn.code);
         return false;
     }
 
@@ -636,12 +674,13 @@ bool /* handled */ SymExecEngine::handleExitPoint(const SymHeap &origin)
 
     // program exited on this execution path, go directly to the caller
     endReached_ = true;
-    dst_.insert(sh);
+    dst_.insertBySwap(sh);
     return true;
 }
 
 bool /* complete */ SymExecEngine::execInsn()
 {
+    PhaseTimer timer("exec");
     const CodeStorage::Insn *insn = block_->operator[](insnIdx_);
 
     // true for terminal instruction
@@ -728,6 +767,50 @@ bool /* complete */ SymExecEngine::execInsn()
     return true;
 }
 
+/// run the current insn directly on the only heap of localState_, if possible
+bool /* handled */ SymExecEngine::execInsnInPlace()
+{
+    if (!insnIdx_ || heapIdx_ || 1 != localState_.size())
+        // the bookkeeping of origin, the resume after a call and the splits
+        // of the state are left on execInsn()
+        return false;
+
+    const CodeStorage::Insn *insn = block_->operator[](insnIdx_);
+    if (cl_is_term_insn(insn->code) || CL_INSN_CALL == insn->code)
+        return false;
+
+    const CodeStorage::Insn *nextInsn = block_->operator[](insnIdx_ + 1);
+    if (CL_INSN_COND == nextInsn->code)
+        // this is going to be handled in execCondInsn()
+        return false;
+
+    SymHeap &sh = *localState_.begin()[0];
+    if (sh.exitPoint())
+        // handleExitPoint() is called from execInsn()
+        return false;
+
+    PhaseTimer timer("exec");
+    CL_DEBUG_MSG(lw_, "!!! executing insn #" << insnIdx_
+            << " in place ... " << (*insn));
+
+    // capture fixed-point for plotting if configured to do so
+    if (GlConf::data.fixedPoint)
+        GlConf::data.fixedPoint->insert(insn, sh);
+
+    // time to respond to a single pending signal
+    this->processPendingSignals();
+
+    // localState_ is dropped once the insn is executed, so the heap is used as
+    // the working area directly, the same as in execNontermInsn()
+    nextLocalState_.clear();
+    this->execNontermInsnOn(sh, *insn);
+
+    // the heap goes on to the next insn unless it has vanished, a split of the
+    // state is executed by execInsn() from now on
+    localState_.swap(nextLocalState_);
+    return true;
+}
+
 bool /* complete */ SymExecEngine::execBlock()
 {
     const std::string &name = block_->name();
@@ -758,6 +841,15 @@ bool /* complete */ SymExecEngine::execBlock()
             // update location info
             lw_ = &insn->loc;
 
+        if (this->execInsnInPlace()) {
+            if (localState_.size())
+                // the only heap has been moved on to the next insn
+                continue;
+
+            // we ended up with an empty state already, jump to the end of bb
+            break;
+        }
+
         // execute current instruction
         if (!this->execInsn()) {
             // function call reached, we should stand by
@@ -804,7 +896,8 @@ void SymExecEngine::joinCallResults()
         // time to respond to a single pending signal
         this->processPendingSignals();
 
-        all.insert(callResults_[i]);
+        // callResults_ is cleared before the next call anyway
+        all.insertBySwap(*callResults_.begin()[i]);
     }
 
     all.swap(nextLocalState_);
@@ -1026,7 +1119,7 @@ void SymExecEngine::processPendingSignals()
 
         default:
             // time to finish...
-            throw std::runtime_error("signalled to die");
+            throw SignalledToDie();
     }
 }
 
@@ -1279,6 +1372,101 @@ void SymExec::execFnc(
     }
 }
 
+// the call instruction is referred by the trace graph, so it needs to live
+// as long as the process is running
+const CodeStorage::Insn& synthCallInsn(const CodeStorage::Fnc &fnc)
+{
+    static std::map<const CodeStorage::Fnc *, CodeStorage::Insn> insnByFnc;
+    CodeStorage::Insn &insn = insnByFnc[&fnc];
+    if (insn.operands.empty()) {
+        // XXX: synthesize CL_INSN_CALL
+        insn.stor = fnc.stor;
+        insn.bb   = const_cast<CodeStorage::Block *>(fnc.cfg.entry());
+        insn.code = CL_INSN_CALL;
+        insn.loc  = *locationOf(fnc);
+        insn.operands.resize(2);
+        insn.operands[1] = fnc.def;
+    }
+
+    return insn;
+}
+
+bool /* clean */ SymExec::prewarmCallCache(const CodeStorage::Fnc &root)
+{
+    using namespace CodeStorage;
+
+    // collect the functions that can be called (directly) from root
+    std::set<const Fnc *> reachable;
+    std::vector<const Fnc *> todo(1, &root);
+    while (!todo.empty()) {
+        const Fnc *fnc = todo.back();
+        todo.pop_back();
+        if (!insertOnce(reachable, fnc) || !fnc->cgNode)
+            continue;
+
+        BOOST_FOREACH(TInsnListByFnc::const_reference item, fnc->cgNode->calls)
+            if (item.first)
+                todo.push_back(item.first);
+    }
+
+    // execute the callees with a generic entry state, callees go first so that
+    // the results of nested calls are already in the cache
+    //
+    // The generic entry states do not occur in the program, so the problems
+    // found there are not reported.  However, a cached call does not report
+    // them again once the real run hits it.  Hence the whole cache needs to be
+    // thrown away as soon as any problem is detected while pre-warming it.
+    bool clean = true;
+    BOOST_FOREACH(const Fnc *fnc, stor_.callGraph.bottomUpOrder) {
+        if (fnc == &root || !hasKey(reachable, fnc) || !isDefined(*fnc))
+            continue;
+
+        if (fnc->cgNode->recursive)
+            // the call cache does not handle recursion anyway
+            continue;
+
+        CL_DEBUG_MSG(locationOf(*fnc), "(b) pre-warming call cache for "
+                << nameOf(*fnc) << "()...");
+
+        SymHeap entry(stor_, new Trace::RootNode(fnc));
+#if SE_DISABLE_SYMCUT
+        // gl variables cannot be imported later on, same as in the real run
+        initGlVars(entry);
+#endif
+        SymHeapList results;
+        cl_mute_messages(true);
+        try {
+            this->execFnc(results, entry, synthCallInsn(*fnc), *fnc);
+        }
+        catch (const SignalledToDie &) {
+            cl_mute_messages(false);
+            throw;
+        }
+        catch (const std::runtime_error &) {
+            // the exec stack is cleaned up by SymExec::~SymExec()
+            clean = false;
+        }
+        catch (...) {
+            cl_mute_messages(false);
+            throw;
+        }
+
+        if (cl_mute_messages(false))
+            clean = false;
+
+        printMemUsage("SymExec::prewarmCallCache");
+        if (clean)
+            continue;
+
+        CL_DEBUG_MSG(locationOf(*fnc), "(b) a problem detected while"
+                " pre-warming call cache for " << nameOf(*fnc)
+                << "(), dropping the call cache");
+        return false;
+    }
+
+    return true;
+}
+
 void SymExec::printStats() const
 {
     // TODO: print SymCallCache stats here as soon as we have implemented some
@@ -1299,6 +1487,16 @@ void execTopCall(
     initMemDrift();
 
     try {
+        if (GlConf::data.prewarmCallCache) {
+            SymExec se(entry.stor());
+            if (se.prewarmCallCache(fnc)) {
+                se.execFnc(results, entry, insn, fnc);
+                return;
+            }
+
+            // the cache is not usable, drop it together with the SymExec
+        }
+
         SymExec se(entry.stor());
         se.execFnc(results, entry, insn, fnc);
         // SymExec::~SymExec() is going to be executed as leaving this block
@@ -1319,14 +1517,7 @@ void execute(
     if (!installSignalHandlers())
         CL_WARN("unable to install signal handlers");
 
-    // XXX: synthesize CL_INSN_CALL
-    static CodeStorage::Insn insn;
-    insn.stor = fnc.stor;
-    insn.bb   = const_cast<CodeStorage::Block *>(fnc.cfg.entry());
-    insn.code = CL_INSN_CALL;
-    insn.loc  = *locationOf(fnc);
-    insn.operands.resize(2);
-    insn.operands[1] = fnc.def;
+    const CodeStorage::Insn &insn = synthCallInsn(fnc);
 
     // run the symbolic execution
     execTopCall(results, entry, insn, fnc);
@@ -21,6 +21,7 @@
 #include "symgc.hh"
 
 #include <cl/cl_msg.hh>
+#include <cl/phase.hh>
 
 #include "symheap.hh"
 #include "symplot.hh"
@@ -82,6 +83,8 @@ bool gcCore(SymHeap &sh, TObjId obj, TObjSet *leakObjs, bool sharedOnly)
     if (OBJ_INVALID == obj)
         return false;
 
+    PhaseTimer timer("gc");
+
     bool detected = false;
 
     std::set<TObjId> whiteList;
@@ -23,6 +23,7 @@
 #include <cl/cl_msg.hh>
 #include <cl/cldebug.hh>
 #include <cl/clutil.hh>
+#include <cl/phase.hh>
 
 #include "glconf.hh"
 #include "prototype.hh"
@@ -2556,6 +2557,7 @@ bool joinSymHeaps(
         SymHeap                  sh2,
         const bool               allowThreeWay)
 {
+    PhaseTimer timer("join");
     SJ_DEBUG("--> joinSymHeaps()");
     TStorRef stor = sh1.stor();
     CL_BREAK_IF(&stor != &sh2.stor());
@@ -2927,7 +2927,7 @@ bool SymExecCore::execCore(
     Trace::Node *trOrig = sh_.traceNode();
     Trace::Node *trInsn = new Trace::InsnNode(trOrig, &insn, /* bin */ false);
     sh_.traceUpdate(trInsn);
-    dst.insert(sh_);
+    dst.insertBySwap(sh_);
     return true;
 }
 
@@ -2940,9 +2940,11 @@ bool SymExecCore::concretizeLoop(
 #ifndef NDEBUG
     bool hit = false;
 #endif
+    // take over the contents of sh_ instead of cloning it, the caller does
+    // not need sh_ afterwards, the same as in execCore()
     TSymHeapList todo;
-    todo.push_back(sh_);
-    Trace::waiveCloneOperation(todo.back());
+    todo.push_back(SymHeap(sh_.stor(), sh_.traceNode()));
+    todo.back().swap(sh_);
 
     while (!todo.empty()) {
         SymHeap &sh = todo.front();
@@ -235,6 +235,8 @@ class SymExecCore: public SymProc {
          * @note see also code_listener.h::cl_is_term_insn()
          * @param dst a container to store the result(s) to
          * @param insn an instruction to be executed
+         * @attention the contents of the managed heap may be swapped into dst,
+         * so it is @b not usable afterwards (except destruction)
          * @note returning false in this case does @b not mean there has been an
          * error
          * @return true, if the requested instruction has been processed; false
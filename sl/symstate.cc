@@ -96,25 +96,37 @@ SymState::SymState(const SymState &ref)
     SymState::operator=(ref);
 }
 
-void SymState::insertNew(const SymHeap &sh)
+void SymState::insertNew(const SymHeap &sh, SymHeap *donor)
 {
-    // clone the given heap
-    SymHeap *dup = new SymHeap(sh);
+    SymHeap *dup;
+    if (donor) {
+        // take over the contents of the donor instead of cloning it
+        CL_BREAK_IF(donor != &sh);
+        dup = new SymHeap(sh.stor(), sh.traceNode());
+        dup->swap(*donor);
+    }
+    else {
+        // clone the given heap
+        dup = new SymHeap(sh);
 
-    // drop the unneeded Trace::CloneNode
-    Trace::waiveCloneOperation(*dup);
+        // drop the unneeded Trace::CloneNode
+        Trace::waiveCloneOperation(*dup);
+    }
 
     // append the pointer to our container
     heaps_.push_back(dup);
 }
 
-bool SymState::insert(const SymHeap &sh, bool /* allowThreeWay */ )
+bool SymState::insertCore(
+        const SymHeap                   &sh,
+        SymHeap                         *donor,
+        bool                            /* allowThreeWay */)
 {
     if (-1 != this->lookup(sh))
         return false;
 
     // add given heap to union
-    this->insertNew(sh);
+    this->insertNew(sh, donor);
     return true;
 }
 
@@ -278,16 +290,19 @@ bool joinRequested(const bool allowThreeWay)
     return allowThreeWay;
 }
 
-bool SymStateWithJoin::insert(const SymHeap &shNew, bool allowThreeWay)
+bool SymStateWithJoin::insertCore(
+        const SymHeap                   &shNew,
+        SymHeap                         *donor,
+        bool                            allowThreeWay)
 {
     if (!joinRequested(allowThreeWay))
         // we are asked not to check for entailment, only isomorphism
-        return SymHeapUnion::insert(shNew, allowThreeWay);
+        return SymHeapUnion::insertCore(shNew, donor, allowThreeWay);
 
     const int cnt = this->size();
     if (!cnt) {
         // no heaps inside, insert the first now
-        this->insertNew(shNew);
+        this->insertNew(shNew, donor);
         return true;
     }
 
@@ -311,7 +326,7 @@ bool SymStateWithJoin::insert(const SymHeap &shNew, bool allowThreeWay)
 
     if (idx == cnt) {
         // nothing to join here
-        this->insertNew(shNew);
+        this->insertNew(shNew, donor);
         return true;
     }
 
@@ -338,7 +353,10 @@ bool SymStateWithJoin::insert(const SymHeap &shNew, bool allowThreeWay)
             // pick the resulting trace node while preserving the heap itself
             {
                 Trace::NodeHandle tr(result.traceNode());
-                result = shNew;
+                if (donor)
+                    result.swap(*donor);
+                else
+                    result = shNew;
                 result.traceUpdate(tr.node());
             }
 
@@ -605,6 +623,23 @@ bool SymStateMap::insert(
         const CodeStorage::Block        *dst,
         const SymHeap                   &sh,
         const bool                      allowThreeWay)
+{
+    return this->insertCore(dst, sh, /* donor */ 0, allowThreeWay);
+}
+
+bool SymStateMap::insertBySwap(
+        const CodeStorage::Block        *dst,
+        SymHeap                         &sh,
+        const bool                      allowThreeWay)
+{
+    return this->insertCore(dst, sh, /* donor */ &sh, allowThreeWay);
+}
+
+bool SymStateMap::insertCore(
+        const CodeStorage::Block        *dst,
+        const SymHeap                   &sh,
+        SymHeap                         *donor,
+        const bool                      allowThreeWay)
 {
     // look for the _target_ block
     Private::BlockState &ref = d->cont[dst];
@@ -617,10 +652,10 @@ bool SymStateMap::insert(
                 || (CL_INSN_COND == dst->back()->code && 2 == dst->size()))))
     {
         CL_DEBUG("SymStateMap::insert() bypasses even the isomorphism check");
-        ref.state.insertNew(sh);
+        ref.state.insertNew(sh, donor);
     }
     else
-        changed = ref.state.insert(sh, allowThreeWay);
+        changed = ref.state.insertCore(sh, donor, allowThreeWay);
 
     if (ref.state.size() <= size)
         // if the size did not grow, there must have been at least join
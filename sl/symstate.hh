@@ -63,7 +63,20 @@ class SymState {
         virtual int lookup(const SymHeap &heap) const = 0;
 
         /// insert given SymHeap object into the state
-        virtual bool insert(const SymHeap &sh, bool allowThreeWay = true);
+        bool insert(const SymHeap &sh, bool allowThreeWay = true) {
+            return this->insertCore(sh, /* donor */ 0, allowThreeWay);
+        }
+
+        /**
+         * insert given SymHeap object into the state without cloning it
+         * @param sh the heap to be inserted, its contents may be swapped into
+         * the state, so it is @b not usable afterwards (except destruction)
+         * @param allowThreeWay if true, three-way join is allowed
+         * @attention there must be no FldHandle bound to sh at this point
+         */
+        bool insertBySwap(SymHeap &sh, bool allowThreeWay = true) {
+            return this->insertCore(sh, /* donor */ &sh, allowThreeWay);
+        }
 
         /// return count of object stored in the container
         size_t size()          const { return heaps_.size();  }
@@ -86,8 +99,14 @@ class SymState {
         iterator end()               { return heaps_.end();   }
 
     protected:
+        /// @param donor if not null, its contents is used instead of a clone
+        virtual bool insertCore(
+                const SymHeap                  &sh,
+                SymHeap                        *donor,
+                bool                            allowThreeWay);
+
         /// insert @b new SymHeap that @ must be guaranteed to be not yet in
-        virtual void insertNew(const SymHeap &sh);
+        virtual void insertNew(const SymHeap &sh, SymHeap *donor = 0);
 
         virtual void eraseExisting(int nth) {
             delete heaps_[nth];
@@ -147,8 +166,11 @@ class SymHeapUnion: public SymState {
 };
 
 class SymStateWithJoin: public SymHeapUnion {
-    public:
-        virtual bool insert(const SymHeap &sh, bool allowThreeWay = true);
+    protected:
+        virtual bool insertCore(
+                const SymHeap                  &sh,
+                SymHeap                        *donor,
+                bool                            allowThreeWay);
 
     private:
         void packState(unsigned idx, bool allowThreeWay);
@@ -191,8 +213,8 @@ class SymStateMarked: public SymStateWithJoin {
         }
 
     protected:
-        virtual void insertNew(const SymHeap &sh) {
-            SymStateWithJoin::insertNew(sh);
+        virtual void insertNew(const SymHeap &sh, SymHeap *donor = 0) {
+            SymStateWithJoin::insertNew(sh, donor);
 
             // schedule the just inserted SymHeap for processing
             done_.push_back(false);
@@ -278,6 +300,12 @@ class SymStateMap: public IPendingCountProvider {
                     const SymHeap                  &sh,
                     bool                            allowThreeWay = true);
 
+        /// same as insert(), but the contents of sh may be swapped into the map
+        bool insertBySwap(
+                const CodeStorage::Block       *dst,
+                SymHeap                        &sh,
+                bool                            allowThreeWay = true);
+
         /// true if the specified block has ever joined/entailed any given state
         bool anyReuseHappened(const CodeStorage::Block *) const;
 
@@ -290,6 +318,12 @@ class SymStateMap: public IPendingCountProvider {
         /// object copying is @b not allowed
         SymStateMap& operator=(const SymStateMap &);
 
+        bool insertCore(
+                const CodeStorage::Block       *dst,
+                const SymHeap                  &sh,
+                SymHeap                        *donor,
+                bool                            allowThreeWay);
+
     private:
         struct Private;
         Private *d;
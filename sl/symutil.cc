@@ -21,6 +21,7 @@
 #include "symutil.hh"
 
 #include <cl/cl_msg.hh>
+#include <cl/clutil.hh>
 #include <cl/storage.hh>
 
 #include "symbt.hh"
@@ -409,6 +410,23 @@ void initGlVar(SymHeap &sh, const CVar &cv)
     (void) proc.objByVar(cv, /* initOnly */ alreadyAlive);
 }
 
+void initGlVars(SymHeap &sh)
+{
+    using namespace CodeStorage;
+    TStorRef stor = sh.stor();
+
+    BOOST_FOREACH(const Var &var, stor.vars) {
+        if (VAR_GL != var.code)
+            continue;
+
+        const std::string varString = varToString(stor, var.uid);
+        CL_DEBUG_MSG(&var.loc, "(g) initializing gl variable: " << varString);
+
+        const CVar cv(var.uid, /* gl var */ 0);
+        initGlVar(sh, cv);
+    }
+}
+
 bool /* anyChange */ redirectRefs(
         SymHeap                &sh,
         const TObjId            pointingFrom,
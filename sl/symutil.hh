@@ -155,6 +155,9 @@ inline bool isVarAlive(SymHeap &sh, const CVar &cv)
 
 void initGlVar(SymHeap &sh, const CVar &cv);
 
+/// initialize all global variables in the given heap
+void initGlVars(SymHeap &sh);
+
 inline TObjId nextObj(SymHeap &sh, TObjId obj, TOffset offNext)
 {
     if (!sh.isValid(obj))
@@ -0,0 +1,197 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This file is part of predator.
+ *
+ * predator is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * predator is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with predator.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "config.h"
+#include "vra_proxy.hh"
+
+#include <cl/cl_msg.hh>
+#include <cl/clutil.hh>
+#include <cl/phase.hh>
+#include <cl/storage.hh>
+
+#include "util.hh"
+
+#ifdef USE_VRA
+#   include "OperandToMemoryPlace.h"
+#   include "ValueAnalysis.h"
+#endif
+
+#include <map>
+#include <set>
+
+#include <boost/foreach.hpp>
+
+namespace VraProxy {
+
+#ifdef USE_VRA
+
+typedef std::set<cl_uid_t>                              TVarSet;
+typedef std::map<const CodeStorage::Insn *, bool>       TDecisionMap;
+
+/// CL_INSN_COND instructions that always take the same branch
+static TDecisionMap decisions;
+
+bool isAvailable()
+{
+    return true;
+}
+
+/// vra computes ranges only for these types
+bool isIntType(const struct cl_type *clt)
+{
+    switch (clt->code) {
+        case CL_TYPE_INT:
+        case CL_TYPE_BOOL:
+        case CL_TYPE_ENUM:
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+/// collect variables whose value vra cannot follow
+void collectUntrusted(TVarSet &dst, const CodeStorage::Fnc &fnc)
+{
+    BOOST_FOREACH(const CodeStorage::Block *bb, fnc.cfg) {
+        BOOST_FOREACH(const CodeStorage::Insn *insn, *bb) {
+            const CodeStorage::TOperandList &opList = insn->operands;
+
+            // the value returned by a function is not reliably bounded
+            if (CL_INSN_CALL == insn->code) {
+                const struct cl_operand &opRet = opList[/* dst */ 0];
+                if (CL_OPERAND_VAR == opRet.code)
+                    dst.insert(varIdFromOperand(&opRet));
+            }
+
+            // vra does not see the writes through pointers
+            BOOST_FOREACH(const struct cl_operand &op, opList)
+                if (CL_OPERAND_VAR == op.code && seekRefAccessor(op.accessor))
+                    dst.insert(varIdFromOperand(&op));
+        }
+    }
+}
+
+/// true if vra can be trusted about the value of the given operand
+bool isTrustedOperand(const struct cl_operand &op, const TVarSet &untrusted)
+{
+    if (!isIntType(op.type))
+        return false;
+
+    switch (op.code) {
+        case CL_OPERAND_CST:
+            return true;
+
+        case CL_OPERAND_VAR:
+            return !op.accessor
+                && isLcVar(op)
+                && !hasKey(untrusted, varIdFromOperand(&op));
+
+        default:
+            return false;
+    }
+}
+
+void decideConds(const ValueAnalysis &va, const CodeStorage::Fnc &fnc)
+{
+    TVarSet untrusted;
+    collectUntrusted(untrusted, fnc);
+
+    BOOST_FOREACH(const CodeStorage::Block *bb, fnc.cfg) {
+        const CodeStorage::Insn *insnCnd = bb->back();
+        if (CL_INSN_COND != insnCnd->code || bb->size() < 2)
+            continue;
+
+        // CL_INSN_COND is always preceded by the comparison it depends on
+        const CodeStorage::Insn *insnCmp = (*bb)[bb->size() - 2];
+        if (CL_INSN_BINOP != insnCmp->code)
+            continue;
+
+        const CodeStorage::TOperandList &opList = insnCmp->operands;
+        if (!isTrustedOperand(opList[/* src1 */ 1], untrusted)
+                || !isTrustedOperand(opList[/* src2 */ 2], untrusted))
+            continue;
+
+        // read the range of the condition at the end of the block
+        const struct cl_operand &cond = insnCnd->operands[/* src */ 0];
+        const MemoryPlace *mp = OperandToMemoryPlace::convert(&cond);
+        Range range;
+        if (!va.getRangeAtExit(bb, mp, range) || range.empty())
+            continue;
+
+        if (!range.containsFalse())
+            decisions[insnCnd] = true;
+        else if (!range.containsTrue())
+            decisions[insnCnd] = false;
+        else
+            continue;
+
+        CL_DEBUG_MSG(&insnCnd->loc, "VraProxy: the condition always goes "
+                << ((decisions[insnCnd]) ? "TRUE" : "FALSE"));
+    }
+}
+
+void computeRanges(const CodeStorage::Storage &stor)
+{
+    PhaseTimer timer("vra");
+
+    ValueAnalysis::FncToAnalysisMap fncToAnalysis;
+    ValueAnalysis::computeAnalysisForStorage(stor, /* sparse */ false,
+            fncToAnalysis);
+
+    BOOST_FOREACH(ValueAnalysis::FncToAnalysisMap::const_reference item,
+            fncToAnalysis)
+    {
+        decideConds(*item.second, *item.first);
+        delete item.second;
+    }
+
+    phaseCount("decided conditions", decisions.size());
+}
+
+bool isCondDecided(bool *pBranch, const CodeStorage::Insn &insnCnd)
+{
+    const TDecisionMap::const_iterator it = decisions.find(&insnCnd);
+    if (decisions.end() == it)
+        return false;
+
+    *pBranch = it->second;
+    return true;
+}
+
+#else // !USE_VRA
+
+bool isAvailable()
+{
+    return false;
+}
+
+void computeRanges(const CodeStorage::Storage &)
+{
+    CL_BREAK_IF("VraProxy::computeRanges() needs Predator built with vra");
+}
+
+bool isCondDecided(bool *, const CodeStorage::Insn &)
+{
+    return false;
+}
+
+#endif
+
+} // namespace VraProxy
@@ -0,0 +1,56 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This file is part of predator.
+ *
+ * predator is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * predator is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with predator.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef H_GUARD_VRA_PROXY_H
+#define H_GUARD_VRA_PROXY_H
+
+/**
+ * @file vra_proxy.hh
+ * an optional pre-pass that runs the value-range analysis of vra over the code
+ * storage and tells the symbolic execution which conditions always go the same
+ * way.  It is enabled by the @b vra_ranges option and available only if
+ * Predator is built with SL_USE_VRA.
+ */
+
+namespace CodeStorage {
+    struct Insn;
+    struct Storage;
+}
+
+namespace VraProxy {
+
+/// true if Predator has been built with the value-range analysis of vra
+bool isAvailable();
+
+/// run the value-range analysis over the whole code storage
+void computeRanges(const CodeStorage::Storage &stor);
+
+/**
+ * return true if the value-range analysis shows that the given CL_INSN_COND
+ * always takes the same branch, which is then stored into *pBranch
+ *
+ * Only comparisons of integral local variables whose address is never taken
+ * (and constants) are decided, as vra does not track anything that can be
+ * reached through a pointer.
+ */
+bool isCondDecided(bool *pBranch, const CodeStorage::Insn &insnCnd);
+
+} // namespace VraProxy
+
+#endif /* H_GUARD_VRA_PROXY_H */
@@ -0,0 +1,29 @@
+#include <verifier-builtins.h>
+
+int ext(void);
+
+int main()
+{
+    int *p = (int *)0;
+    int x = 0;
+
+    // the range of x from before the call must not survive the call
+    x = ext();
+    if (x == 0)
+        return 0;
+
+    *p = x;
+    return 0;
+}
+
+/**
+ * @file test-0616.c
+ *
+ * @brief the value returned by an undefined function is not bounded
+ *
+ * - vra_ranges must not let Predator prune the path behind (x == 0)
+ *
+ * @attention
+ * This description is automatically imported from tests/predator-regre/README.
+ * Any changes made to this comment will be thrown away on the next import.
+ */
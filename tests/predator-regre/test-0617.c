@@ -0,0 +1,29 @@
+#include <verifier-builtins.h>
+
+int main()
+{
+    int *p = (int *)0;
+    int x;
+
+    // x stays uninitialized on one of the paths
+    if (__VERIFIER_nondet_int())
+        x = 5;
+
+    if (x == 5)
+        return 0;
+
+    *p = x;
+    return 0;
+}
+
+/**
+ * @file test-0617.c
+ *
+ * @brief a variable assigned only on some of the paths can hold any value
+ *
+ * - vra_ranges must not let Predator prune the path behind (x == 5)
+ *
+ * @attention
+ * This description is automatically imported from tests/predator-regre/README.
+ * Any changes made to this comment will be thrown away on the next import.
+ */
@@ -54,6 +54,7 @@ namespace {
 }
 
 LoopFinder::BlockToUpperLimit LoopFinder::blockToUpperLimit;
+LoopFinder::FncToThresholds LoopFinder::fncToThresholds;
 
 /**
 * @brief Checks if instruction @a insn modifies variable @a variable in the way
@@ -1099,6 +1100,30 @@ void LoopFinder::computeLoopAnalysisForBlock(const Block *block)
 	}
 }
 
+/**
+* @brief Stores the constant from the condition of the given @a block into
+*        @a thresholds. The neighbouring numbers are stored too, so that both
+*        strict and non-strict comparisons and the increments of the loop
+*        variable are covered.
+*/
+void LoopFinder::collectThresholds(const Block *block, Thresholds &thresholds)
+{
+	const cl_operand* variable = NULL;
+	const cl_operand* constant = NULL;
+	enum cl_binop_e type;
+	if (!LoopFinder::checkCondition(block, &variable, &constant, type))
+		return;
+
+	const Number num = Utility::convertOperandToNumber(constant);
+	if (!num.isIntegral())
+		return;
+
+	const Number one = num.assign(Number(1, num.getBitWidth(), num.isSigned()));
+	thresholds.push_back(num.assign(num - one));
+	thresholds.push_back(num);
+	thresholds.push_back(num.assign(num + one));
+}
+
 /**
 * @brief Computes the loops' analysis for the given function @a fnc.
 */
@@ -1111,10 +1136,13 @@ void LoopFinder::computeLoopAnalysisForFnc(const Fnc &fnc)
 	const Block *entryBlock = fnc.cfg.entry();
 	todoStack.push(entryBlock);
 
+	Thresholds &thresholds = LoopFinder::fncToThresholds[&fnc];
+
 	while (!todoStack.empty()) {
 		const Block *block = todoStack.top();
 		todoStack.pop();
 		LoopFinder::computeLoopAnalysisForBlock(block);
+		LoopFinder::collectThresholds(block, thresholds);
 		doneSet.insert(block);
 
 		// Gets the successors of the processed block.
@@ -1150,7 +1178,26 @@ void LoopFinder::computeLoopAnalysis(const CodeStorage::Storage &stor)
 */
 unsigned long LoopFinder::getUpperLimit(const Block *block)
 {
-	return LoopFinder::blockToUpperLimit[block];
+	// The map must not be modified here, the functions are analysed concurrently.
+	BlockToUpperLimit::const_iterator it = LoopFinder::blockToUpperLimit.find(block);
+	if (it == LoopFinder::blockToUpperLimit.end())
+		return 0;
+
+	return it->second;
+}
+
+/**
+* @brief Returns the thresholds for widening of the ranges in the given @a fnc.
+*/
+const LoopFinder::Thresholds& LoopFinder::getThresholds(const Fnc &fnc)
+{
+	// The map must not be modified here, the functions are analysed concurrently.
+	static const Thresholds noThresholds;
+	FncToThresholds::const_iterator it = LoopFinder::fncToThresholds.find(&fnc);
+	if (it == LoopFinder::fncToThresholds.end())
+		return noThresholds;
+
+	return it->second;
 }
 
 /**
@@ -32,8 +32,16 @@ class LoopFinder {
 		/// Type for storing upper limits for each block;
 		typedef std::map<const CodeStorage::Block *, unsigned long> BlockToUpperLimit;
 
+		/// Type for storing the constants from the loop conditions of a function.
+		typedef std::vector<Number> Thresholds;
+
+		/// Type for storing the thresholds for each function.
+		typedef std::map<const CodeStorage::Fnc *, Thresholds> FncToThresholds;
+
 		static unsigned long getUpperLimit(const CodeStorage::Block *block);
 
+		static const Thresholds& getThresholds(const CodeStorage::Fnc &fnc);
+
 		static std::ostream& printLoopAnalysis(std::ostream &os);
 
 		static void computeLoopAnalysis(const CodeStorage::Storage &stor);
@@ -47,10 +55,16 @@ class LoopFinder {
 		/// For every block stores the upper limit.
 		static BlockToUpperLimit blockToUpperLimit;
 
+		/// For every function stores the thresholds for widening.
+		static FncToThresholds fncToThresholds;
+
 		static void computeLoopAnalysisForFnc(const CodeStorage::Fnc &fnc);
 
 		static void computeLoopAnalysisForBlock(const CodeStorage::Block *block);
 
+		static void collectThresholds(const CodeStorage::Block *block,
+			Thresholds &thresholds);
+
 		static const CodeStorage::Block* getThenBlock(const
 			CodeStorage::Block *block);
 
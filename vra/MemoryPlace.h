@@ -20,11 +20,12 @@ class MemoryPlace {
 	private:
 		std::string name;
 		bool artificial;
+		bool global;
 
 	public:
 		/// Creates new memory place.
-		MemoryPlace(std::string name, bool artificial): name(name),
-														artificial(artificial) {}
+		MemoryPlace(std::string name, bool artificial, bool global = false):
+			name(name), artificial(artificial), global(global) {}
 
 		/// Returns the name of the memory place (as it is represented in a
 		// program).
@@ -34,6 +35,10 @@ class MemoryPlace {
 		/// otehrwise.
 		bool isArtificial() const    { return artificial; }
 
+		/// Returns @c true if memory place outlives the calls of functions (it
+		/// belongs to a global or static variable), @c false otherwise.
+		bool isGlobal() const        { return global; }
+
 		bool representsElementOfArray() const;
 };
 
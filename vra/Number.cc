@@ -49,10 +49,66 @@ namespace {
 * @param[in] width Bit width of the type that was used to store @a value.
 * @param[in] sign Boolean flag specifies if the type is signed or unsigned.
 */
-Number::Number(Int value, unsigned width, bool sign)
-		:type(INT), intValue(value), sign(sign), bitWidth(width)
+Number::Number(int value, unsigned width, bool sign)
+		:type(INT), intValue(value), floatValue(0), sign(sign), bitWidth(width)
 {
-	setIntLimits();
+	checkIntBitWidth();
+	fitIntoBitWidth();
+}
+
+/**
+* @brief Constructs a new number from integral value, see the @c int overload.
+*/
+Number::Number(unsigned value, unsigned width, bool sign)
+		:type(INT), intValue(value), floatValue(0), sign(sign), bitWidth(width)
+{
+	checkIntBitWidth();
+	fitIntoBitWidth();
+}
+
+/**
+* @brief Constructs a new number from integral value, see the @c int overload.
+*/
+Number::Number(long value, unsigned width, bool sign)
+		:type(INT), intValue(value), floatValue(0), sign(sign), bitWidth(width)
+{
+	checkIntBitWidth();
+	fitIntoBitWidth();
+}
+
+/**
+* @brief Constructs a new number from integral value, see the @c int overload.
+*/
+Number::Number(unsigned long value, unsigned width, bool sign)
+		:type(INT), intValue(value), floatValue(0), sign(sign), bitWidth(width)
+{
+	checkIntBitWidth();
+	fitIntoBitWidth();
+}
+
+/**
+* @brief Constructs a new integral number from @a value truncated towards zero,
+*        in the same way as @c Int does it.
+*/
+Number::Number(double value, unsigned width, bool sign)
+		:type(INT), intValue(intToWide(Int(value))), floatValue(0), sign(sign),
+		 bitWidth(width)
+{
+	checkIntBitWidth();
+	fitIntoBitWidth();
+}
+
+/**
+* @brief Constructs a new number from integral value of an arbitrary size.
+*
+* The value does not need to fit into the given type, it is reduced in the
+* same way as the values of the other constructors are.
+*/
+Number::Number(const Int &value, unsigned width, bool sign)
+		:type(INT), intValue(intToWide(value)), floatValue(0), sign(sign),
+		 bitWidth(width)
+{
+	checkIntBitWidth();
 	fitIntoBitWidth();
 }
 
@@ -63,12 +119,61 @@ Number::Number(Int value, unsigned width, bool sign)
 * @param[in] width Bit width of the type that was used to store @a value.
 */
 Number::Number(Float value, unsigned width)
-		:type(FLOAT), floatValue(value), bitWidth(width)
+		:type(FLOAT), intValue(0), floatValue(value), sign(false), bitWidth(width)
 {
-	setFloatLimits();
+	checkFloatBitWidth();
 	fitIntoBitWidth();
 }
 
+/**
+* @brief Constructs a new integral number from an already computed @c Wide
+*        value, it is used to store results of the arithmetic.
+*/
+Number Number::fromWide(Wide value, unsigned width, bool sign)
+{
+	Number result(0, width, sign);
+	result.intValue = value;
+	result.fitIntoBitWidth();
+	return result;
+}
+
+/**
+* @brief Converts the given integer into @c Wide. Only the lowest 128 bits of
+*        the integer are kept, which is enough for fitIntoBitWidth().
+*/
+Number::Wide Number::intToWide(const Int &n)
+{
+	if (n.fits_slong_p())
+		return n.get_si();
+
+	// Take the non-negative remainder modulo 2^128 and compose it from two
+	// halves of 64 bits.
+	Int low;
+	mpz_fdiv_r_2exp(low.get_mpz_t(), n.get_mpz_t(), 128);
+	Int high;
+	mpz_fdiv_q_2exp(high.get_mpz_t(), low.get_mpz_t(), 64);
+	mpz_fdiv_r_2exp(low.get_mpz_t(), low.get_mpz_t(), 64);
+
+	const UWide result = (UWide(high.get_ui()) << 64) | UWide(low.get_ui());
+	return Wide(result);
+}
+
+/**
+* @brief Converts the given @c Wide value into an integer.
+*/
+Number::Int Number::wideToInt(Wide n)
+{
+	if (n >= numeric_limits<long>::min() && n <= numeric_limits<long>::max())
+		return Int(static_cast<long>(n));
+
+	// Compose the absolute value from two halves of 64 bits.
+	const UWide absValue = (n < 0) ? -UWide(n) : UWide(n);
+	Int result(static_cast<unsigned long>(absValue >> 64));
+	mpz_mul_2exp(result.get_mpz_t(), result.get_mpz_t(), 64);
+	result += static_cast<unsigned long>(absValue);
+	return (n < 0) ? Int(-result) : result;
+}
+
 /**
 * @brief Returns a number that would resulted if @a n was assigned into the
 *        current number in C.
@@ -100,16 +205,16 @@ Number Number::assign(const Number &n) const
 			//  inf      -2147483648
 			//  nan      -2147483648
 			if (n.isNotNumber() ||
-					n.floatValue < intToFloat(minIntLimit, isSigned()) ||
-					n.floatValue > intToFloat(maxIntLimit, isSigned())) {
-				result.intValue = minIntLimit;
+					n.floatValue < wideToFloat(minIntLimit(), isSigned()) ||
+					n.floatValue > wideToFloat(maxIntLimit(), isSigned())) {
+				result.intValue = minIntLimit();
 			} else {
-				result.intValue = floatToInt(n.floatValue);
+				result.intValue = intToWide(floatToInt(n.floatValue));
 			}
 		}
 	} else if (result.isFloatingPoint()) {
 		if (n.isIntegral()) {
-			result.floatValue = intToFloat(n.intValue, n.isSigned());
+			result.floatValue = wideToFloat(n.intValue, n.isSigned());
 		} else if (n.isFloatingPoint()) {
 			result.floatValue = n.floatValue;
 		}
@@ -119,57 +224,12 @@ Number Number::assign(const Number &n) const
 }
 
 /**
-* @brief Sets limits of an integral number.
+* @brief Checks that the bit width corresponds to an integral type.
 */
-void Number::setIntLimits()
+void Number::checkIntBitWidth() const
 {
-	// According to the bitWidth finds out which type was used to store
-	// the value and computes the suitable limits.
-	if (sizeof(char) == bitWidth) {
-		// Signed char.
-		if (isSigned()) {
-			minIntLimit = numeric_limits<signed char>::min();
-			maxIntLimit = numeric_limits<signed char>::max();
-		}
-		// Unsigned char.
-		else {
-			minIntLimit = numeric_limits<unsigned char>::min();
-			maxIntLimit = numeric_limits<unsigned char>::max();
-		}
-	} else if (sizeof(short) == bitWidth) {
-		// Signed short int.
-		if (isSigned()) {
-			minIntLimit = numeric_limits<signed short>::min();
-			maxIntLimit = numeric_limits<signed short>::max();
-		}
-		// Unsigned short int.
-		else {
-			minIntLimit = numeric_limits<unsigned short>::min();
-			maxIntLimit = numeric_limits<unsigned short>::max();
-		}
-	} else if (sizeof(int) == bitWidth) {
-		// Signed int.
-		if (isSigned()) {
-			minIntLimit = numeric_limits<signed int>::min();
-			maxIntLimit = numeric_limits<signed int>::max();
-		}
-		// Unsigned int.
-		else {
-			minIntLimit = numeric_limits<unsigned int>::min();
-			maxIntLimit = numeric_limits<unsigned int>::max();
-		}
-	} else if (sizeof(long) == bitWidth) {
-		// Signed long int.
-		if (isSigned()) {
-			minIntLimit = numeric_limits<signed long>::min();
-			maxIntLimit = numeric_limits<signed long>::max();
-		}
-		// Unsigned long int.
-		else {
-			minIntLimit = numeric_limits<unsigned long>::min();
-			maxIntLimit = numeric_limits<unsigned long>::max();
-		}
-	} else {
+	if (sizeof(char) != bitWidth && sizeof(short) != bitWidth &&
+			sizeof(int) != bitWidth && sizeof(long) != bitWidth) {
 		std::cerr << bitWidth << "\n";
 		// This should never happen.
 		assert(!"Provided bit width of the number does not correspond to bit"
@@ -178,28 +238,62 @@ void Number::setIntLimits()
 }
 
 /**
-* @brief Sets limits of a floating-point number.
+* @brief Checks that the bit width corresponds to a floating-point type.
 */
-void Number::setFloatLimits()
+void Number::checkFloatBitWidth() const
 {
-	// According to the bitWidth finds out which type was used to store
-	// the value and computes the suitable limits.
-	if (sizeof(float) == bitWidth) {
-		minFloatLimit = -numeric_limits<float>::max();
-		maxFloatLimit = numeric_limits<float>::max();
-	} else if (sizeof(double) == bitWidth) {
-		minFloatLimit = -numeric_limits<double>::max();
-		maxFloatLimit = numeric_limits<double>::max();
-	} else if (sizeof(long double) == bitWidth) {
-		minFloatLimit = -numeric_limits<long double>::max();
-		maxFloatLimit = numeric_limits<long double>::max();
-	} else {
+	if (sizeof(float) != bitWidth && sizeof(double) != bitWidth &&
+			sizeof(long double) != bitWidth) {
 		// This should never happen.
 		assert(!"Provided bit width of the number does not correspond to bit"
 			   "width of any floating-point type.");
 	}
 }
 
+/**
+* @brief Returns minimal value that can be stored in an integral number.
+*/
+Number::Wide Number::minIntLimit() const
+{
+	if (!isSigned())
+		return 0;
+
+	return -(Wide(1) << (getNumOfBits() - 1));
+}
+
+/**
+* @brief Returns maximal value that can be stored in an integral number.
+*/
+Number::Wide Number::maxIntLimit() const
+{
+	if (!isSigned())
+		return (Wide(1) << getNumOfBits()) - 1;
+
+	return (Wide(1) << (getNumOfBits() - 1)) - 1;
+}
+
+/**
+* @brief Returns minimal value that can be stored in a floating-point number.
+*/
+Number::Float Number::minFloatLimit() const
+{
+	return -maxFloatLimit();
+}
+
+/**
+* @brief Returns maximal value that can be stored in a floating-point number.
+*/
+Number::Float Number::maxFloatLimit() const
+{
+	if (sizeof(float) == bitWidth) {
+		return numeric_limits<float>::max();
+	} else if (sizeof(double) == bitWidth) {
+		return numeric_limits<double>::max();
+	} else { // sizeof(long double) == bitWidth
+		return numeric_limits<long double>::max();
+	}
+}
+
 /**
 * @brief Returns @c true if the number is an integer, @c false otherwise.
 *
@@ -307,9 +401,9 @@ bool Number::isNumber() const
 */
 bool Number::isMin() const {
 	if (isIntegral()) {
-		return intValue == minIntLimit;
+		return intValue == minIntLimit();
 	} else { // isFloatingPoint()
-		return floatValue == minFloatLimit;
+		return floatValue == minFloatLimit();
 	}
 }
 
@@ -319,9 +413,9 @@ bool Number::isMin() const {
 */
 bool Number::isMax() const {
 	if (isIntegral()) {
-		return intValue == maxIntLimit;
+		return intValue == maxIntLimit();
 	} else { // isFloatingPoint()
-		return floatValue == maxFloatLimit;
+		return floatValue == maxFloatLimit();
 	}
 }
 
@@ -351,9 +445,9 @@ Number Number::getEpsilon() const {
 Number Number::getMin() const
 {
 	if (isIntegral()) {
-		return Number(minIntLimit, bitWidth, isSigned());
+		return fromWide(minIntLimit(), bitWidth, isSigned());
 	} else { // isFloatingPoint()
-		return Number(minFloatLimit, bitWidth);
+		return Number(minFloatLimit(), bitWidth);
 	}
 }
 
@@ -363,9 +457,9 @@ Number Number::getMin() const
 Number Number::getMax() const
 {
 	if (isIntegral()) {
-		return Number(maxIntLimit, bitWidth, isSigned());
+		return fromWide(maxIntLimit(), bitWidth, isSigned());
 	} else { // isFloatingPoint()
-		return Number(maxFloatLimit, bitWidth);
+		return Number(maxFloatLimit(), bitWidth);
 	}
 }
 
@@ -402,7 +496,7 @@ Number Number::getNegativeInf() const
 Number::Int Number::getInt() const
 {
 	assert(isIntegral());
-	return intValue;
+	return wideToInt(intValue);
 }
 
 /**
@@ -451,21 +545,6 @@ void Number::integralPromotion()
 	if (bitWidth < sizeof(int)) {
 		bitWidth = sizeof(int);
 		sign = true;
-		setIntLimits();
-	}
-}
-
-/**
-* @brief Sets new integral value. It is used after the conversion from signed
-*        integral type to the unsigned integral type. Setting value is performed
-*        according to the C99 standard.
-*/
-void Number::convertSignedToUnsigned()
-{
-	if (intValue < 0) {
-		Int max = maxIntLimit + 1;
-		Int tmp = -(intValue / max) + 1;
-		intValue = intValue + tmp * max;
 	}
 }
 
@@ -516,10 +595,9 @@ pair<Number,Number> Number::extensionByCRules(Number first, Number second)
 		// the other operand is converted, without change of type domain, to a type
 		// whose corresponding real type is float.
 		if (second.isIntegral())
-			second.floatValue = intToFloat(second.intValue, second.isSigned());
+			second.floatValue = wideToFloat(second.intValue, second.isSigned());
 		second.type = first.type;
 		second.bitWidth = first.bitWidth;
-		second.setFloatLimits();
 	} else if (first.isIntegral()) {
 		// Otherwise, the integer promotions are performed on both operands.
 		first.integralPromotion();
@@ -529,10 +607,8 @@ pair<Number,Number> Number::extensionByCRules(Number first, Number second)
 			// have unsigned integer types, the operand with the type of lesser
 			// integer conversion rank is converted to the type of the operand
 			// with greater rank.
-			if (first.bitWidth > second.bitWidth) {
+			if (first.bitWidth > second.bitWidth)
 				second.bitWidth = first.bitWidth;
-				second.setIntLimits();
-			}
 		} else if (first.isUnsigned() && second.isSigned()) {
 			// Otherwise, if the operand that has unsigned integer type has rank
 			// greater or equal to the rank of the type of the other operand,
@@ -540,8 +616,7 @@ pair<Number,Number> Number::extensionByCRules(Number first, Number second)
 			// type of the operand with unsigned integer type.
 			second.bitWidth = first.bitWidth;
 			second.sign = false;
-			second.setIntLimits();
-			second.convertSignedToUnsigned();
+			second.fitIntoBitWidth();
 		} else if (first.isSigned() && second.isUnsigned()) {
 			// Otherwise, if the type of the operand with signed integer type
 			// can represent all of the values of the type of the operand with
@@ -551,14 +626,12 @@ pair<Number,Number> Number::extensionByCRules(Number first, Number second)
 			if (first.bitWidth > second.bitWidth) {
 				second.bitWidth = first.bitWidth;
 				second.sign = true;
-				second.setIntLimits();
 			} else if (first.bitWidth == second.bitWidth) {
 				// Otherwise, both operands are converted to the unsigned
 				// integer type corresponding to the type of the operand with
 				// signed integer type.
 				first.sign = false;
-				first.setIntLimits();
-				first.convertSignedToUnsigned();
+				first.fitIntoBitWidth();
 			}
 		}
 	}
@@ -602,6 +675,18 @@ Number::Float Number::intToFloat(const Int &n, bool isSigned) {
 	}
 }
 
+/**
+* @brief Converts the given @c Wide value into a floating-point number, in the
+*        same way as intToFloat() does.
+*/
+Number::Float Number::wideToFloat(Wide n, bool isSigned) {
+	if (isSigned) {
+		return Float(static_cast<long>(n));
+	} else {
+		return Float(static_cast<unsigned long>(n));
+	}
+}
+
 /**
 * @brief According to the type of the number, converts its value to the predefined
 *        limits.
@@ -609,22 +694,18 @@ Number::Float Number::intToFloat(const Int &n, bool isSigned) {
 void Number::fitIntoBitWidth()
 {
 	if (isIntegral()) {
-		if (isSigned()) {
-			Int valuesInBitWidth = 2 * maxIntLimit + 2;
-			intValue -= minIntLimit;
-			if (intValue < 0) {
-				intValue += (-intValue / valuesInBitWidth + 1) * valuesInBitWidth;
-			}
-			intValue %= valuesInBitWidth;
-			intValue += minIntLimit;
-		} else {
-			convertSignedToUnsigned();
-			intValue = intValue % (maxIntLimit + 1);
-		}
+		// The value wraps around modulo 2^bits, which is what keeping the
+		// lowest bits of its two's complement representation does.
+		const unsigned bits = getNumOfBits();
+		const UWide low = UWide(intValue) & ((UWide(1) << bits) - 1);
+		if (isSigned() && low > UWide(maxIntLimit()))
+			intValue = Wide(low) - (Wide(1) << bits);
+		else
+			intValue = Wide(low);
 	} else if (isFloatingPoint()) {
-		if (floatValue > maxFloatLimit)
+		if (floatValue > maxFloatLimit())
 			floatValue = INFINITY;
-		else if (floatValue < minFloatLimit)
+		else if (floatValue < minFloatLimit())
 			floatValue = -INFINITY;
 	}
 }
@@ -852,10 +933,8 @@ Number operator+(const Number& op1, const Number& op2)
 	Number &n2 = r.second;
 
 	if (n1.isIntegral() && n2.isIntegral()) {
-		Number::Int newValue = n1.intValue + n2.intValue;
-		Number result(newValue, n1.bitWidth, n1.sign);
-		result.fitIntoBitWidth();
-		return result;
+		return Number::fromWide(n1.intValue + n2.intValue, n1.bitWidth,
+				n1.sign);
 	} else if (n1.isFloatingPoint() && n2.isFloatingPoint()) {
 		Number::Float newValue = n1.floatValue + n2.floatValue;
 		Number result(newValue, n1.bitWidth);
@@ -901,10 +980,8 @@ Number operator-(const Number& op1, const Number& op2)
 	Number &n2 = r.second;
 
 	if (n1.isIntegral() && n2.isIntegral()) {
-		Number::Int newValue = n1.intValue - n2.intValue;
-		Number result(newValue, n1.bitWidth, n1.sign);
-		result.fitIntoBitWidth();
-		return result;
+		return Number::fromWide(n1.intValue - n2.intValue, n1.bitWidth,
+				n1.sign);
 	} else if (n1.isFloatingPoint() && n2.isFloatingPoint()) {
 		Number::Float newValue = n1.floatValue - n2.floatValue;
 		Number result(newValue, n1.bitWidth);
@@ -950,10 +1027,10 @@ Number operator*(const Number& op1, const Number& op2)
 	Number &n2 = r.second;
 
 	if (n1.isIntegral() && n2.isIntegral()) {
-		Number::Int newValue = n1.intValue * n2.intValue;
-		Number result(newValue, n1.bitWidth, n1.sign);
-		result.fitIntoBitWidth();
-		return result;
+		// The product may not fit into Wide, but its lowest bits are correct.
+		Number::UWide newValue = Number::UWide(n1.intValue) *
+			Number::UWide(n2.intValue);
+		return Number::fromWide(Number::Wide(newValue), n1.bitWidth, n1.sign);
 	} else if (n1.isFloatingPoint() && n2.isFloatingPoint()) {
 		Number::Float newValue = n1.floatValue * n2.floatValue;
 		Number result(newValue, n1.bitWidth);
@@ -1031,11 +1108,7 @@ Number exact_div(const Number& op1, const Number& op2)
 	Number &n1 = r.first;
 	Number &n2 = r.second;
 
-	Number::Int newValue = n1.intValue / n2.intValue;
-	Number result(newValue, n1.bitWidth, n1.sign);
-	result.fitIntoBitWidth();
-
-	return result;
+	return Number::fromWide(n1.intValue / n2.intValue, n1.bitWidth, n1.sign);
 }
 
 /**
@@ -1061,12 +1134,12 @@ Number Number::performTrunc(const Number &op1, const Number& op2, bool isMod)
 	Number &n2 = r.second;
 
 	// Performs operation on the C integral type.
-	Number::Int res;
+	Number::Wide res = 0;
 	if ((sizeof(int) == n1.bitWidth)) {
 		if (n1.isSigned()) {
 			int oper1, oper2;
-			oper1 = mpz_get_si(n1.intValue.get_mpz_t());
-			oper2 = mpz_get_si(n2.intValue.get_mpz_t());
+			oper1 = n1.intValue;
+			oper2 = n2.intValue;
 			if (isMod) {
 				// Computes modulo.
 				res = oper1 % oper2;
@@ -1076,8 +1149,8 @@ Number Number::performTrunc(const Number &op1, const Number& op2, bool isMod)
 			}
 		} else {
 			unsigned oper1, oper2;
-			oper1 = mpz_get_ui(n1.intValue.get_mpz_t());
-			oper2 = mpz_get_ui(n2.intValue.get_mpz_t());
+			oper1 = n1.intValue;
+			oper2 = n2.intValue;
 			if (isMod) {
 				// Computes modulo.
 				res = oper1 % oper2;
@@ -1089,8 +1162,8 @@ Number Number::performTrunc(const Number &op1, const Number& op2, bool isMod)
 	} else if ((sizeof(long) == n1.bitWidth)) {
 		if (n1.isSigned()) {
 			long oper1, oper2;
-			oper1 = mpz_get_si(n1.intValue.get_mpz_t());
-			oper2 = mpz_get_si(n2.intValue.get_mpz_t());
+			oper1 = n1.intValue;
+			oper2 = n2.intValue;
 			if (isMod) {
 				// Computes modulo.
 				res = oper1 % oper2;
@@ -1100,8 +1173,8 @@ Number Number::performTrunc(const Number &op1, const Number& op2, bool isMod)
 			}
 		} else {
 			unsigned long oper1, oper2;
-			oper1 = mpz_get_ui(n1.intValue.get_mpz_t());
-			oper2 = mpz_get_ui(n2.intValue.get_mpz_t());
+			oper1 = n1.intValue;
+			oper2 = n2.intValue;
 			if (isMod) {
 				// Computes modulo.
 				res = oper1 % oper2;
@@ -1112,9 +1185,7 @@ Number Number::performTrunc(const Number &op1, const Number& op2, bool isMod)
 		}
 	}
 
-	Number result = Number(res, n1.bitWidth, n1.sign);
-	result.fitIntoBitWidth();
-	return result;;
+	return Number::fromWide(res, n1.bitWidth, n1.sign);
 }
 
 /**
@@ -1200,10 +1271,8 @@ Number bitNot(const Number& op)
 
 	Number promotedOp = op;
 	promotedOp.integralPromotion();
-	Number::Int result;
-	mpz_com(result.get_mpz_t(), promotedOp.intValue.get_mpz_t());
-
-	return Number(result, promotedOp.bitWidth, promotedOp.sign);
+	return Number::fromWide(~promotedOp.intValue, promotedOp.bitWidth,
+			promotedOp.sign);
 }
 
 /**
@@ -1228,28 +1297,25 @@ Number Number::performBitOp(const Number &op1, const Number &op2, char mode)
 	Number &n1 = r.first;
 	Number &n2 = r.second;
 
-	Number::Int res;
+	Number::Wide res = 0;
 	switch (mode) {
 		case 'A':
 			// Performs bit and.
-			mpz_and(res.get_mpz_t(), n1.intValue.get_mpz_t(),
-					n2.intValue.get_mpz_t());
+			res = n1.intValue & n2.intValue;
 			break;
 
 		case 'O':
 			// Performs bit or.
-			mpz_ior(res.get_mpz_t(), n1.intValue.get_mpz_t(),
-					n2.intValue.get_mpz_t());
+			res = n1.intValue | n2.intValue;
 			break;
 
 		case 'X':
 			// Performs bit xor.
-			mpz_xor(res.get_mpz_t(), n1.intValue.get_mpz_t(),
-					n2.intValue.get_mpz_t());
+			res = n1.intValue ^ n2.intValue;
 			break;
 	}
 
-	return Number(res, n1.bitWidth, n1.sign);
+	return Number::fromWide(res, n1.bitWidth, n1.sign);
 }
 
 /**
@@ -1298,38 +1364,36 @@ Number Number::performShift(Number op1, Number op2, bool isLeft)
 	// is used in the Range class. It must be after integralPromotion()!
 	assert(op1.bitWidth * CHAR_BIT > op2.intValue);
 
-	// Shift are not defined for Int, so we have to use left shift from C.
-	// We have to store Int values into C types.
-	Number::Int res;
+	// Shifts are performed on the C types in order to get the same results
+	// for signed values as C gives.
+	Number::Wide res = 0;
 	if ((sizeof(int) == op1.bitWidth)) {
 		if (op1.isSigned()) {
 			int signedOP1, signedOP2;
-			signedOP1 = mpz_get_si(op1.intValue.get_mpz_t());
-			signedOP2 = mpz_get_si(op2.intValue.get_mpz_t());
+			signedOP1 = op1.intValue;
+			signedOP2 = op2.intValue;
 			res = isLeft ? (signedOP1 << signedOP2) : (signedOP1 >> signedOP2);
 		} else {
 			unsigned signedOP1, signedOP2;
-			signedOP1 = mpz_get_ui(op1.intValue.get_mpz_t());
-			signedOP2 = mpz_get_ui(op2.intValue.get_mpz_t());
+			signedOP1 = op1.intValue;
+			signedOP2 = op2.intValue;
 			res = isLeft ? (signedOP1 << signedOP2) : (signedOP1 >> signedOP2);
 		}
 	} else if ((sizeof(long) == op1.bitWidth)) {
 		if (op1.isSigned()) {
 			long signedOP1, signedOP2;
-			signedOP1 = mpz_get_si(op1.intValue.get_mpz_t());
-			signedOP2 = mpz_get_si(op2.intValue.get_mpz_t());
+			signedOP1 = op1.intValue;
+			signedOP2 = op2.intValue;
 			res = isLeft ? (signedOP1 << signedOP2) : (signedOP1 >> signedOP2);
 		} else {
 			unsigned long signedOP1, signedOP2;
-			signedOP1 = mpz_get_ui(op1.intValue.get_mpz_t());
-			signedOP2 = mpz_get_ui(op2.intValue.get_mpz_t());
+			signedOP1 = op1.intValue;
+			signedOP2 = op2.intValue;
 			res = isLeft ? (signedOP1 << signedOP2) : (signedOP1 >> signedOP2);
 		}
 	}
 
-	Number result = Number(res, op1.bitWidth, op1.sign);
-	result.fitIntoBitWidth();
-	return result;
+	return Number::fromWide(res, op1.bitWidth, op1.sign);
 }
 
 /**
@@ -1382,9 +1446,9 @@ Number intToFloat(const Number& op)
 {
 	assert(op.isIntegral());
 	if (op.sign) {
-		return Number((float) mpz_get_si(op.intValue.get_mpz_t()), sizeof(float));
+		return Number((float) static_cast<long>(op.intValue), sizeof(float));
 	} else {
-		return Number((float) mpz_get_ui(op.intValue.get_mpz_t()), sizeof(float));
+		return Number((float) static_cast<unsigned long>(op.intValue), sizeof(float));
 	}
 }
 
@@ -1427,8 +1491,13 @@ Number max(const Number &op1, const Number &op2)
 */
 ostream& operator<<(ostream &os, const Number &n)
 {
-	if (n.isIntegral())
-		os << n.intValue;
+	if (n.isIntegral()) {
+		// The value fits into long or unsigned long, see fitIntoBitWidth().
+		if (n.sign)
+			os << static_cast<long>(n.intValue);
+		else
+			os << static_cast<unsigned long>(n.intValue);
+	}
 	else if (n.isFloatingPoint()) {
 		os << n.floatValue;
 	}
@@ -12,6 +12,8 @@
 #include <string>
 #include <ostream>
 #include <utility>
+// gmpxx.h uses std::size_t without including <cstddef> on its own
+#include <cstddef>
 #include <gmpxx.h>
 
 /**
@@ -34,6 +36,16 @@ class Number {
 		/// Biggest integer.
 		typedef mpz_class Int;
 
+		/// Integer used to store integral values inline. It holds every value
+		/// of a supported integral type (at most 64 bits) together with the
+		/// intermediate results of additive operations on them, so GMP is
+		/// needed only to convert from and to @c Int.
+		__extension__ typedef __int128 Wide;
+
+		/// Unsigned counterpart of @c Wide. Products are computed in it
+		/// modulo 2^128, which preserves their value modulo 2^64.
+		__extension__ typedef unsigned __int128 UWide;
+
 		/// Biggest float.
 		typedef long double Float;
 
@@ -41,7 +53,7 @@ class Number {
 		Type type;
 
 		/// Value of the number if @c type of the number is @c INT.
-		Int intValue;
+		Wide intValue;
 
 		/// Value of the number if @c type of the number is @c FLOAT.
 		Float floatValue;
@@ -53,34 +65,34 @@ class Number {
 		/// Bit width of the represented number.
 		unsigned bitWidth;
 
-		/// Minimal value that can be stored in the number. It is used only if
-		/// @c type of the number is @c INT.
-		Int minIntLimit;
-
-		/// Maximal value that can be stored in the number. It is used only if
-		/// @c type of the number is @c INT.
-		Int maxIntLimit;
+		// The limits of the number are derived from (bitWidth, sign) on demand,
+		// so that copying a number does not need to copy them.
+		Wide minIntLimit() const;
+		Wide maxIntLimit() const;
+		Float minFloatLimit() const;
+		Float maxFloatLimit() const;
 
-		/// Minimal value that can be stored in the number. It is used only if
-		/// @c type of the number is @c FLOAT.
-		Float minFloatLimit;
-
-		/// Maximal value that can be stored in the number. It is used only if
-		/// @c type of the number is @c FLOAT.
-		Float maxFloatLimit;
-
-		void setIntLimits();
-		void setFloatLimits();
+		void checkIntBitWidth() const;
+		void checkFloatBitWidth() const;
 		void fitIntoBitWidth();
 		void integralPromotion();
-		void convertSignedToUnsigned();
+
+		static Number fromWide(Wide value, unsigned width, bool sign);
+		static Wide intToWide(const Int &n);
+		static Int wideToInt(Wide n);
+		static Float wideToFloat(Wide n, bool isSigned);
 
 		static Number performTrunc(const Number &op1, const Number &op2, bool isMod);
 		static Number performBitOp(const Number &op1, const Number &op2, char mode);
 		static Number performShift(Number op1, Number op2, bool isLeft);
 
 	public:
-		Number(Int value, unsigned width, bool sign);
+		Number(int value, unsigned width, bool sign);
+		Number(unsigned value, unsigned width, bool sign);
+		Number(long value, unsigned width, bool sign);
+		Number(unsigned long value, unsigned width, bool sign);
+		Number(double value, unsigned width, bool sign);
+		Number(const Int &value, unsigned width, bool sign);
 		Number(Float value, unsigned width);
 
 		Number assign(const Number &n) const;
@@ -11,6 +11,7 @@
 #include <string>
 #include <cassert>
 #include <iostream>
+#include <pthread.h>
 #include "OperandToMemoryPlace.h"
 
 using std::string;
@@ -20,6 +21,32 @@ using std::deque;
 
 map<OperandToMemoryPlace::UidVector, MemoryPlace*>
 	OperandToMemoryPlace::memoryPlaceMap;
+pthread_mutex_t OperandToMemoryPlace::memoryPlaceMapLock = PTHREAD_MUTEX_INITIALIZER;
+
+/**
+* @brief Returns the memory place stored for @a uidVector. If there is no such
+*        memory place, a new one is created from @a name, @a artificial and
+*        @a global.
+*
+* The functions are analysed concurrently, so the access to @c memoryPlaceMap
+* is serialized.
+*/
+MemoryPlace* OperandToMemoryPlace::lookup(const UidVector &uidVector,
+										  const string &name, bool artificial,
+										  bool global)
+{
+	pthread_mutex_lock(&OperandToMemoryPlace::memoryPlaceMapLock);
+
+	MemoryPlace *&var = OperandToMemoryPlace::memoryPlaceMap[uidVector];
+	if (NULL == var) {
+		// This variable is used for the first time.
+		var = new MemoryPlace(name, artificial, global);
+	}
+
+	MemoryPlace *result = var;
+	pthread_mutex_unlock(&OperandToMemoryPlace::memoryPlaceMapLock);
+	return result;
+}
 
 /**
 * @brief Converts @c cl_operand to the instance of the @c MemoryPlace class. Used only
@@ -52,6 +79,9 @@ MemoryPlace* OperandToMemoryPlace::convertSimpleOperand(const cl_operand *operan
 		artificial = true;
 	}
 
+	// Stores if the variable outlives the calls of functions.
+	bool global = (CL_SCOPE_FUNCTION != operand->scope);
+
 	// Stores the unique id of the variable.
 	Int uid = ((operand->data).var)->uid;
 
@@ -61,15 +91,7 @@ MemoryPlace* OperandToMemoryPlace::convertSimpleOperand(const cl_operand *operan
 
 	if (NULL == operand->accessor) {
 		// If the given cl_operand represents a simple variable.
-		if (OperandToMemoryPlace::memoryPlaceMap.count(uidVector) == 0) {
-			// This variable is used for the first time.
-			MemoryPlace *var = new MemoryPlace(name, artificial);
-			OperandToMemoryPlace::memoryPlaceMap[uidVector] = var;
-			return var;
-		} else {
-			// This variable was used before. We return found record.
-			return OperandToMemoryPlace::memoryPlaceMap[uidVector];
-		}
+		return OperandToMemoryPlace::lookup(uidVector, name, artificial, global);
 	} else if (CL_ACCESSOR_ITEM == (operand->accessor)->code ||
 			   CL_ACCESSOR_DEREF_ARRAY == (operand->accessor)->code) {
 		// If the given cl_operand represents an item of a structure or
@@ -92,15 +114,7 @@ MemoryPlace* OperandToMemoryPlace::convertSimpleOperand(const cl_operand *operan
 			actualAccessor = actualAccessor->next;
 		}
 
-		if (OperandToMemoryPlace::memoryPlaceMap.count(uidVector) == 0) {
-			// This variable is used for the first time.
-			MemoryPlace *var = new MemoryPlace(name, artificial);
-			OperandToMemoryPlace::memoryPlaceMap[uidVector] = var;
-			return var;
-		} else {
-			// This variable was used before. We return found record.
-			return OperandToMemoryPlace::memoryPlaceMap[uidVector];
-		}
+		return OperandToMemoryPlace::lookup(uidVector, name, artificial, global);
 	}
 
 	assert(!"Memory place cannot be created for the provided cl_operand.");
@@ -140,6 +154,9 @@ MemoryPlace* OperandToMemoryPlace::convert(const cl_operand *operand,
 	// Stores if the variable was generated by the compiler.
 	bool artificial = ((operand->data).var)->artificial;
 
+	// Stores if the variable outlives the calls of functions.
+	bool global = (CL_SCOPE_FUNCTION != operand->scope);
+
 	// Stores the unique id of the variable.
 	Int uid = ((operand->data).var)->uid;
 
@@ -176,15 +193,7 @@ MemoryPlace* OperandToMemoryPlace::convert(const cl_operand *operand,
 		currentType = ((currentType->items)[index]).type;
 	}
 
-	if (OperandToMemoryPlace::memoryPlaceMap.count(uidVector) == 0) {
-		// This variable is used for the first time.
-		MemoryPlace *var = new MemoryPlace(name, artificial);
-		OperandToMemoryPlace::memoryPlaceMap[uidVector] = var;
-		return var;
-	} else {
-		// This variable was used before. We return found record.
-		return OperandToMemoryPlace::memoryPlaceMap[uidVector];
-	}
+	return OperandToMemoryPlace::lookup(uidVector, name, artificial, global);
 
 	assert(!"Memory places does not created for provided cl_operand.");
 	return new MemoryPlace("", true);
@@ -11,7 +11,10 @@
 #include <vector>
 #include <map>
 #include <deque>
+#include <string>
+#include <pthread.h>
 #include <cl/code_listener.h>
+#include <cstddef>
 #include <gmpxx.h>
 #include "MemoryPlace.h"
 
@@ -35,6 +38,13 @@ class OperandToMemoryPlace {
 		/// Map that for each @c UidVector stores corresponding @c MemoryPlace.
 		static std::map<UidVector, MemoryPlace*> memoryPlaceMap;
 
+		/// Serializes the access to @c memoryPlaceMap.
+		static pthread_mutex_t memoryPlaceMapLock;
+
+		static MemoryPlace* lookup(const UidVector &uidVector,
+								   const std::string &name, bool artificial,
+								   bool global);
+
 		static MemoryPlace* convertSimpleOperand(const cl_operand *operand);
 
 	public:
@@ -46,10 +46,41 @@ bool compareLowerBounds(const Range::Interval &i1, const Range::Interval &i2)
 		   (i1.first == i2.first && i1.second < i2.second);
 }
 
+/**
+* @brief Finds the nearest threshold that is not lower (@a up is @c true) or not
+*        higher (@a up is @c false) than @a n.
+*
+* Only the thresholds representable in the type of @a n are considered. If there
+* is no such threshold, the maximal (or minimal) number of the type is returned.
+*/
+Number findThreshold(const Number &n, const vector<Number> &thresholds, bool up)
+{
+	Number result = (up) ? n.getMax() : n.getMin();
+	for (vector<Number>::const_iterator it = thresholds.begin();
+			it != thresholds.end(); ++it) {
+		if (!it->isIntegral())
+			continue;
+
+		const Number t = n.assign(*it);
+		if (t.getInt() != it->getInt()) {
+			// The threshold does not fit into the type of n.
+			continue;
+		}
+
+		if (up && n <= t && t < result)
+			result = t;
+		else if (!up && t <= n && result < t)
+			result = t;
+	}
+
+	return result;
+}
+
 }
 
 // Definition of static variables and constants.
 const size_t Range::MAX_INTERVALS_IN_RANGE;
+const size_t Range::INLINE_INTERVALS;
 
 /**
 * @brief Constructs an empty range.
@@ -130,7 +161,8 @@ Range::Range(Interval i1, Interval i2, Interval i3, Interval i4)
 *
 * It edits intervals, so the lower bounds are always lower or equal than upper
 * bounds. It sorts intervals in the vector according to the numerical order and
-* if intervals are overlapping or neighbouring it joins them together.
+* if intervals are overlapping or neighbouring it joins them together. All the
+* steps are done in place.
 */
 void Range::normalize()
 {
@@ -138,48 +170,36 @@ void Range::normalize()
 	if (data.size() == 0)
 		return;
 
-	// Only one NAN interval is kept.
-	vector<Interval> tmp;
+	// Only one NAN interval is kept. Intervals with the lower bound greater
+	// than the upper bound are split, the upper part is appended to the end.
+	const size_type origSize = data.size();
+	size_type kept = 0;
 	bool isNanThere = false;
-	for (iterator it = data.begin(); it != data.end(); ++it) {
-		if (it->first.isNotNumber() || it->second.isNotNumber()) {
+	for (size_type i = 0; i < origSize; ++i) {
+		const Interval current = data[i];
+		if (current.first.isNotNumber() || current.second.isNotNumber()) {
 			if (!isNanThere) {
 				// The first interval representing NAN is kept. Others are
 				// removed.
-				if (it->first.isNotNumber()) {
-					tmp.push_back(Interval(it->first, it->first));
-				} else {
-					tmp.push_back(Interval(it->second, it->second));
-				}
+				const Number &nan = (current.first.isNotNumber())
+					? current.first : current.second;
+				data[kept++] = Interval(nan, nan);
 				isNanThere = true;
 			}
-		} else {
-			// Everything except extra NAN intervals is kept.
-			tmp.push_back(*it);
-		}
-	}
-	swap(data, tmp);
-
-	// Pre-processing intervals.
-	tmp.clear();
-	for (iterator it = data.begin(); it != data.end(); ++it) {
-		if (it->first > it->second) {
+		} else if (current.first > current.second) {
 			// The lower bound is greater than the upper bound.
-			tmp.push_back(Interval(it->second.getMin(), it->second));
-			tmp.push_back(Interval(it->first, it->first.getMax()));
+			data[kept++] = Interval(current.second.getMin(), current.second);
+			data.push_back(Interval(current.first, current.first.getMax()));
 		} else {
 			// The lower bound is lower or equal than the upper bound.
-			tmp.push_back(*it);
+			data[kept++] = current;
 		}
 	}
-	swap(data, tmp);
+	data.erase(data.begin() + kept, data.begin() + origSize);
 
 	// Sorting intervals.
 	sort(data.begin(), data.end(), compareLowerBounds);
 
-	tmp.clear();
-	tmp.push_back(data.front());
-
 	// If the space between intervals is lower than or equal epsilon, they
 	// will be joined together.
 	Number epsilon(1, sizeof(int), true);
@@ -187,25 +207,26 @@ void Range::normalize()
 		epsilon = Number(0.1, sizeof(double));
 	}
 
-	// Joining intervals.
+	// Joining intervals, [begin, previous] are the already joined ones.
+	iterator previous = data.begin();
 	for (iterator current = data.begin() + 1; current != data.end(); current++) {
-		Interval previous = tmp.back();
 		// The second condition is necessary because of overflowing of the Number.
-		if (current->first <= previous.second ||
-			current->first <= previous.second + epsilon) {
+		if (current->first <= previous->second ||
+			current->first <= previous->second + epsilon) {
 			// The lower bound of currently processed interval is lower or equal
 			// than upper bound of the previous processed interval (intervals are
 			// neighbours or overlap).
-			Number lowerBound = std::min(previous.first, current->first);
-			Number upperBound = std::max(previous.second, current->second);
-			tmp.back() = Interval(lowerBound, upperBound);
+			if (current->first < previous->first)
+				previous->first = current->first;
+			if (previous->second < current->second)
+				previous->second = current->second;
 		} else {
 			// If it is not possible to join the last processed interval with the
 			// current one.
-			tmp.push_back(*current);
+			*++previous = *current;
 		}
 	}
-	swap(data, tmp);
+	data.erase(previous + 1, data.end());
 
 	// If there are too many intervals, merge them.
 	if (data.size() > MAX_INTERVALS_IN_RANGE) {
@@ -1354,6 +1375,56 @@ Range Range::expand() const {
 	return result;
 }
 
+/**
+* @brief Widens the current range with respect to the range @a r from the
+*        previous iteration.
+*
+* For integral ranges:
+*  - If the maximum has grown since @a r, it is raised to the nearest threshold
+*    from @a thresholds (or to the maximum of the type if there is none).
+*  - If the minimum has dropped since @a r, it is lowered to the nearest
+*    threshold (or to the minimum of the type if there is none).
+*  - If neither of them has moved, only the inner bounds are changing (e.g. a
+*    wrapped-around interval that keeps growing), so the intervals are merged.
+*
+* For floating-point ranges:
+*  - Returns the maximal range.
+*
+* The thresholds are typically the constants the variables are compared with
+* in the loop conditions, so the widened range is often exact.
+*/
+Range Range::widen(const Range &r, const std::vector<Number> &thresholds) const
+{
+	// I should always work with non-empty ranges.
+	assert(!empty() && !r.empty());
+
+	// For floating-points, return the maximal range.
+	if (isFloatingPoint()) {
+		return getMaxRange(data[0].first);
+	}
+
+	const bool maxGrown = getMax() > r.getMax();
+	const bool minDropped = getMin() < r.getMin();
+	if (!maxGrown && !minDropped) {
+		// There is only a finite number of thresholds, but the inner bounds
+		// could move step by step through the whole type.
+		return mergeIntervals();
+	}
+
+	Range result(*this);
+	Number &newMin = result.data.front().first;
+	Number &newMax = result.data.back().second;
+	if (maxGrown) {
+		newMax = findThreshold(newMax, thresholds, true);
+	}
+	if (minDropped) {
+		newMin = findThreshold(newMin, thresholds, false);
+	}
+
+	result.normalize();
+	return result;
+}
+
 /**
 * @brief Merges the intervals in the range.
 *
@@ -1703,13 +1774,15 @@ Range Range::performIntegralDivOp(const Range &r1, const Range &r2, bool exact)
 			const Number &z = jt->first;
 			const Number &w = jt->second;
 
+			// The divisor does not contain zero, so the quotient is monotone
+			// in both operands and its bounds are among the four corners.
 			Number xw = exact ? exact_div(x, w) : trunc_div(x, w);
 			Number xz = exact ? exact_div(x, z) : trunc_div(x, z);
-			result.data.push_back(Interval(std::min(xw, xz), std::max(xw, xz)));
-
 			Number yw = exact ? exact_div(y, w) : trunc_div(y, w);
 			Number yz = exact ? exact_div(y, z) : trunc_div(y, z);
-			result.data.push_back(Interval(std::min(yw, yz), std::max(yw, yz)));
+			result.data.push_back(Interval(
+				std::min(std::min(xw, xz), std::min(yw, yz)),
+				std::max(std::max(xw, xz), std::max(yw, yz))));
 		}
 	}
 
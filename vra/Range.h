@@ -12,6 +12,7 @@
 #include <utility>
 
 #include "Number.h"
+#include "SmallVector.h"
 
 /**
 * @brief Class that represents the value range of the variable.
@@ -22,23 +23,31 @@
 * the results of some operations are over-approximated.
 *
 * When a range has more than MAX_INTERVALS_IN_RANGE, mergeIntervals() is called.
+* Up to INLINE_INTERVALS intervals are stored inside the range itself, so that
+* most ranges do not need any heap allocation.
 */
 class Range {
 	public:
 		/// Definition of interval.
 		typedef std::pair<Number, Number> Interval;
 
+		/// Number of intervals stored without a heap allocation.
+		static const size_t INLINE_INTERVALS = 2;
+
+		/// Definition of the container of intervals.
+		typedef SmallVector<Interval, INLINE_INTERVALS> Intervals;
+
 		/// Definition of the iterator for the Range class.
-		typedef std::vector<Interval>::iterator iterator;
+		typedef Intervals::iterator iterator;
 
 		/// Definition of the constant iterator for the Range class.
-		typedef std::vector<Interval>::const_iterator const_iterator;
+		typedef Intervals::const_iterator const_iterator;
 
 		/// Definition of the reverse iterator for the Range class.
-		typedef std::vector<Interval>::reverse_iterator reverse_iterator;
+		typedef Intervals::reverse_iterator reverse_iterator;
 
 		/// Definition of the constant iterator for the Range class.
-		typedef std::vector<Interval>::const_reverse_iterator const_reverse_iterator;
+		typedef Intervals::const_reverse_iterator const_reverse_iterator;
 
 		/// Definition of the type for expressing size.
 		typedef size_t size_type;
@@ -88,6 +97,7 @@ class Range {
 
 		Range assign(const Range &r) const;
 		Range expand() const;
+		Range widen(const Range &r, const std::vector<Number> &thresholds) const;
 		Range mergeIntervals() const;
 
 		bool containsNan() const;
@@ -174,7 +184,7 @@ class Range {
 			extensionByCRules(const Range &r1, const Range &r2);
 
 		/// Stores the intervals.
-		std::vector<Interval> data;
+		Intervals data;
 
 		/// Maximal number of intervals in a range (after that,
 		/// mergeIntervals() is automatically called).
@@ -0,0 +1,211 @@
+/**
+* @author agent, agent@local
+* @file   SmallVector.h
+* @brief  Sequence container that keeps a few elements without allocation.
+* @date   2026
+*/
+
+#ifndef GUARD_SMALL_VECTOR_H
+#define GUARD_SMALL_VECTOR_H
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <new>
+
+#include <boost/type_traits/aligned_storage.hpp>
+#include <boost/type_traits/alignment_of.hpp>
+
+/**
+* @brief Sequence container with inline storage for up to @a N elements.
+*
+* It provides the subset of the interface of @c std::vector that is needed by
+* Range. The elements are stored inside the object itself until there are more
+* than @a N of them, then they are moved to a buffer allocated on the heap.
+* Iterators are plain pointers and they are invalidated by every insertion.
+*/
+template <typename T, std::size_t N>
+class SmallVector {
+	public:
+		typedef T value_type;
+		typedef T* iterator;
+		typedef const T* const_iterator;
+		typedef std::reverse_iterator<iterator> reverse_iterator;
+		typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+		typedef std::size_t size_type;
+
+		/// Constructs an empty container.
+		SmallVector(): ptr(inlineData()), count(0), cap(N) { }
+
+		/// Constructs a copy of @a v.
+		SmallVector(const SmallVector &v): ptr(inlineData()), count(0), cap(N) {
+			append(v.begin(), v.end());
+		}
+
+		~SmallVector() {
+			clear();
+			releaseHeap();
+		}
+
+		/// Assigns the elements of @a v to this container.
+		SmallVector& operator=(const SmallVector &v) {
+			if (this != &v) {
+				clear();
+				append(v.begin(), v.end());
+			}
+			return *this;
+		}
+
+		iterator begin()             { return ptr; }
+		const_iterator begin() const { return ptr; }
+		iterator end()               { return ptr + count; }
+		const_iterator end() const   { return ptr + count; }
+
+		reverse_iterator rbegin()             { return reverse_iterator(end()); }
+		const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+		reverse_iterator rend()               { return reverse_iterator(begin()); }
+		const_reverse_iterator rend() const   { return const_reverse_iterator(begin()); }
+
+		size_type size() const     { return count; }
+		size_type capacity() const { return cap; }
+		bool empty() const         { return count == 0; }
+
+		/// Returns @c true if the elements are stored inside the object.
+		bool isInline() const      { return ptr == inlineData(); }
+
+		T& operator[](size_type i)             { return ptr[i]; }
+		const T& operator[](size_type i) const { return ptr[i]; }
+		T& front()             { return ptr[0]; }
+		const T& front() const { return ptr[0]; }
+		T& back()              { return ptr[count - 1]; }
+		const T& back() const  { return ptr[count - 1]; }
+
+		/// Appends a copy of @a x, which may be an element of this container.
+		void push_back(const T &x) {
+			if (count == cap) {
+				grow(x);
+				return;
+			}
+			new (ptr + count) T(x);
+			++count;
+		}
+
+		/// Removes the last element.
+		void pop_back() {
+			--count;
+			ptr[count].~T();
+		}
+
+		/// Removes the elements in [@a first, @a last).
+		iterator erase(iterator first, iterator last) {
+			iterator newEnd = std::copy(last, end(), first);
+			while (end() != newEnd)
+				pop_back();
+			return first;
+		}
+
+		/// Removes all elements (the allocated buffer is kept).
+		void clear() {
+			while (count)
+				pop_back();
+		}
+
+		/// Makes sure that @a n elements can be stored without reallocation.
+		void reserve(size_type n) {
+			if (n > cap)
+				reallocate(n);
+		}
+
+		/// Swaps the contents of this container with @a v.
+		void swap(SmallVector &v) {
+			if (!isInline() && !v.isInline()) {
+				std::swap(ptr, v.ptr);
+				std::swap(count, v.count);
+				std::swap(cap, v.cap);
+				return;
+			}
+			SmallVector tmp(*this);
+			*this = v;
+			v = tmp;
+		}
+
+	private:
+		/// Storage for the inline elements.
+		typename boost::aligned_storage<sizeof(T) * N,
+			boost::alignment_of<T>::value>::type storage;
+
+		/// Stored elements (either inside storage or on the heap).
+		T *ptr;
+
+		/// Number of stored elements.
+		size_type count;
+
+		/// Number of elements that fit into the buffer pointed to by ptr.
+		size_type cap;
+
+		T* inlineData()             { return static_cast<T *>(storage.address()); }
+		const T* inlineData() const {
+			return static_cast<const T *>(storage.address());
+		}
+
+		void append(const_iterator first, const_iterator last) {
+			reserve(count + (last - first));
+			for (; first != last; ++first)
+				push_back(*first);
+		}
+
+		/// Moves the elements into a heap buffer for @a n elements.
+		void reallocate(size_type n) {
+			T *newPtr = static_cast<T *>(::operator new(n * sizeof(T)));
+			for (size_type i = 0; i < count; ++i) {
+				new (newPtr + i) T(ptr[i]);
+				ptr[i].~T();
+			}
+			releaseHeap();
+			ptr = newPtr;
+			cap = n;
+		}
+
+		/// Appends @a x to the full container (@a x may be one of its elements).
+		void grow(const T &x) {
+			const size_type newCap = 2 * count + 1;
+			T *newPtr = static_cast<T *>(::operator new(newCap * sizeof(T)));
+			new (newPtr + count) T(x);
+			for (size_type i = 0; i < count; ++i) {
+				new (newPtr + i) T(ptr[i]);
+				ptr[i].~T();
+			}
+			releaseHeap();
+			ptr = newPtr;
+			cap = newCap;
+			++count;
+		}
+
+		void releaseHeap() {
+			if (!isInline())
+				::operator delete(ptr);
+		}
+};
+
+/// Swaps the contents of the containers @a v1 and @a v2.
+template <typename T, std::size_t N>
+inline void swap(SmallVector<T, N> &v1, SmallVector<T, N> &v2)
+{
+	v1.swap(v2);
+}
+
+/// Returns @c true if both containers hold equal elements in the same order.
+template <typename T, std::size_t N>
+inline bool operator==(const SmallVector<T, N> &v1, const SmallVector<T, N> &v2)
+{
+	return v1.size() == v2.size() && std::equal(v1.begin(), v1.end(), v2.begin());
+}
+
+/// Returns @c true if the containers differ.
+template <typename T, std::size_t N>
+inline bool operator!=(const SmallVector<T, N> &v1, const SmallVector<T, N> &v2)
+{
+	return !(v1 == v2);
+}
+
+#endif
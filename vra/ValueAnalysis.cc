@@ -9,6 +9,8 @@
 #undef NDEBUG   // It is necessary for using assertions.
 
 #include <boost/foreach.hpp>
+#include <cl/clutil.hh>
+#include <cl/parallel.hh>
 #include <iostream>
 #include <cassert>
 #include <iterator>
@@ -35,15 +37,9 @@ using std::deque;
 using std::sort;
 using std::pair;
 
-ValueAnalysis::BlockToTrimmedRangesMap ValueAnalysis::blockToTrimmedRangesMap;
-ValueAnalysis::BlockToResultMap ValueAnalysis::blockToInputRangesMap;
-ValueAnalysis::BlockToResultMap ValueAnalysis::blockToOutputRangesMap;
-ValueAnalysis::SchedulerQueue ValueAnalysis::todoQueue;
-ValueAnalysis::SchedulerSet ValueAnalysis::todoSet;
-ValueAnalysis::BlockToCounterMap ValueAnalysis::blockToCounterMap;
-LoopFinder::BlockToUpperLimit ValueAnalysis::tripCountOfBlockMap;
-
+const unsigned ValueAnalysis::NumberOfPassesBeforeWidening = 3;
 const unsigned ValueAnalysis::NumberOfPassesBeforeExpand = 1000;
+const unsigned ValueAnalysis::NumberOfNarrowingPasses = 2;
 
 namespace {
 
@@ -57,6 +53,154 @@ bool sortBlockInfo(const ValueAnalysis::MemoryPlaceRangePair &f,
 	return f.first->asString() < s.first->asString();
 }
 
+/**
+* @brief Returns @c true if ranges can be computed for values of the given @a type.
+*/
+bool isSupportedType(const struct cl_type *type)
+{
+	switch (type->code) {
+		case CL_TYPE_INT:
+		case CL_TYPE_BOOL:
+		case CL_TYPE_REAL:
+		case CL_TYPE_ENUM:
+			return true;
+
+		default:
+			return false;
+	}
+}
+
+/**
+* @brief Returns @c true if the given @a block belongs to the loop with the given
+*        @a header.
+*/
+bool isInLoop(const Fnc &fnc, const Block *block, const Block *header)
+{
+	for (; block; block = fnc.cfg.loopInfo(block).loopHeader) {
+		if (block == header)
+			return true;
+	}
+
+	return false;
+}
+
+/**
+* @brief Gets the targets of the given @a block into @a targets, the depth-first
+*        search takes them from the back. The targets that leave the innermost
+*        loop of @a block are at the back, so the search finishes them first and
+*        the blocks of a loop precede its exits in reverse postorder.
+*/
+void getOrderedTargets(const Fnc &fnc, const Block *block, TTargetList &targets)
+{
+	const CodeStorage::BlockLoopInfo &info = fnc.cfg.loopInfo(block);
+	const Block *header = (info.isLoopHeader) ? block : info.loopHeader;
+
+	TTargetList exits;
+	BOOST_FOREACH(const Block *target, block->targets()) {
+		if (header && isInLoop(fnc, target, header))
+			targets.push_back(target);
+		else
+			exits.push_back(target);
+	}
+
+	targets.insert(targets.end(), exits.begin(), exits.end());
+}
+
+/**
+* @brief Returns the range @a r narrowed by the range @a old from the previous
+*        pass. If they do not intersect, @a old is kept.
+*/
+Range narrowRange(const Range &r, const Range &old)
+{
+	const Range result = intersect(r, old);
+	return (result.empty()) ? old : result;
+}
+
+}
+
+/**
+* @brief Creates the analysis context of the given @a fnc. All blocks of @a fnc
+*        are numbered in reverse postorder (the unreachable ones at the end), the
+*        data of each block are then stored in vectors.
+*/
+ValueAnalysis::ValueAnalysis(const Fnc &fnc, bool sparse,
+							 const FncSummaryMap *summaries):
+	fnc(fnc), sparse(sparse), summaries(summaries),
+	thresholds(LoopFinder::getThresholds(fnc)),
+	passesBeforeWidening(NumberOfPassesBeforeWidening),
+	narrowing(false)
+{
+	// Gets the blocks in postorder by the depth-first search from the entry.
+	std::set<const Block *> visited;
+	vector<const Block *> todo;
+	vector<TTargetList> todoTargets;
+	todo.push_back(fnc.cfg.entry());
+	todoTargets.push_back(TTargetList());
+	getOrderedTargets(fnc, todo.back(), todoTargets.back());
+	visited.insert(fnc.cfg.entry());
+	while (!todo.empty()) {
+		TTargetList &targets = todoTargets.back();
+		if (targets.empty()) {
+			blocks.push_back(todo.back());
+			todo.pop_back();
+			todoTargets.pop_back();
+			continue;
+		}
+
+		const Block *target = targets.back();
+		targets.pop_back();
+		if (visited.insert(target).second) {
+			todo.push_back(target);
+			todoTargets.push_back(TTargetList());
+			getOrderedTargets(fnc, target, todoTargets.back());
+		}
+	}
+	std::reverse(blocks.begin(), blocks.end());
+
+	BOOST_FOREACH(const Block *block, fnc.cfg) {
+		if (visited.find(block) == visited.end())
+			blocks.push_back(block);
+	}
+
+	unsigned long maxTripCount = 0;
+	for (unsigned idx = 0; idx < blocks.size(); ++idx) {
+		blockToIndexMap[blocks[idx]] = idx;
+		maxTripCount = std::max(maxTripCount,
+								LoopFinder::getUpperLimit(blocks[idx]));
+	}
+
+	passesBeforeWidening += maxTripCount;
+
+	const unsigned cnt = blocks.size();
+	trimmedRanges.resize(cnt);
+	inputRanges.resize(cnt);
+	outputRanges.resize(cnt);
+	todoSet.resize(cnt, false);
+	blockCounter.resize(cnt, 0);
+	tripCountOfBlock.resize(cnt, 0);
+
+	if (!sparse)
+		return;
+
+	reachable.resize(cnt, false);
+	idomIndex.resize(cnt, -1);
+	defs.resize(cnt);
+	uses.resize(cnt);
+	joins.resize(cnt);
+	defRanges.resize(cnt);
+	joinRanges.resize(cnt);
+	defUsers.resize(cnt);
+	joinUsers.resize(cnt);
+}
+
+/**
+* @brief Returns the ordinal of the given @a block of the analysed function.
+*/
+unsigned ValueAnalysis::getIndex(const Block *block) const
+{
+	BlockToIndexMap::const_iterator it = blockToIndexMap.find(block);
+	assert(it != blockToIndexMap.end());
+	return it->second;
 }
 
 /**
@@ -64,10 +208,11 @@ bool sortBlockInfo(const ValueAnalysis::MemoryPlaceRangePair &f,
 *        nothing. Otherwise, it inserts @a block into schedulers.
 */
 void ValueAnalysis::scheduleBlock(const Block *block) {
-	if (todoSet.find(block) == todoSet.end()) {
+	const unsigned idx = getIndex(block);
+	if (!todoSet[idx]) {
 		// If block was not scheduled, we schedule it.
-		todoQueue.push(block);
-		todoSet.insert(block);
+		todoQueue.push(idx);
+		todoSet[idx] = true;
 	}
 }
 
@@ -221,35 +366,23 @@ void ValueAnalysis::assign(const struct cl_operand &dst,
 }
 
 /**
-* @brief If the given @a block is found as a key in the given @a inputMap
-*        then it returns the ranges associated with this key in @a inputMap.
-*        Otherwise, it returns an empty map.
+* @brief Returns the ranges of the given @a block stored in the given @a vec.
+*        The map is empty if the block has not been analysed yet.
 */
-ValueAnalysis::MemoryPlaceToRangeMap ValueAnalysis::getRanges(const Block* block,
-													const BlockToResultMap &inputMap)
+const ValueAnalysis::MemoryPlaceToRangeMap& ValueAnalysis::getRanges(
+	const Block* block, const MemoryPlaceToRangeMapVector &vec) const
 {
-	BlockToResultMap::const_iterator it = inputMap.find(block);
-	if (it != inputMap.end()) {
-		return it->second;
-	} else {
-		MemoryPlaceToRangeMap emptyMap;
-		return emptyMap;
-	}
+	return vec[getIndex(block)];
 }
 
 /**
-* @brief If the given @a block is found as a key in @c blockToTrimmedRangesMap
-*        then it returns the output ranges that get off the given @a block.
-*        Otherwise, it returns an empty map.
+* @brief Returns the trimmed ranges that get off the given @a block. The map is
+*        empty if there are no trimmed ranges for the block.
 */
-ValueAnalysis::TrimmedRangesMap ValueAnalysis::getTrimmedRanges(const Block* block)
+const ValueAnalysis::TrimmedRangesMap& ValueAnalysis::getTrimmedRanges(
+	const Block* block) const
 {
-	if (blockToTrimmedRangesMap.find(block) != blockToTrimmedRangesMap.end()) {
-		return blockToTrimmedRangesMap[block];
-	} else {
-		TrimmedRangesMap emptyMap;
-		return emptyMap;
-	}
+	return trimmedRanges[getIndex(block)];
 }
 
 /**
@@ -306,21 +439,28 @@ void ValueAnalysis::computeInputRanges(const CodeStorage::Block *current)
 	// Stores the input ranges of the current block, output ranges or trimmed ranges
 	// of its predecessors.
 	MemoryPlaceToRangeMapVector outputOfPreds;
-	outputOfPreds.push_back(ValueAnalysis::getRanges(current, blockToInputRangesMap));
+	if (!narrowing || current == fnc.cfg.entry())
+		// The narrowing passes compute the input ranges from scratch, except
+		// the ranges of global variables at the entry block.
+		outputOfPreds.push_back(getRanges(current, inputRanges));
+
+	// Output ranges of the predecessors that have already been analysed.
+	std::vector<const MemoryPlaceToRangeMap *> reachedOutputs;
 
 	BOOST_FOREACH(const TTargetList::value_type &pred, preds) {
 		// Get the output ranges of the predecessor.
-		MemoryPlaceToRangeMap out = ValueAnalysis::getRanges(pred,
-										blockToOutputRangesMap);
+		const MemoryPlaceToRangeMap &out = getRanges(pred, outputRanges);
+		if (blockCounter[getIndex(pred)])
+			reachedOutputs.push_back(&out);
+		const TrimmedRangesMap &trimmed = getTrimmedRanges(pred);
 
-		if (blockToTrimmedRangesMap.find(pred) == blockToTrimmedRangesMap.end()) {
+		if (trimmed.empty()) {
 			// If there are no trimmed ranges, we store the output ranges of
 			// predecessor.
 			outputOfPreds.push_back(out);
 		} else {
 			// If there are trimmed ranges, we have to compute the result from
 			// predecessor's output and trimmed ranges.
-			TrimmedRangesMap trimmed = ValueAnalysis::getTrimmedRanges(pred);
 			MemoryPlaceToRangeMap result
 					= ValueAnalysis::computePartialInputRanges(current, out, trimmed);
 			outputOfPreds.push_back(result);
@@ -332,18 +472,58 @@ void ValueAnalysis::computeInputRanges(const CodeStorage::Block *current)
 	MemoryPlaceToRangeMap inputToBlock;
 	inputToBlock = ValueAnalysis::join(outputOfPreds);
 
+	BOOST_FOREACH(MemoryPlaceToRangeMap::value_type &item, inputToBlock) {
+		// A memory place that is missing at the exit of a reached predecessor
+		// can hold any value there (e.g. an uninitialized variable). The range
+		// of an array covers only the values written into its elements.
+		if (item.second.empty() || item.first->representsElementOfArray())
+			continue;
+
+		BOOST_FOREACH(const MemoryPlaceToRangeMap *out, reachedOutputs) {
+			if (out->find(item.first) == out->end()) {
+				item.second = Range::getMaxRange(item.second.getMin());
+				break;
+			}
+		}
+	}
+
 	// Assigns the input ranges to the currently processed block.
-	blockToInputRangesMap[current] = inputToBlock;
+	inputRanges[getIndex(current)] = inputToBlock;
+}
+
+/**
+* @brief Widens the range @a r of the block @a idx that has changed from @a old.
+*        If no threshold bounds the growth, the range would jump to the limits
+*        of its type, so it is widened only after @c NumberOfPassesBeforeExpand
+*        passes. Until then, the loops with an unknown trip count (e.g. the
+*        outer ones of the nested loops) can still converge by themselves.
+*/
+Range ValueAnalysis::widenRange(unsigned idx, const Range &r,
+								const Range &old) const
+{
+	if (blockCounter[idx] <= passesBeforeWidening)
+		return r;
+
+	const Range result = r.widen(old, thresholds);
+	if (blockCounter[idx] > NumberOfPassesBeforeExpand)
+		return result;
+
+	const Range maxRange = Range::getMaxRange(r.getMin());
+	const bool expanded = (result.getMax() == maxRange.getMax()
+			&& r.getMax() != result.getMax())
+		|| (result.getMin() == maxRange.getMin()
+			&& r.getMin() != result.getMin());
+	return (expanded) ? r : result;
 }
 
 /**
 * @brief Gets the ranges that are changing between @a oldResult and @a newResult
-*        and expands these for faster convergence. Then, these new ranges are
+*        and widens these for faster convergence. Then, these new ranges are
 *        stored for the output of the given @a block.
 */
-void ValueAnalysis::expandChangingRanges(const Block* block,
-										 const MemoryPlaceToRangeMap &oldResult,
-										 const MemoryPlaceToRangeMap &newResult)
+void ValueAnalysis::widenChangingRanges(const Block* block,
+										const MemoryPlaceToRangeMap &oldResult,
+										const MemoryPlaceToRangeMap &newResult)
 {
 
 	MemoryPlaceToRangeMap result;
@@ -364,7 +544,7 @@ void ValueAnalysis::expandChangingRanges(const Block* block,
 			result[key] = newRange;
 		} else {
 			// Ranges change after the last processing of the block.
-			result[key] = newRange.expand();
+			result[key] = widenRange(getIndex(block), newRange, oldRange);
 		}
 	}
 
@@ -381,7 +561,66 @@ void ValueAnalysis::expandChangingRanges(const Block* block,
 		}
 	}
 
-	blockToOutputRangesMap[block] = result;
+	outputRanges[getIndex(block)] = result;
+}
+
+/**
+* @brief Narrows the given @a ranges by the given @a oldRanges from the previous
+*        pass. The memory places missing in @a ranges keep their old ranges.
+*/
+void ValueAnalysis::narrowRanges(MemoryPlaceToRangeMap &ranges,
+								 const MemoryPlaceToRangeMap &oldRanges)
+{
+	BOOST_FOREACH(const MemoryPlaceToRangeMap::value_type &old, oldRanges) {
+		MemoryPlaceToRangeMap::iterator it = ranges.find(old.first);
+		if (it == ranges.end())
+			ranges.insert(old);
+		else
+			it->second = narrowRange(it->second, old.second);
+	}
+}
+
+/**
+* @brief Performs the narrowing passes over the analysed function. Each pass
+*        analyses all reachable blocks once more without widening and narrows
+*        their ranges by the ranges from the previous pass. The passes stop
+*        earlier if nothing changes.
+*/
+void ValueAnalysis::narrowAnalysisForFnc()
+{
+	narrowing = true;
+	for (unsigned pass = 0; pass < NumberOfNarrowingPasses; ++pass) {
+		bool changed = false;
+		for (unsigned idx = 0; idx < blocks.size(); ++idx) {
+			if (sparse) {
+				if (!reachable[idx])
+					continue;
+
+				const MemoryPlaceToRangeMap oldDefs = defRanges[idx];
+				const MemoryPlaceToRangeMap oldJoins = joinRanges[idx];
+				computeSparseAnalysisForBlock(idx);
+				changed |= (defRanges[idx] != oldDefs)
+					|| (joinRanges[idx] != oldJoins);
+				continue;
+			}
+
+			if (!blockCounter[idx])
+				// The block has never been reached.
+				continue;
+
+			const MemoryPlaceToRangeMap oldInput = inputRanges[idx];
+			const MemoryPlaceToRangeMap oldOutput = outputRanges[idx];
+			computeAnalysisForBlock(blocks[idx]);
+			narrowRanges(inputRanges[idx], oldInput);
+			narrowRanges(outputRanges[idx], oldOutput);
+			changed |= (inputRanges[idx] != oldInput)
+				|| (outputRanges[idx] != oldOutput);
+		}
+
+		if (!changed)
+			break;
+	}
+	narrowing = false;
 }
 
 /**
@@ -399,54 +638,63 @@ bool ValueAnalysis::containOnlyGotoInsn(const Block *block)
 /**
 * @brief Computes value-range analysis for the given @a fnc.
 */
-void ValueAnalysis::computeAnalysisForFnc(const Fnc &fnc)
+void ValueAnalysis::computeAnalysisForFnc()
 {
+	if (sparse) {
+		computeSparseAnalysisForFnc();
+		narrowAnalysisForFnc();
+		return;
+	}
+
 	const Block *entryBlock = fnc.cfg.entry();
 
 	// Sets the ranges for global variables for the input of the entry block.
-	blockToInputRangesMap[entryBlock] = GlobAnalysis::getGlobVarMap();
+	inputRanges[getIndex(entryBlock)] = GlobAnalysis::getGlobVarMap();
 
-	todoQueue.push(entryBlock);
-	todoSet.insert(entryBlock);
+	scheduleBlock(entryBlock);
 
 	while (!todoQueue.empty()) {
-		const Block *block = todoQueue.front();
+		const unsigned idx = todoQueue.top();
 		todoQueue.pop();
-		todoSet.erase(block);
+		todoSet[idx] = false;
+		const Block *block = blocks[idx];
 
-		MemoryPlaceToRangeMap oldResult = ValueAnalysis::getRanges(block,
-			blockToOutputRangesMap);
+		MemoryPlaceToRangeMap oldResult = outputRanges[idx];
+		const TrimmedRangesMap oldTrimmed = trimmedRanges[idx];
 
 		unsigned long tripCount = LoopFinder::getUpperLimit(block);
-		if ((tripCount != 0) &&
-			(tripCount == ValueAnalysis::tripCountOfBlockMap[block]) ) {
+		if ((tripCount != 0) && (tripCount == tripCountOfBlock[idx])) {
 			// This block was processed enough times.
-			ValueAnalysis::tripCountOfBlockMap[block] = 0;
+			tripCountOfBlock[idx] = 0;
 			continue;
 		}
 
-		ValueAnalysis::computeAnalysisForBlock(block);
-		++ValueAnalysis::tripCountOfBlockMap[block];
-		MemoryPlaceToRangeMap newResult = ValueAnalysis::getRanges(block,
-			blockToOutputRangesMap);
+		computeAnalysisForBlock(block);
+		++tripCountOfBlock[idx];
+		MemoryPlaceToRangeMap newResult = outputRanges[idx];
 
 		if (newResult != oldResult) {
 			// If this block was analysed many times and still does
 			// not converge, we will help it a little.
-			if (blockToCounterMap[block] > ValueAnalysis::NumberOfPassesBeforeExpand) {
-				expandChangingRanges(block, oldResult, newResult);
+			if (blockCounter[idx] > passesBeforeWidening) {
+				widenChangingRanges(block, oldResult, newResult);
 			}
 		}
 
-		newResult = ValueAnalysis::getRanges(block, blockToOutputRangesMap);
-		if ((newResult != oldResult) || (ValueAnalysis::containOnlyGotoInsn(block))) {
+		// The successors behind a condition take the trimmed ranges, which are
+		// not widened, so they have to be analysed again when these change.
+		newResult = outputRanges[idx];
+		if ((newResult != oldResult) || (trimmedRanges[idx] != oldTrimmed)
+				|| (ValueAnalysis::containOnlyGotoInsn(block))) {
 			// Gets the successors of the processed block.
 			const TTargetList &succs = block->targets();
 			BOOST_FOREACH(const TTargetList::value_type &succ, succs) {
-				ValueAnalysis::scheduleBlock(succ);
+				scheduleBlock(succ);
 			}
 		}
 	}
+
+	narrowAnalysisForFnc();
 }
 
 /**
@@ -457,37 +705,762 @@ void ValueAnalysis::computeAnalysisForBlock(const Block *block)
 	computeInputRanges(block);
 
 	MemoryPlaceToRangeMap outputFromBlock;
-	outputFromBlock = ValueAnalysis::getRanges(block, blockToInputRangesMap);
+	outputFromBlock = getRanges(block, inputRanges);
 
 	// Starts to analyze the given block.
 	const Insn *prevInsn = NULL;
 	BOOST_FOREACH(const Insn *insn, *block) {
-		ValueAnalysis::computeAnalysisForInsn(insn, prevInsn, outputFromBlock);
+		computeAnalysisForInsn(insn, prevInsn, outputFromBlock);
 		prevInsn = insn;
 	}
 
 	// Assigns the output ranges to the currently processed block.
-	blockToOutputRangesMap[block] = outputFromBlock;
+	const unsigned idx = getIndex(block);
+	outputRanges[idx] = outputFromBlock;
 
 	// Increments counter.
-	++blockToCounterMap[block];
+	++blockCounter[idx];
+}
+
+/**
+* @brief Collects the memory places written by the given @a insn into @a defs
+*        and the memory places read by it into @a uses. It mirrors the way how
+*        the instructions are analysed, see computeAnalysisForInsn().
+*/
+void ValueAnalysis::collectDefsAndUses(const Insn *insn, MemoryPlaceSet &defs,
+									   MemoryPlaceSet &uses) const
+{
+	const TOperandList &opList = insn->operands;
+	switch (insn->code) {
+		case CL_INSN_UNOP: {
+			const struct cl_operand &dst = opList[0];
+			const struct cl_operand &src = opList[1];
+			if ((CL_UNOP_ASSIGN == insn->subCode)
+					&& (CL_TYPE_STRUCT == src.type->code)
+					&& (CL_TYPE_STRUCT == dst.type->code)) {
+				// Assignment of structure to another structure, see assign().
+				deque<int> indSrc;
+				deque<int> indDst;
+				vector<deque<int> > indSrcVec;
+				vector<deque<int> > indDstVec;
+				generateIndexes(getType(src), indSrc, indSrcVec);
+				generateIndexes(getType(dst), indDst, indDstVec);
+				assert(indSrcVec.size() == indDstVec.size());
+
+				for (size_t i = 0; i != indDstVec.size(); ++i) {
+					const MemoryPlace *dstVar =
+						OperandToMemoryPlace::convert(&dst, indDstVec[i]);
+					defs.insert(dstVar);
+					if (dstVar->representsElementOfArray())
+						// The new range is united with the old one.
+						uses.insert(dstVar);
+
+					if (CL_OPERAND_VAR == src.code)
+						uses.insert(OperandToMemoryPlace::convert(&src, indSrcVec[i]));
+				}
+				break;
+			}
+
+			const MemoryPlace *dstVar = OperandToMemoryPlace::convert(&dst);
+			defs.insert(dstVar);
+			if ((CL_UNOP_ASSIGN == insn->subCode)
+					&& dstVar->representsElementOfArray())
+				// The new range is united with the old one.
+				uses.insert(dstVar);
+
+			if (CL_OPERAND_VAR == src.code)
+				uses.insert(OperandToMemoryPlace::convert(&src));
+			break;
+		}
+
+		case CL_INSN_BINOP:
+			defs.insert(OperandToMemoryPlace::convert(&opList[0]));
+			if (CL_OPERAND_VAR == opList[1].code)
+				uses.insert(OperandToMemoryPlace::convert(&opList[1]));
+			if (CL_OPERAND_VAR == opList[2].code)
+				uses.insert(OperandToMemoryPlace::convert(&opList[2]));
+			break;
+
+		case CL_INSN_CALL: {
+			const FncSummary *summary = getSummary(insn);
+			if (CL_OPERAND_VAR == opList[0].code) {
+				// The range of the returned value is read and written back
+				// unless it is known from the summary.
+				const MemoryPlace *retVar = OperandToMemoryPlace::convert(&opList[0]);
+				defs.insert(retVar);
+				if (summary == NULL || !summary->hasRetRange)
+					uses.insert(retVar);
+			}
+
+			if (summary == NULL)
+				break;
+
+			BOOST_FOREACH(const MemoryPlaceToRangeMap::value_type &glob,
+						  summary->globRanges) {
+				defs.insert(glob.first);
+				if (summary->keptGlobs.count(glob.first))
+					// The new range is united with the old one.
+					uses.insert(glob.first);
+			}
+			break;
+		}
+
+		default:
+			// The operands of the condition are read by the preceding binary
+			// operation, the other instructions do not touch the ranges.
+			break;
+	}
+}
+
+/**
+* @brief Collects the memory places whose ranges may be trimmed by the condition
+*        at the end of the given @a block into @a vars, see
+*        computeAnalysisForCond().
+*/
+void ValueAnalysis::collectTrimmedVars(const Block *block, MemoryPlaceSet &vars)
+{
+	if (block->size() < 2)
+		return;
+
+	const Insn *insn = block->back();
+	const Insn *prevInsn = (*block)[block->size() - 2];
+	if ((CL_INSN_COND != insn->code) || (CL_INSN_BINOP != prevInsn->code))
+		return;
+
+	const TOperandList &opListPrev = prevInsn->operands;
+	const MemoryPlace *dstVar = OperandToMemoryPlace::convert(&opListPrev[0]);
+	const MemoryPlace *condVar = OperandToMemoryPlace::convert(&insn->operands[0]);
+	if (condVar != dstVar)
+		return;
+
+	if (CL_OPERAND_VAR == opListPrev[1].code)
+		vars.insert(OperandToMemoryPlace::convert(&opListPrev[1]));
+	if (CL_OPERAND_VAR == opListPrev[2].code)
+		vars.insert(OperandToMemoryPlace::convert(&opListPrev[2]));
+}
+
+/**
+* @brief Builds the def-use chains of the analysed function. The ranges of
+*        a memory place are joined at the iterated dominance frontier of the
+*        blocks that define it. The trimmed ranges define the memory place at
+*        the targets of the condition, the global variables at the entry block.
+*/
+void ValueAnalysis::buildDefUseChains()
+{
+	const unsigned cnt = blocks.size();
+	for (unsigned idx = 0; idx < cnt; ++idx) {
+		const CodeStorage::BlockLoopInfo &info = fnc.cfg.loopInfo(blocks[idx]);
+		reachable[idx] = info.isReachable;
+		if (info.idom)
+			idomIndex[idx] = getIndex(info.idom);
+	}
+
+	// Gets the blocks that define each memory place.
+	std::map<const MemoryPlace *, vector<unsigned> > defSites;
+	for (unsigned idx = 0; idx < cnt; ++idx) {
+		if (!reachable[idx])
+			continue;
+
+		const Block *block = blocks[idx];
+		BOOST_FOREACH(const Insn *insn, *block) {
+			collectDefsAndUses(insn, defs[idx], uses[idx]);
+		}
+
+		BOOST_FOREACH(const MemoryPlace *mp, defs[idx]) {
+			defSites[mp].push_back(idx);
+		}
+
+		MemoryPlaceSet trimmedVars;
+		collectTrimmedVars(block, trimmedVars);
+		BOOST_FOREACH(const Block *target, block->targets()) {
+			const unsigned targetIdx = getIndex(target);
+			BOOST_FOREACH(const MemoryPlace *mp, trimmedVars) {
+				joins[targetIdx].insert(mp);
+				defSites[mp].push_back(targetIdx);
+			}
+		}
+	}
+
+	// Sets the ranges for global variables for the entry block.
+	const unsigned entryIdx = getIndex(fnc.cfg.entry());
+	joinRanges[entryIdx] = GlobAnalysis::getGlobVarMap();
+	BOOST_FOREACH(const MemoryPlaceRangePair &glob, joinRanges[entryIdx]) {
+		joins[entryIdx].insert(glob.first);
+		defSites[glob.first].push_back(entryIdx);
+	}
+
+	// Computes the dominance frontiers.
+	vector<vector<unsigned> > frontiers(cnt);
+	for (unsigned idx = 0; idx < cnt; ++idx) {
+		if (!reachable[idx] || blocks[idx]->inbound().size() < 2)
+			continue;
+
+		BOOST_FOREACH(const Block *pred, blocks[idx]->inbound()) {
+			int runner = getIndex(pred);
+			if (!reachable[runner])
+				continue;
+
+			while (runner != idomIndex[idx]) {
+				vector<unsigned> &frontier = frontiers[runner];
+				if (frontier.empty() || frontier.back() != idx)
+					frontier.push_back(idx);
+
+				runner = idomIndex[runner];
+				if (runner < 0)
+					break;
+			}
+		}
+	}
+
+	// Places the joins at the iterated dominance frontiers.
+	typedef std::map<const MemoryPlace *, vector<unsigned> > DefSitesMap;
+	BOOST_FOREACH(const DefSitesMap::value_type &item, defSites) {
+		const MemoryPlace *mp = item.first;
+		allVars.insert(mp);
+
+		vector<unsigned> todo(item.second);
+		std::set<unsigned> done(todo.begin(), todo.end());
+		while (!todo.empty()) {
+			const unsigned idx = todo.back();
+			todo.pop_back();
+			BOOST_FOREACH(const unsigned frontierIdx, frontiers[idx]) {
+				joins[frontierIdx].insert(mp);
+				if (done.insert(frontierIdx).second)
+					todo.push_back(frontierIdx);
+			}
+		}
+	}
+
+	// Connects the readers to the reaching definitions.
+	for (unsigned idx = 0; idx < cnt; ++idx) {
+		if (!reachable[idx])
+			continue;
+
+		const Block *block = blocks[idx];
+		BOOST_FOREACH(const MemoryPlace *mp, uses[idx]) {
+			addUser(block, idx, mp, false);
+		}
+
+		BOOST_FOREACH(const Block *pred, block->inbound()) {
+			const unsigned predIdx = getIndex(pred);
+			if (!reachable[predIdx])
+				continue;
+
+			BOOST_FOREACH(const MemoryPlace *mp, joins[idx]) {
+				addUser(block, predIdx, mp, true);
+			}
+		}
+	}
+}
+
+/**
+* @brief Finds the block whose definition or join of @a mp reaches the entry
+*        of the block @a idx (or its exit if @a atExit is @c true). Returns -1
+*        if there is no such block. Otherwise, @a atExit is set to @c true if
+*        the range is defined in the returned block and to @c false if it is
+*        joined at its entry.
+*/
+int ValueAnalysis::findReachingDef(unsigned idx, const MemoryPlace *mp,
+								   bool &atExit) const
+{
+	for (int i = idx; i >= 0; i = idomIndex[i]) {
+		if (atExit && defs[i].count(mp))
+			return i;
+
+		if (joins[i].count(mp)) {
+			atExit = false;
+			return i;
+		}
+
+		// The range at the entry of the block is the same as at the exit of
+		// its immediate dominator.
+		atExit = true;
+	}
+
+	return -1;
+}
+
+/**
+* @brief Returns the range of @a mp at the entry of the block @a idx (or at its
+*        exit if @a atExit is @c true), @c NULL if it is not known yet.
+*/
+const Range *ValueAnalysis::lookup(unsigned idx, const MemoryPlace *mp,
+								   bool atExit) const
+{
+	const int defIdx = findReachingDef(idx, mp, atExit);
+	if (defIdx < 0)
+		return NULL;
+
+	const MemoryPlaceToRangeMap &ranges = (atExit)
+		? defRanges[defIdx]
+		: joinRanges[defIdx];
+
+	MemoryPlaceToRangeMap::const_iterator it = ranges.find(mp);
+	if (it == ranges.end())
+		return NULL;
+
+	return &it->second;
+}
+
+/**
+* @brief Returns the ranges of all memory places at the entry of the block @a idx
+*        (or at its exit if @a atExit is @c true). It is used for printing only.
+*/
+ValueAnalysis::MemoryPlaceToRangeMap ValueAnalysis::getSparseRanges(unsigned idx,
+	bool atExit) const
+{
+	MemoryPlaceToRangeMap result;
+	if (!reachable[idx])
+		return result;
+
+	BOOST_FOREACH(const MemoryPlace *mp, allVars) {
+		const Range *range = lookup(idx, mp, atExit);
+		if (range)
+			result[mp] = *range;
+	}
+
+	return result;
+}
+
+/**
+* @brief Records that the block @a user reads the range of @a mp reaching the
+*        entry of the block @a idx (or its exit if @a atExit is @c true).
+*/
+void ValueAnalysis::addUser(const Block *user, unsigned idx, const MemoryPlace *mp,
+							bool atExit)
+{
+	const int defIdx = findReachingDef(idx, mp, atExit);
+	if (defIdx < 0)
+		return;
+
+	MemoryPlaceToUsersMap &users = (atExit)
+		? defUsers[defIdx]
+		: joinUsers[defIdx];
+
+	users[mp].push_back(user);
+}
+
+/**
+* @brief Schedules the blocks that read the range of @a mp stored in @a users,
+*        except the @a current block.
+*/
+void ValueAnalysis::scheduleUsers(const MemoryPlaceToUsersMap &users,
+								  const MemoryPlace *mp, const Block *current)
+{
+	MemoryPlaceToUsersMap::const_iterator it = users.find(mp);
+	if (it == users.end())
+		return;
+
+	BOOST_FOREACH(const Block *user, it->second) {
+		if (user != current)
+			scheduleBlock(user);
+	}
+}
+
+/**
+* @brief Computes the ranges joined at the entry of the block @a idx from
+*        the ranges reaching the exits of its predecessors and from their
+*        trimmed ranges, see computeInputRanges().
+*/
+void ValueAnalysis::computeJoins(unsigned idx)
+{
+	const Block *block = blocks[idx];
+	MemoryPlaceToRangeMap &ranges = joinRanges[idx];
+
+	BOOST_FOREACH(const MemoryPlace *mp, joins[idx]) {
+		MemoryPlaceToRangeMap::iterator it = ranges.find(mp);
+		const bool known = (it != ranges.end());
+		Range result;
+		if (known && !narrowing)
+			result = it->second;
+
+		bool found = known && !narrowing;
+		bool undefined = false;
+		BOOST_FOREACH(const Block *pred, block->inbound()) {
+			const unsigned predIdx = getIndex(pred);
+			if (!reachable[predIdx])
+				continue;
+
+			bool atExit = true;
+			const bool defined = (findReachingDef(predIdx, mp, atExit) >= 0);
+			const Range *out = lookup(predIdx, mp, true);
+			const Range *trimmed = NULL;
+			BOOST_FOREACH(const TrimmedRangesMap::value_type &trim,
+						  trimmedRanges[predIdx]) {
+				if (trim.first.block == block && trim.first.varMp == mp)
+					trimmed = &trim.second;
+			}
+
+			const Range *range = out;
+			if (trimmed && (!out || !(intersect(*trimmed, *out)).empty()))
+				range = trimmed;
+
+			if (!range) {
+				// No definition of the memory place reaches the exit of the
+				// predecessor, so it can hold any value there, the same as
+				// in computeInputRanges().
+				undefined |= !defined;
+				continue;
+			}
+
+			result = (found) ? unite(result, *range) : *range;
+			found = true;
+		}
+
+		if (found && undefined && !result.empty()
+				&& !mp->representsElementOfArray())
+			result = Range::getMaxRange(result.getMin());
+
+		if (!found || (known && result == it->second))
+			continue;
+
+		if (known && narrowing) {
+			result = narrowRange(result, it->second);
+			if (result == it->second)
+				continue;
+		} else if (known) {
+			// The range still does not converge, we will help it a little.
+			result = widenRange(idx, result, it->second);
+		}
+
+		ranges[mp] = result;
+		if (!narrowing)
+			scheduleUsers(joinUsers[idx], mp, block);
+	}
+}
+
+/**
+* @brief Computes value-range analysis for the block @a idx in the sparse mode.
+*/
+void ValueAnalysis::computeSparseAnalysisForBlock(unsigned idx)
+{
+	const Block *block = blocks[idx];
+	computeJoins(idx);
+
+	// Gets the ranges of the memory places read by the block.
+	MemoryPlaceToRangeMap output;
+	BOOST_FOREACH(const MemoryPlace *mp, uses[idx]) {
+		const Range *range = lookup(idx, mp, false);
+		if (range)
+			output[mp] = *range;
+	}
+
+	const TrimmedRangesMap oldTrimmed = trimmedRanges[idx];
+
+	// Starts to analyze the given block.
+	const Insn *prevInsn = NULL;
+	BOOST_FOREACH(const Insn *insn, *block) {
+		computeAnalysisForInsn(insn, prevInsn, output);
+		prevInsn = insn;
+	}
+
+	// Stores the ranges of the memory places defined by the block.
+	MemoryPlaceToRangeMap &ranges = defRanges[idx];
+	BOOST_FOREACH(const MemoryPlace *mp, defs[idx]) {
+		MemoryPlaceToRangeMap::const_iterator it = output.find(mp);
+		if (it == output.end())
+			continue;
+
+		Range result = it->second;
+		MemoryPlaceToRangeMap::iterator jt = ranges.find(mp);
+		const bool known = (jt != ranges.end());
+		if (known && result == jt->second)
+			continue;
+
+		if (known && narrowing) {
+			result = narrowRange(result, jt->second);
+			if (result == jt->second)
+				continue;
+		} else if (known) {
+			// The range still does not converge, we will help it a little.
+			result = widenRange(idx, result, jt->second);
+		}
+
+		ranges[mp] = result;
+		if (!narrowing)
+			scheduleUsers(defUsers[idx], mp);
+	}
+
+	if (!narrowing && trimmedRanges[idx] != oldTrimmed) {
+		// The joins of the targets read the trimmed ranges.
+		BOOST_FOREACH(const Block *target, block->targets()) {
+			scheduleBlock(target);
+		}
+	}
+
+	++blockCounter[idx];
+}
+
+/**
+* @brief Computes value-range analysis for the analysed function in the sparse
+*        mode.
+*/
+void ValueAnalysis::computeSparseAnalysisForFnc()
+{
+	buildDefUseChains();
+
+	// Every reachable block is analysed at least once, then only the blocks
+	// that read a changed range are analysed again.
+	for (unsigned idx = 0; idx < blocks.size(); ++idx) {
+		if (reachable[idx])
+			scheduleBlock(blocks[idx]);
+	}
+
+	while (!todoQueue.empty()) {
+		const unsigned idx = todoQueue.top();
+		todoQueue.pop();
+		todoSet[idx] = false;
+
+		unsigned long tripCount = LoopFinder::getUpperLimit(blocks[idx]);
+		if ((tripCount != 0) && (tripCount == tripCountOfBlock[idx])) {
+			// This block was processed enough times.
+			tripCountOfBlock[idx] = 0;
+			continue;
+		}
+
+		computeSparseAnalysisForBlock(idx);
+		++tripCountOfBlock[idx];
+	}
+}
+
+/**
+* @brief Collects the global variables written by the given @a insn into @a globs
+*        together with their maximal ranges.
+*/
+void ValueAnalysis::collectGlobWrites(const Insn *insn, MemoryPlaceToRangeMap &globs)
+{
+	const enum cl_insn_e code = insn->code;
+	if (CL_INSN_UNOP != code && CL_INSN_BINOP != code && CL_INSN_CALL != code)
+		return;
+
+	const struct cl_operand &dst = insn->operands[0];   // [0] - destination
+	if (CL_OPERAND_VAR != dst.code || CL_SCOPE_FUNCTION == dst.scope)
+		return;
+
+	if (CL_TYPE_STRUCT == dst.type->code) {
+		// All items of the structure are written, see assign().
+		deque<int> ind;
+		vector<deque<int> > indVec;
+		generateIndexes(getType(dst), ind, indVec);
+		BOOST_FOREACH(const deque<int> &indexes, indVec) {
+			globs[OperandToMemoryPlace::convert(&dst, indexes)] =
+				Utility::getMaxRange(dst, indexes);
+		}
+	} else if (isSupportedType(dst.type)) {
+		globs[OperandToMemoryPlace::convert(&dst)] = Utility::getMaxRange(dst);
+	}
+}
+
+/**
+* @brief Returns the range of @a mp at the exit of the block @a idx, @c NULL if
+*        it is not known.
+*/
+const Range *ValueAnalysis::getExitRange(unsigned idx, const MemoryPlace *mp) const
+{
+	if (sparse)
+		return lookup(idx, mp, true);
+
+	const MemoryPlaceToRangeMap &ranges = outputRanges[idx];
+	MemoryPlaceToRangeMap::const_iterator it = ranges.find(mp);
+	if (it == ranges.end())
+		return NULL;
+
+	return &it->second;
+}
+
+/**
+* @brief Returns the global variables from @a globs that are not written on some
+*        path from the entry of the function to a return instruction.
+*
+* A missing range means "not computed" when the ranges are joined, so whether
+* a global variable keeps its range cannot be read off the computed ranges.
+*/
+ValueAnalysis::MemoryPlaceSet ValueAnalysis::computeKeptGlobs(
+	const MemoryPlaceToRangeMap &globs) const
+{
+	// Gets the global variables that are written when a block is executed.
+	vector<MemoryPlaceSet> written(blocks.size());
+	for (unsigned idx = 0; idx < blocks.size(); ++idx) {
+		BOOST_FOREACH(const Insn *insn, *blocks[idx]) {
+			MemoryPlaceToRangeMap writes;
+			collectGlobWrites(insn, writes);
+			BOOST_FOREACH(const MemoryPlaceRangePair &write, writes) {
+				written[idx].insert(write.first);
+			}
+
+			const FncSummary *summary = (CL_INSN_CALL == insn->code)
+				? getSummary(insn)
+				: NULL;
+			if (summary == NULL)
+				continue;
+
+			BOOST_FOREACH(const MemoryPlaceRangePair &glob, summary->globRanges) {
+				if (!summary->keptGlobs.count(glob.first))
+					written[idx].insert(glob.first);
+			}
+		}
+	}
+
+	MemoryPlaceSet result;
+	BOOST_FOREACH(const MemoryPlaceRangePair &glob, globs) {
+		const MemoryPlace *mp = glob.first;
+
+		// Searches for a return instruction reachable without writing mp.
+		vector<bool> done(blocks.size(), false);
+		vector<unsigned> todo(1, getIndex(fnc.cfg.entry()));
+		done[todo.front()] = true;
+		while (!todo.empty()) {
+			const unsigned idx = todo.back();
+			todo.pop_back();
+			if (written[idx].count(mp))
+				continue;
+
+			if (CL_INSN_RET == blocks[idx]->back()->code) {
+				result.insert(mp);
+				break;
+			}
+
+			BOOST_FOREACH(const Block *target, blocks[idx]->targets()) {
+				const unsigned targetIdx = getIndex(target);
+				if (!done[targetIdx]) {
+					done[targetIdx] = true;
+					todo.push_back(targetIdx);
+				}
+			}
+		}
+	}
+
+	return result;
+}
+
+/**
+* @brief Computes the summary of the analysed function from the ranges at its
+*        return instructions. The global variables from @a modifiedGlobs can be
+*        modified by the function.
+*/
+ValueAnalysis::FncSummary ValueAnalysis::computeSummary(
+	const MemoryPlaceToRangeMap &modifiedGlobs) const
+{
+	FncSummary summary;
+	summary.modifiedGlobs = modifiedGlobs;
+	summary.keptGlobs = computeKeptGlobs(modifiedGlobs);
+
+	bool retKnown = true;
+	bool retFound = false;
+	for (unsigned idx = 0; idx < blocks.size(); ++idx) {
+		const Block *block = blocks[idx];
+		const Insn *insn = block->back();
+		if (CL_INSN_RET != insn->code || !fnc.cfg.loopInfo(block).isReachable)
+			continue;
+
+		if (0 == blockCounter[idx]) {
+			// The block was not analysed, nothing is known.
+			retKnown = false;
+			summary.globRanges = modifiedGlobs;
+			summary.keptGlobs.clear();
+			continue;
+		}
+
+		// Unites the ranges of the returned value.
+		const struct cl_operand &src = insn->operands[0];
+		const bool supported = (CL_OPERAND_VAR == src.code
+				&& isSupportedType(src.type))
+			|| (CL_OPERAND_CST == src.code
+				&& (CL_TYPE_INT == src.data.cst.code
+					|| CL_TYPE_REAL == src.data.cst.code));
+
+		if (supported) {
+			MemoryPlaceToRangeMap ranges;
+			if (CL_OPERAND_VAR == src.code) {
+				const MemoryPlace *srcVar = OperandToMemoryPlace::convert(&src);
+				const Range *range = getExitRange(idx, srcVar);
+				if (range)
+					ranges[srcVar] = *range;
+			}
+
+			const Range range = ValueAnalysis::getRange(src, ranges);
+			summary.retRange = (retFound) ? unite(summary.retRange, range) : range;
+			retFound = true;
+		} else {
+			retKnown = false;
+		}
+
+		// Unites the ranges of the modified global variables.
+		BOOST_FOREACH(const MemoryPlaceRangePair &glob, modifiedGlobs) {
+			const Range *range = getExitRange(idx, glob.first);
+			if (range == NULL)
+				continue;
+
+			MemoryPlaceToRangeMap::iterator it = summary.globRanges.find(glob.first);
+			if (it == summary.globRanges.end())
+				summary.globRanges[glob.first] = *range;
+			else
+				it->second = unite(it->second, *range);
+		}
+	}
+
+	summary.hasRetRange = retFound && retKnown;
+	return summary;
+}
+
+/**
+* @brief Returns the summary of the function called by the given @a insn, @c NULL
+*        if there is no summary for the function.
+*/
+const ValueAnalysis::FncSummary *ValueAnalysis::getSummary(const Insn *insn) const
+{
+	cl_uid_t uid;
+	if (NULL == summaries || !fncUidFromOperand(&uid, &insn->operands[1]))
+		// Indirect call.
+		return NULL;
+
+	FncSummaryMap::const_iterator it = summaries->find(uid);
+	if (it == summaries->end())
+		return NULL;
+
+	return &it->second;
 }
 
 /**
 * @brief Computes value-range analysis for the given @a insn that represents
-*        call instruction. Results are stored in @a output.
+*        call instruction. Results are stored in @a output. If there is a summary
+*        of the called function, the returned value and the global variables
+*        modified by the function get the ranges from the summary.
 */
 void ValueAnalysis::computeAnalysisForCall(const Insn* insn,
 	MemoryPlaceToRangeMap &output)
 {
 	const TOperandList &opList = insn->operands;
 	const struct cl_operand &ret = opList[0];   // [0] - destination
+	const FncSummary *summary = getSummary(insn);
+
+	if (summary != NULL) {
+		BOOST_FOREACH(const MemoryPlaceToRangeMap::value_type &glob,
+					  summary->globRanges) {
+			const MemoryPlace *globVar = glob.first;
+			if (summary->keptGlobs.find(globVar) == summary->keptGlobs.end()) {
+				// The global variable is set on every path through the function.
+				output[globVar] = glob.second;
+				continue;
+			}
+
+			// Otherwise, it can keep its range.
+			MemoryPlaceToRangeMap::iterator it = output.find(globVar);
+			if (it != output.end())
+				it->second = unite(it->second, glob.second);
+		}
+	}
 
-	if (ret.code == CL_OPERAND_VAR) {
+	if (ret.code == CL_OPERAND_VAR && isSupportedType(ret.type)) {
 		// Without this condition, the problem with functions whose return values
 		// are not stored in the program occurred.
 		const MemoryPlace *retVar = OperandToMemoryPlace::convert(&ret);
-		Range retRange = ValueAnalysis::getRange(ret, output);
+		Range retRange = Utility::getMaxRange(ret);
+		if (summary != NULL && summary->hasRetRange)
+			retRange = retRange.assign(summary->retRange);
+
+		// Without the summary, the returned value can be anything, so the
+		// previous range of the variable must not survive the call.
 		output[retVar] = retRange;
 	}
 }
@@ -779,17 +1752,17 @@ void ValueAnalysis::computeAnalysisForCond(const Insn *insn, const Insn *prevIns
 		TrimmedRangesMap trimmedRangesMap;
 		trimmedRangesMap[key1] = srcRange1True;
 		trimmedRangesMap[key2] = srcRange1False;
-		blockToTrimmedRangesMap[insn->bb] = trimmedRangesMap;
+		trimmedRanges[getIndex(insn->bb)] = trimmedRangesMap;
 	}
 
 	if (CL_OPERAND_VAR == src2.code) {
 		// We store the result for the second operand of the condition.
 		struct TrimmedKey key1(condVar, thenTarget, srcVar2);
 		struct TrimmedKey key2(condVar, elseTarget, srcVar2);
-		TrimmedRangesMap trimmedRangesMap = blockToTrimmedRangesMap[insn->bb];
+		TrimmedRangesMap trimmedRangesMap = getTrimmedRanges(insn->bb);
 		trimmedRangesMap[key1] = srcRange2True;
 		trimmedRangesMap[key2] = srcRange2False;
-		blockToTrimmedRangesMap[insn->bb] = trimmedRangesMap;
+		trimmedRanges[getIndex(insn->bb)] = trimmedRangesMap;
 	}
 }
 
@@ -1039,74 +2012,70 @@ void ValueAnalysis::computeAnalysisForBinop(const Insn *insn,
 }
 
 /**
-* @brief Emits the result of analysis for the analyzed program that is
-*        represented by @a stor into @a os.
+* @brief Emits the result of analysis for the analyzed function into @a os.
 */
-ostream& ValueAnalysis::printRanges(ostream &os, const Storage &stor)
+ostream& ValueAnalysis::printRanges(ostream &os) const
 {
-	BOOST_FOREACH(const Fnc* pFnc, stor.callGraph.topOrder) {
-		// Iterates over all functions.
-		const Fnc &fnc = *pFnc;
-		if (!isDefined(fnc))
-			continue;
-
-		string delimeter(10, '-');
-		os << delimeter << " Function " << nameOf(fnc) << "() ";
-		os << delimeter << endl;
-
-		BOOST_FOREACH(const Block* pBlock, fnc.cfg) {
-			// Iterates over all blocks.
-			const Block &block = *pBlock;
-			int firstLine = ((block.front())->loc).line;
-			int lastLine = ((block.back())->loc).line;
-
-			if (firstLine > lastLine) {
-				std::swap(firstLine, lastLine);
-			}
-
-			// Prints input ranges.
-			os << "Block " << block.name() << "[IN]" << " at lines from ";
-			os << firstLine << " to ";
-			os << lastLine << ":" << endl;
-
-			// Gets the result of analysis for the currently processed block.
-			MemoryPlaceToRangeMap &blockInfo = blockToInputRangesMap[pBlock];
-			vector<MemoryPlaceRangePair> sortedBlockInfo(
-				blockInfo.begin(), blockInfo.end());
-
-			sort(sortedBlockInfo.begin(), sortedBlockInfo.end(),
-				sortBlockInfo);
-
-			BOOST_FOREACH(MemoryPlaceRangePair &mem, sortedBlockInfo) {
-				// Iterates over all memory places in the block.
-				if ((mem.first)->isArtificial())
-					continue;
+	string delimeter(10, '-');
+	os << delimeter << " Function " << nameOf(fnc) << "() ";
+	os << delimeter << endl;
+
+	BOOST_FOREACH(const Block* pBlock, fnc.cfg) {
+		// Iterates over all blocks.
+		const Block &block = *pBlock;
+		int firstLine = ((block.front())->loc).line;
+		int lastLine = ((block.back())->loc).line;
+
+		if (firstLine > lastLine) {
+			std::swap(firstLine, lastLine);
+		}
 
-				// User variables and corresponding ranges in block are printed.
-				os << "\t" << (mem.first)->asString();
-				os << " = " << mem.second;
-			}
+		// Prints input ranges.
+		os << "Block " << block.name() << "[IN]" << " at lines from ";
+		os << firstLine << " to ";
+		os << lastLine << ":" << endl;
+
+		// Gets the result of analysis for the currently processed block.
+		const MemoryPlaceToRangeMap blockInfo = (sparse)
+			? getSparseRanges(getIndex(pBlock), false)
+			: getRanges(pBlock, inputRanges);
+		vector<MemoryPlaceRangePair> sortedBlockInfo(
+			blockInfo.begin(), blockInfo.end());
+
+		sort(sortedBlockInfo.begin(), sortedBlockInfo.end(),
+			sortBlockInfo);
+
+		BOOST_FOREACH(MemoryPlaceRangePair &mem, sortedBlockInfo) {
+			// Iterates over all memory places in the block.
+			if ((mem.first)->isArtificial())
+				continue;
+
+			// User variables and corresponding ranges in block are printed.
+			os << "\t" << (mem.first)->asString();
+			os << " = " << mem.second;
+		}
 
-			// Prints output ranges.
-			os << "Block " << block.name() << "[OUT]:" << endl;
+		// Prints output ranges.
+		os << "Block " << block.name() << "[OUT]:" << endl;
 
-			// Gets the result of analysis for the currently processed block.
-			MemoryPlaceToRangeMap &blockInfoOut = blockToOutputRangesMap[pBlock];
-			vector<MemoryPlaceRangePair> sortedBlockInfoOut(
-				blockInfoOut.begin(), blockInfoOut.end());
+		// Gets the result of analysis for the currently processed block.
+		const MemoryPlaceToRangeMap blockInfoOut = (sparse)
+			? getSparseRanges(getIndex(pBlock), true)
+			: getRanges(pBlock, outputRanges);
+		vector<MemoryPlaceRangePair> sortedBlockInfoOut(
+			blockInfoOut.begin(), blockInfoOut.end());
 
-			sort(sortedBlockInfoOut.begin(), sortedBlockInfoOut.end(),
-				sortBlockInfo);
+		sort(sortedBlockInfoOut.begin(), sortedBlockInfoOut.end(),
+			sortBlockInfo);
 
-			BOOST_FOREACH(MemoryPlaceRangePair &mem, sortedBlockInfoOut) {
-				// Iterates over all memory places in the block.
-				if ((mem.first)->isArtificial())
-					continue;
+		BOOST_FOREACH(MemoryPlaceRangePair &mem, sortedBlockInfoOut) {
+			// Iterates over all memory places in the block.
+			if ((mem.first)->isArtificial())
+				continue;
 
-				// User variables and corresponding ranges in block are printed.
-				os << "\t" << (mem.first)->asString();
-				os << " = " << mem.second;
-			}
+			// User variables and corresponding ranges in block are printed.
+			os << "\t" << (mem.first)->asString();
+			os << " = " << mem.second;
 		}
 	}
 	return os;
@@ -1144,3 +2113,131 @@ ValueAnalysis::MemoryPlaceToRangeMap ValueAnalysis::join(const
 	return result;
 }
 
+/**
+* @brief Gets the @a range of the given @a mp at the exit of the given @a block
+*        of the analysed function. It returns @c false if the range is not known,
+*        e.g. because the block has never been reached.
+*/
+bool ValueAnalysis::getRangeAtExit(const Block *block, const MemoryPlace *mp,
+								   Range &range) const
+{
+	const unsigned idx = getIndex(block);
+	if (sparse) {
+		if (!reachable[idx])
+			return false;
+
+		const Range *result = lookup(idx, mp, true);
+		if (!result)
+			return false;
+
+		range = *result;
+		return true;
+	}
+
+	const MemoryPlaceToRangeMap &ranges = outputRanges[idx];
+	MemoryPlaceToRangeMap::const_iterator it = ranges.find(mp);
+	if (it == ranges.end())
+		return false;
+
+	range = it->second;
+	return true;
+}
+
+/**
+* @brief Computes value-range analysis for all defined functions of the given
+*        @a stor. The analysis contexts are stored into @a fncToAnalysis, the
+*        caller is responsible for deleting them.
+*/
+void ValueAnalysis::computeAnalysisForStorage(const Storage &stor, bool sparse,
+											  FncToAnalysisMap &fncToAnalysis)
+{
+	LoopFinder::computeLoopAnalysis(stor);
+	GlobAnalysis::computeGlobAnalysis(stor);
+
+	// Computes the level of each SCC of the call graph. The callees of an SCC
+	// are on the lower levels, so the functions of one level can be analysed
+	// concurrently once the summaries of the lower levels are known.
+	const CodeStorage::CallGraph::TSccList &sccs = stor.callGraph.sccs;
+	std::vector<unsigned> sccLevels(sccs.size(), 0);
+	std::vector<std::vector<unsigned> > levels;
+	for (unsigned i = 0; i < sccs.size(); ++i) {
+		BOOST_FOREACH(const Fnc *pFnc, sccs[i]) {
+			BOOST_FOREACH(CodeStorage::TInsnListByFnc::const_reference call,
+						  pFnc->cgNode->calls) {
+				const Fnc *callee = call.first;
+				if (callee == NULL || callee->cgNode->scc == i)
+					continue;
+
+				sccLevels[i] = std::max(sccLevels[i],
+										sccLevels[callee->cgNode->scc] + 1);
+			}
+		}
+
+		if (levels.size() <= sccLevels[i])
+			levels.resize(sccLevels[i] + 1);
+
+		levels[sccLevels[i]].push_back(i);
+	}
+
+	FncSummaryMap summaries;
+
+	BOOST_FOREACH(const std::vector<unsigned> &level, levels) {
+		// Collects the defined functions, each of them gets its own context.
+		std::vector<const Fnc *> fncs;
+		std::vector<MemoryPlaceToRangeMap> sccGlobs;
+		BOOST_FOREACH(unsigned i, level) {
+			// Gets the global variables that can be modified by the SCC.
+			MemoryPlaceToRangeMap globs;
+			BOOST_FOREACH(const Fnc *pFnc, sccs[i]) {
+				if (!isDefined(*pFnc))
+					continue;
+
+				fncs.push_back(pFnc);
+				BOOST_FOREACH(const CodeStorage::Block *block, pFnc->cfg) {
+					BOOST_FOREACH(const CodeStorage::Insn *insn, *block) {
+						collectGlobWrites(insn, globs);
+					}
+				}
+
+				BOOST_FOREACH(CodeStorage::TInsnListByFnc::const_reference call,
+							  pFnc->cgNode->calls) {
+					const Fnc *callee = call.first;
+					if (callee == NULL || !summaries.count(uidOf(*callee)))
+						continue;
+
+					const MemoryPlaceToRangeMap &calleeGlobs =
+						summaries[uidOf(*callee)].modifiedGlobs;
+					globs.insert(calleeGlobs.begin(), calleeGlobs.end());
+				}
+			}
+
+			// The recursive calls inside of the SCC are not resolved, they
+			// can return anything and modify the global variables arbitrarily.
+			BOOST_FOREACH(const Fnc *pFnc, sccs[i]) {
+				if (!isDefined(*pFnc))
+					continue;
+
+				FncSummary &summary = summaries[uidOf(*pFnc)];
+				summary.modifiedGlobs = globs;
+				summary.globRanges = globs;
+				sccGlobs.push_back(globs);
+			}
+		}
+
+		std::vector<ValueAnalysis *> analyses(fncs.size());
+		for (unsigned i = 0; i < fncs.size(); ++i) {
+			analyses[i] = new ValueAnalysis(*fncs[i], sparse, &summaries);
+			fncToAnalysis[fncs[i]] = analyses[i];
+		}
+
+		// The contexts do not share any mutable data and the summaries are
+		// read only, the functions can be analysed concurrently.
+		CodeStorage::parallelFor(analyses.size(), [&analyses](unsigned i) {
+			analyses[i]->computeAnalysisForFnc();
+		});
+
+		for (unsigned i = 0; i < fncs.size(); ++i) {
+			summaries[uidOf(*fncs[i])] = analyses[i]->computeSummary(sccGlobs[i]);
+		}
+	}
+}
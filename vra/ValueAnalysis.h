@@ -17,6 +17,7 @@
 #include <vector>
 #include <set>
 #include <queue>
+#include <functional>
 
 #include "Range.h"
 #include "MemoryPlace.h"
@@ -26,9 +27,27 @@
 * @brief Class performs the value-range analysis and stores the result.
 *
 * It implements functions for computing the value-range analysis for a function,
-* for a block, for an instruction and so on. It stores the result of the
-* analysis per each function of the program. For each memory place in every block,
-* the final range is stored. Class is also responsible for printing tabular output.
+* for a block, for an instruction and so on. One instance of the class is the
+* analysis context of a single function, it stores the result of the analysis of
+* the function. For each memory place in every block, the final range is stored.
+* The contexts do not share any mutable data, so several functions can be analysed
+* concurrently. Class is also responsible for printing tabular output.
+*
+* In the sparse mode, the ranges are not propagated through every block. Each
+* block stores only the ranges of memory places it defines and the ranges joined
+* at its entry. The joins are placed at the iterated dominance frontiers of the
+* definitions (as phi-functions of SSA), so the range of a memory place at any
+* block is found by walking the dominator tree up to the reaching definition.
+* A block is analysed again only if a range it reads has changed.
+*
+* Ranges that still change after a few passes are widened to the nearest
+* constants from the loop conditions of the function, see LoopFinder. Once the
+* fixpoint is reached, a bounded number of narrowing passes takes back what the
+* widening has over-approximated.
+*
+* At the call sites, the ranges of the returned value and of the modified global
+* variables are taken from the summary of the called function, if there is one.
+* The summaries are computed bottom-up and do not depend on the arguments.
 */
 class ValueAnalysis {
 	public:
@@ -38,14 +57,38 @@ class ValueAnalysis {
 		/// Type of the pair consisting of memory place and corresponding range.
 		typedef std::pair<const MemoryPlace*, Range> MemoryPlaceRangePair;
 
-	private:
-		/// Just for assurance that nobody will try to use it.
-		ValueAnalysis() { }
+		/// Type for representing set of memory places.
+		typedef std::set<const MemoryPlace *> MemoryPlaceSet;
+
+		/// Summary of a function, it is used at the call sites of the function.
+		struct FncSummary {
+			/// @c true if the range of the returned value is known.
+			bool hasRetRange;
 
-		/// Stores maximal number of passes through the block or zero if we do
-		/// not know.
-		static LoopFinder::BlockToUpperLimit tripCountOfBlockMap;
+			/// Range of the returned value.
+			Range retRange;
 
+			/// Maximal ranges of the global variables that can be modified by
+			/// the function (or by any function it calls).
+			MemoryPlaceToRangeMap modifiedGlobs;
+
+			/// Ranges of the modified global variables at the exit of the function.
+			MemoryPlaceToRangeMap globRanges;
+
+			/// Modified global variables that keep their ranges on some path
+			/// through the function.
+			MemoryPlaceSet keptGlobs;
+
+			FncSummary(): hasRetRange(false) {}
+		};
+
+		/// Type for mapping unique ids of functions to their summaries.
+		typedef std::map<int, FncSummary> FncSummaryMap;
+
+		/// Type for mapping functions to their analysis contexts.
+		typedef std::map<const CodeStorage::Fnc *, ValueAnalysis *> FncToAnalysisMap;
+
+	private:
 		/// Type for representing key into map that stores trimmed ranges.
 		struct TrimmedKey {
 			/// Pointer to the memory place for the condition variable.
@@ -78,59 +121,137 @@ class ValueAnalysis {
 					return varMp < key.varMp;
 				}
 			}
+
+			/// Comparison on equality, it is necessary for comparing the maps.
+			bool operator==(const TrimmedKey &key) const {
+				return conditionMp == key.conditionMp && block == key.block
+					&& varMp == key.varMp;
+			}
 		};
 
 		/// Type for trimmed ranges stored for one block.
 		typedef std::map<TrimmedKey, Range> TrimmedRangesMap;
 
-		/// Type for trimmed ranges stored for every block in the analyzed program.
-		typedef std::map<const CodeStorage::Block*, TrimmedRangesMap>
-			BlockToTrimmedRangesMap;
-
 		/// Type of data stored for several blocks.
 		typedef std::vector<MemoryPlaceToRangeMap> MemoryPlaceToRangeMapVector;
 
-		/// Type of data stored for the whole analyzed program.
-		typedef std::map<const CodeStorage::Block*, MemoryPlaceToRangeMap>
-			BlockToResultMap;
+		/// Type for mapping blocks of the function to their ordinals.
+		typedef std::map<const CodeStorage::Block *, unsigned> BlockToIndexMap;
 
-		/// Type for representing scheduler.
-		typedef std::queue<const CodeStorage::Block *> SchedulerQueue;
+		/// Type for representing scheduler, the block with the lowest ordinal
+		/// is processed first, so the inner loops converge before the blocks
+		/// that follow them are processed.
+		typedef std::priority_queue<unsigned, std::vector<unsigned>,
+				std::greater<unsigned> > SchedulerQueue;
 
-		/// Type for representing scheduler.
-		typedef std::set<const CodeStorage::Block *> SchedulerSet;
+		/// Type for mapping memory places to the blocks that read their ranges.
+		typedef std::map<const MemoryPlace *, std::vector<const CodeStorage::Block *> >
+			MemoryPlaceToUsersMap;
 
-		/// Type for representing block counter.
-		typedef std::map<const CodeStorage::Block *, unsigned> BlockToCounterMap;
+		/// Specifies how many times the block is executed (besides the trip
+		/// counts of the loops) before the changing ranges will be widened.
+		static const unsigned NumberOfPassesBeforeWidening;
 
-		/// Mapping block to the trimmed ranges of this block.
-		static BlockToTrimmedRangesMap blockToTrimmedRangesMap;
+		/// Specifies how many times the block is executed before the changing
+		/// ranges, which are not bounded by any threshold, will be widened to
+		/// the limits of their types.
+		static const unsigned NumberOfPassesBeforeExpand;
 
-		/// Mapping block to the input ranges of this block.
-		static BlockToResultMap blockToInputRangesMap;
+		/// Maximal number of narrowing passes over the function.
+		static const unsigned NumberOfNarrowingPasses;
 
-		/// Mapping block to the output ranges of this block.
-		static BlockToResultMap blockToOutputRangesMap;
+		/// The analysed function.
+		const CodeStorage::Fnc &fnc;
 
-		/// Block scheduler.
-		static SchedulerQueue todoQueue;
+		/// Blocks of the function in reverse postorder, all the vectors below are
+		/// indexed as this one.
+		std::vector<const CodeStorage::Block *> blocks;
+
+		/// Mapping block to its ordinal in @c blocks.
+		BlockToIndexMap blockToIndexMap;
+
+		/// Trimmed ranges of each block.
+		std::vector<TrimmedRangesMap> trimmedRanges;
+
+		/// Input ranges of each block.
+		MemoryPlaceToRangeMapVector inputRanges;
+
+		/// Output ranges of each block.
+		MemoryPlaceToRangeMapVector outputRanges;
 
 		/// Block scheduler.
-		static SchedulerSet todoSet;
+		SchedulerQueue todoQueue;
 
-		/// Specifies how many times the block is executed before the expansion
-		/// of changing ranges will be performed.
-		static const unsigned NumberOfPassesBeforeExpand;
+		/// Block scheduler, @c true if the block is in @c todoQueue.
+		std::vector<bool> todoSet;
 
 		/// Stores how many times was the block executed.
-		static BlockToCounterMap blockToCounterMap;
+		std::vector<unsigned> blockCounter;
+
+		/// Stores how many times was the block executed since it has reached its
+		/// maximal number of passes (if known) last time.
+		std::vector<unsigned long> tripCountOfBlock;
+
+		/// @c true if the ranges are propagated along def-use chains.
+		bool sparse;
+
+		/// Summaries of the called functions or @c NULL.
+		const FncSummaryMap *summaries;
+
+		/// Constants from the loop conditions, the ranges are widened to them.
+		const LoopFinder::Thresholds &thresholds;
+
+		/// How many times the block is executed before its changing ranges
+		/// will be widened. It exceeds the longest known trip count of the loops
+		/// in the function, so these loops are still computed exactly.
+		unsigned passesBeforeWidening;
+
+		/// @c true during the narrowing passes.
+		bool narrowing;
+
+		/// Sparse mode: @c false for blocks unreachable from the entry block.
+		std::vector<bool> reachable;
+
+		/// Sparse mode: ordinal of the immediate dominator of each block or -1.
+		std::vector<int> idomIndex;
+
+		/// Sparse mode: memory places defined in each block.
+		std::vector<MemoryPlaceSet> defs;
+
+		/// Sparse mode: memory places read by each block.
+		std::vector<MemoryPlaceSet> uses;
 
-		static void scheduleBlock(const CodeStorage::Block *block);
+		/// Sparse mode: memory places whose ranges are joined at entry of each block.
+		std::vector<MemoryPlaceSet> joins;
 
-		static MemoryPlaceToRangeMap getRanges(const CodeStorage::Block* block,
-											   const BlockToResultMap &inputMap);
+		/// Sparse mode: all memory places defined or joined in the function.
+		MemoryPlaceSet allVars;
 
-		static TrimmedRangesMap getTrimmedRanges(const CodeStorage::Block* block);
+		/// Sparse mode: ranges of the memory places defined in each block (at its
+		/// exit).
+		MemoryPlaceToRangeMapVector defRanges;
+
+		/// Sparse mode: ranges of the memory places joined at entry of each block.
+		MemoryPlaceToRangeMapVector joinRanges;
+
+		/// Sparse mode: blocks that read the definitions of each block.
+		std::vector<MemoryPlaceToUsersMap> defUsers;
+
+		/// Sparse mode: blocks that read the joins of each block.
+		std::vector<MemoryPlaceToUsersMap> joinUsers;
+
+		// Not copyable.
+		ValueAnalysis(const ValueAnalysis &);
+		ValueAnalysis& operator=(const ValueAnalysis &);
+
+		unsigned getIndex(const CodeStorage::Block *block) const;
+
+		void scheduleBlock(const CodeStorage::Block *block);
+
+		const MemoryPlaceToRangeMap& getRanges(const CodeStorage::Block* block,
+									const MemoryPlaceToRangeMapVector &vec) const;
+
+		const TrimmedRangesMap& getTrimmedRanges(const CodeStorage::Block* block) const;
 
 		static MemoryPlaceToRangeMap join(const MemoryPlaceToRangeMapVector &vec);
 
@@ -139,21 +260,28 @@ class ValueAnalysis {
 											const MemoryPlaceToRangeMap &out,
 											const TrimmedRangesMap &trimmed);
 
-		static void computeInputRanges(const CodeStorage::Block *current);
+		void computeInputRanges(const CodeStorage::Block *current);
 
-		static void expandChangingRanges(const CodeStorage::Block *block,
-										 const MemoryPlaceToRangeMap &oldResult,
-										 const MemoryPlaceToRangeMap &newResult);
+		Range widenRange(unsigned idx, const Range &r, const Range &old) const;
 
-		static void computeAnalysisForBlock(const CodeStorage::Block *block);
+		void widenChangingRanges(const CodeStorage::Block *block,
+								 const MemoryPlaceToRangeMap &oldResult,
+								 const MemoryPlaceToRangeMap &newResult);
 
-		static void computeAnalysisForInsn(const CodeStorage::Insn *insn,
-										   const CodeStorage::Insn *prevInsn,
-										   MemoryPlaceToRangeMap &output);
+		static void narrowRanges(MemoryPlaceToRangeMap &ranges,
+								 const MemoryPlaceToRangeMap &oldRanges);
 
-		static void computeAnalysisForCond(const CodeStorage::Insn *insn,
-										   const CodeStorage::Insn *prevInsn,
-										   MemoryPlaceToRangeMap &output);
+		void narrowAnalysisForFnc();
+
+		void computeAnalysisForBlock(const CodeStorage::Block *block);
+
+		void computeAnalysisForInsn(const CodeStorage::Insn *insn,
+									const CodeStorage::Insn *prevInsn,
+									MemoryPlaceToRangeMap &output);
+
+		void computeAnalysisForCond(const CodeStorage::Insn *insn,
+									const CodeStorage::Insn *prevInsn,
+									MemoryPlaceToRangeMap &output);
 
 		static void computeAnalysisForUnop(const CodeStorage::Insn *insn,
 										   MemoryPlaceToRangeMap &output);
@@ -161,8 +289,10 @@ class ValueAnalysis {
 		static void computeAnalysisForBinop(const CodeStorage::Insn *insn,
 										    MemoryPlaceToRangeMap &output);
 
-		static void computeAnalysisForCall(const CodeStorage::Insn* insn,
-										   MemoryPlaceToRangeMap &output);
+		const FncSummary *getSummary(const CodeStorage::Insn *insn) const;
+
+		void computeAnalysisForCall(const CodeStorage::Insn* insn,
+									MemoryPlaceToRangeMap &output);
 
 		static Range getRange(const struct cl_operand &src,
 							  MemoryPlaceToRangeMap &output,
@@ -194,12 +324,55 @@ class ValueAnalysis {
 		static bool evaluateCond(const Range &r1, const Range &r2,
 			const enum cl_binop_e code);
 
+		void collectDefsAndUses(const CodeStorage::Insn *insn,
+								MemoryPlaceSet &defs, MemoryPlaceSet &uses) const;
+
+		static void collectTrimmedVars(const CodeStorage::Block *block,
+									   MemoryPlaceSet &vars);
+
+		void buildDefUseChains();
+
+		int findReachingDef(unsigned idx, const MemoryPlace *mp, bool &atExit) const;
+
+		const Range *lookup(unsigned idx, const MemoryPlace *mp, bool atExit) const;
+
+		MemoryPlaceToRangeMap getSparseRanges(unsigned idx, bool atExit) const;
+
+		void addUser(const CodeStorage::Block *user, unsigned idx,
+					 const MemoryPlace *mp, bool atExit);
+
+		void scheduleUsers(const MemoryPlaceToUsersMap &users, const MemoryPlace *mp,
+						   const CodeStorage::Block *current = NULL);
+
+		void computeJoins(unsigned idx);
+
+		void computeSparseAnalysisForBlock(unsigned idx);
+
+		void computeSparseAnalysisForFnc();
+
+		const Range *getExitRange(unsigned idx, const MemoryPlace *mp) const;
+
+		MemoryPlaceSet computeKeptGlobs(const MemoryPlaceToRangeMap &globs) const;
+
 	public:
+		explicit ValueAnalysis(const CodeStorage::Fnc &fnc, bool sparse = false,
+							   const FncSummaryMap *summaries = NULL);
+
+		void computeAnalysisForFnc();
+
+		static void computeAnalysisForStorage(const CodeStorage::Storage &stor,
+											  bool sparse,
+											  FncToAnalysisMap &fncToAnalysis);
+
+		bool getRangeAtExit(const CodeStorage::Block *block, const MemoryPlace *mp,
+							Range &range) const;
+
+		FncSummary computeSummary(const MemoryPlaceToRangeMap &modifiedGlobs) const;
 
-		static std::ostream& printRanges(std::ostream &os,
-										 const CodeStorage::Storage &stor);
+		static void collectGlobWrites(const CodeStorage::Insn *insn,
+									  MemoryPlaceToRangeMap &globs);
 
-		static void computeAnalysisForFnc(const CodeStorage::Fnc &fnc);
+		std::ostream& printRanges(std::ostream &os) const;
 };
 
 #endif
@@ -0,0 +1,17 @@
+/**
+* @file test-0083.c
+*
+* @brief Loop with an unknown trip count, the bound is narrowed at its exit.
+*/
+
+int main(int argc, const char *argv[]) {
+	int i = 0;
+	int step = 1;
+
+	while (i < 100) {
+		i += step;
+		step = 3 - step;
+	}
+
+	return 0;
+}
@@ -0,0 +1,23 @@
+/**
+* @file test-0084.c
+*
+* @brief The range of the value returned by the callee is used by the caller.
+*/
+
+int sign(int x);
+
+int main(int argc, const char *argv[]) {
+	int s = sign(argc);
+	return 0;
+}
+
+int sign(int x)
+{
+	if (x < 0)
+		return -1;
+
+	if (x > 0)
+		return 1;
+
+	return 0;
+}
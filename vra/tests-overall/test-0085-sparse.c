@@ -0,0 +1,17 @@
+/**
+* @file test-0085-sparse.c
+*
+* @brief The same as test-0085.c, analysed in the sparse mode.
+*/
+
+int main(int argc, const char *argv[]) {
+	int x;
+
+	if (argc > 1)
+		x = 5;
+
+	if (x == 5)
+		return 1;
+
+	return 0;
+}
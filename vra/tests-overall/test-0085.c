@@ -0,0 +1,17 @@
+/**
+* @file test-0085.c
+*
+* @brief A variable assigned only on one of the paths can hold any value.
+*/
+
+int main(int argc, const char *argv[]) {
+	int x;
+
+	if (argc > 1)
+		x = 5;
+
+	if (x == 5)
+		return 1;
+
+	return 0;
+}
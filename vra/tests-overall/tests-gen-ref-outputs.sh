@@ -24,8 +24,13 @@ for test_file in $(find "$TESTS_PATH" -name "$TEST_REGEXP" | sort); do
 	# Generate the reference file name.
 	ref_file="$test_file"".ref"
 
-	# Run the analyzer to obtain the reference output.
-	$ANALYSIS_CMD $test_file 2> /dev/null > $ref_file
+	# Run the analyzer (in the sparse mode for *-sparse.c) to obtain the
+	# reference output.
+	args=""
+	case "$test_name" in
+		*-sparse.c) args="$SPARSE_ARGS" ;;
+	esac
+	$ANALYSIS_CMD $args $test_file 2> /dev/null > $ref_file
 	if [ ! -e "$ref_file" ]; then
 		# There was an error during the analysis.
 		emit_indent $test_name
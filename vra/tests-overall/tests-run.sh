@@ -32,8 +32,12 @@ for test_file in $(find "$TESTS_PATH" -name "$TEST_REGEXP" | sort); do
 	ref_file="$test_file"".ref"
 	out_file="$test_file"".out"
 
-	# Run the analyzer to obtain the output.
-	$ANALYSIS_CMD $test_file 2> /dev/null > $out_file
+	# Run the analyzer (in the sparse mode for *-sparse.c) to obtain the output.
+	args=""
+	case "$test_name" in
+		*-sparse.c) args="$SPARSE_ARGS" ;;
+	esac
+	$ANALYSIS_CMD $args $test_file 2> /dev/null > $out_file
 	if [ ! -e "$out_file" ]; then
 		# There was an error during the analysis, so skip the comparison to the
 		# reference output.
@@ -46,6 +46,18 @@ VariableTest)
 	EXPECT_FALSE(m.isArtificial());
 }
 
+TEST_F(MemoryPlaceTest,
+GlobalVariableTest)
+{
+	MemoryPlace m("var", false, true);
+	EXPECT_EQ("var", m.asString());
+	EXPECT_FALSE(m.isArtificial());
+	EXPECT_TRUE(m.isGlobal());
+
+	MemoryPlace n("var", false);
+	EXPECT_FALSE(n.isGlobal());
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // item of a structure as a memory place
 ////////////////////////////////////////////////////////////////////////////////
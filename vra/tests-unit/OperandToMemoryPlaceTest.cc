@@ -66,6 +66,35 @@ VariableIsConvertedToMemoryPlace)
 	delete op1.data.var;
 }
 
+TEST_F(OperandToMemoryPlaceTest,
+GlobalVariableIsConvertedToGlobalMemoryPlace)
+{
+	struct cl_operand op1;
+	op1.code = CL_OPERAND_VAR;
+	op1.scope = CL_SCOPE_GLOBAL;
+	op1.accessor = NULL;
+	op1.data.var = new struct cl_var;
+	op1.data.var->uid = 2570;
+	op1.data.var->name = "variable_g";
+	op1.data.var->artificial = false;
+	op1.type = new struct cl_type;
+	op1.type->item_cnt = 0;
+
+	struct cl_operand op2 = op1;
+	op2.scope = CL_SCOPE_FUNCTION;
+	op2.data.var = new struct cl_var;
+	op2.data.var->uid = 2571;
+	op2.data.var->name = "variable_l";
+	op2.data.var->artificial = false;
+
+	ASSERT_TRUE(OperandToMemoryPlace::convert(&op1)->isGlobal());
+	ASSERT_FALSE(OperandToMemoryPlace::convert(&op2)->isGlobal());
+
+	delete op1.type;
+	delete op1.data.var;
+	delete op2.data.var;
+}
+
 TEST_F(OperandToMemoryPlaceTest,
 TwoIdenticalVariablesAreConvertedToTheSameMemoryPlace)
 {
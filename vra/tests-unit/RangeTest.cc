@@ -2847,6 +2847,103 @@ ExpandForFloatingPointsWorksCorrectly)
 		Range(F<float>(1)).expand());
 }
 
+////////////////////////////////////////////////////////////////////////////////
+// widen()
+////////////////////////////////////////////////////////////////////////////////
+
+TEST_F(RangeTest,
+WidenRaisesGrowingMaximumToNearestThreshold)
+{
+	vector<Number> thresholds;
+	thresholds.push_back(I<int>(9));
+	thresholds.push_back(I<int>(10));
+	thresholds.push_back(I<int>(100));
+
+	// (0, 1) after (0, 0) -> (0, 9)
+	EXPECT_EQ(Range(Interval(I<int>(0), I<int>(9))),
+		Range(Interval(I<int>(0), I<int>(1))).widen(
+			Range(I<int>(0)), thresholds));
+
+	// (0, 10) after (0, 9) -> (0, 10)
+	EXPECT_EQ(Range(Interval(I<int>(0), I<int>(10))),
+		Range(Interval(I<int>(0), I<int>(10))).widen(
+			Range(Interval(I<int>(0), I<int>(9))), thresholds));
+
+	// (0, 101) after (0, 100) -> (0, MAX)
+	EXPECT_EQ(Range(Interval(I<int>(0), I<int>(vmax<int>()))),
+		Range(Interval(I<int>(0), I<int>(101))).widen(
+			Range(Interval(I<int>(0), I<int>(100))), thresholds));
+}
+
+TEST_F(RangeTest,
+WidenLowersDroppingMinimumToNearestThreshold)
+{
+	vector<Number> thresholds;
+	thresholds.push_back(I<int>(-1));
+	thresholds.push_back(I<int>(5));
+
+	// (4, 10) after (5, 10) -> (-1, 10)
+	EXPECT_EQ(Range(Interval(I<int>(-1), I<int>(10))),
+		Range(Interval(I<int>(4), I<int>(10))).widen(
+			Range(Interval(I<int>(5), I<int>(10))), thresholds));
+
+	// (-2, 10) after (-1, 10) -> (MIN, 10)
+	EXPECT_EQ(Range(Interval(I<int>(vmin<int>()), I<int>(10))),
+		Range(Interval(I<int>(-2), I<int>(10))).widen(
+			Range(Interval(I<int>(-1), I<int>(10))), thresholds));
+}
+
+TEST_F(RangeTest,
+WidenKeepsInnerIntervalsAndStableBounds)
+{
+	vector<Number> thresholds;
+	thresholds.push_back(I<int>(50));
+
+	// (0, 1) + (5, 6) after (0, 1) + (5, 5) -> (0, 1) + (5, 50)
+	EXPECT_EQ(Range(Interval(I<int>(0), I<int>(1)),
+			Interval(I<int>(5), I<int>(50))),
+		Range(Interval(I<int>(0), I<int>(1)),
+			Interval(I<int>(5), I<int>(6))).widen(
+			Range(Interval(I<int>(0), I<int>(1)),
+				Interval(I<int>(5), I<int>(5))), thresholds));
+}
+
+TEST_F(RangeTest,
+WidenMergesIntervalsWhenOnlyInnerBoundsMove)
+{
+	vector<Number> thresholds;
+	thresholds.push_back(I<int>(50));
+
+	// (MIN, MIN + 1) + (1, MAX) after (MIN, MIN) + (1, MAX) -> (MIN, MAX)
+	EXPECT_EQ(Range(Interval(I<int>(vmin<int>()), I<int>(vmax<int>()))),
+		Range(Interval(I<int>(vmin<int>()), I<int>(vmin<int>() + 1)),
+			Interval(I<int>(1), I<int>(vmax<int>()))).widen(
+			Range(Interval(I<int>(vmin<int>()), I<int>(vmin<int>())),
+				Interval(I<int>(1), I<int>(vmax<int>()))), thresholds));
+}
+
+TEST_F(RangeTest,
+WidenIgnoresThresholdsNotFittingIntoType)
+{
+	vector<Number> thresholds;
+	thresholds.push_back(I<int>(-1));
+	thresholds.push_back(I<int>(300));
+
+	// (0, 1) after (0, 0) -> (0, 255)
+	EXPECT_EQ(Range(Interval(I<unsigned char>(0), I<unsigned char>(255))),
+		Range(Interval(I<unsigned char>(0), I<unsigned char>(1))).widen(
+			Range(I<unsigned char>(0)), thresholds));
+}
+
+TEST_F(RangeTest,
+WidenForFloatingPointsReturnsMaximalRange)
+{
+	EXPECT_EQ(Range(Interval(F<float>(NAN), F<float>(NAN)),
+			Interval(F<float>(-INFINITY), F<float>(INFINITY))),
+		Range(Interval(F<float>(1), F<float>(2))).widen(
+			Range(F<float>(1)), vector<Number>()));
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // mergeIntervals()
 ////////////////////////////////////////////////////////////////////////////////
@@ -4699,6 +4796,19 @@ TruncDivWorksCorrectlyWhenDividingSignedIntWithSignedInt)
 			Range(Interval(I<int>(-3), I<int>(-1)), Interval(I<int>(1), I<int>(3)))));
 }
 
+TEST_F(RangeTest,
+TruncDivKeepsValuesBetweenQuotientsOfBounds)
+{
+	// (0, 100) / (9, 9)
+	EXPECT_EQ(Range(Interval(I<int>(0), I<int>(11))),
+		trunc_div(Range(Interval(I<int>(0), I<int>(100))),
+			Range(Interval(I<int>(9), I<int>(9)))));
+	// (-160, 1340) / (9, 9)
+	EXPECT_EQ(Range(Interval(I<int>(-17), I<int>(148))),
+		trunc_div(Range(Interval(I<int>(-160), I<int>(1340))),
+			Range(Interval(I<int>(9), I<int>(9)))));
+}
+
 TEST_F(RangeTest,
 TruncDivWorksCorrectlyWhenDividingUnsignedIntWithUnsignedInt)
 {
@@ -0,0 +1,148 @@
+/**
+* @author agent, agent@local
+* @file   SmallVectorTest.cc
+* @brief  Test class for class SmallVector.
+* @date   2026
+*/
+
+#include <string>
+
+#include "SmallVector.h"
+#include "gtest/gtest.h"
+
+using namespace std;
+
+class SmallVectorTest : public ::testing::Test {
+	protected:
+		/// Container with inline storage for two strings.
+		typedef SmallVector<string, 2> Strings;
+
+		SmallVectorTest() {
+		}
+
+		virtual ~SmallVectorTest() {
+		}
+
+		virtual void SetUp() {
+		}
+
+		virtual void TearDown() {
+		}
+
+};
+
+TEST_F(SmallVectorTest,
+EmptyContainerIsInline)
+{
+	Strings v;
+	EXPECT_TRUE(v.empty());
+	EXPECT_EQ(0U, v.size());
+	EXPECT_TRUE(v.isInline());
+	EXPECT_TRUE(v.begin() == v.end());
+}
+
+TEST_F(SmallVectorTest,
+ElementsAreInlineUpToCapacity)
+{
+	Strings v;
+	v.push_back("a");
+	v.push_back("b");
+	EXPECT_TRUE(v.isInline());
+	EXPECT_EQ(2U, v.size());
+	EXPECT_EQ("a", v.front());
+	EXPECT_EQ("b", v.back());
+}
+
+TEST_F(SmallVectorTest,
+ElementsMoveToHeapWhenCapacityIsExceeded)
+{
+	Strings v;
+	for (int i = 0; i < 10; ++i)
+		v.push_back(string(1, 'a' + i));
+
+	EXPECT_FALSE(v.isInline());
+	ASSERT_EQ(10U, v.size());
+	for (int i = 0; i < 10; ++i)
+		EXPECT_EQ(string(1, 'a' + i), v[i]);
+}
+
+TEST_F(SmallVectorTest,
+PushBackOfOwnElementWorksCorrectly)
+{
+	Strings v;
+	v.push_back("a");
+	v.push_back("b");
+	v.push_back(v.front());
+	ASSERT_EQ(3U, v.size());
+	EXPECT_EQ("a", v[2]);
+}
+
+TEST_F(SmallVectorTest,
+EraseWorksCorrectly)
+{
+	Strings v;
+	v.push_back("a");
+	v.push_back("b");
+	v.push_back("c");
+	v.push_back("d");
+	v.erase(v.begin() + 1, v.begin() + 3);
+	ASSERT_EQ(2U, v.size());
+	EXPECT_EQ("a", v[0]);
+	EXPECT_EQ("d", v[1]);
+
+	v.erase(v.begin(), v.end());
+	EXPECT_TRUE(v.empty());
+}
+
+TEST_F(SmallVectorTest,
+CopyAndComparisonWorkCorrectly)
+{
+	Strings v1;
+	v1.push_back("a");
+	Strings v2(v1);
+	EXPECT_TRUE(v1 == v2);
+
+	v2.push_back("b");
+	v2.push_back("c");
+	EXPECT_TRUE(v1 != v2);
+
+	v1 = v2;
+	EXPECT_TRUE(v1 == v2);
+	EXPECT_FALSE(v1.isInline());
+}
+
+TEST_F(SmallVectorTest,
+SwapWorksCorrectly)
+{
+	Strings v1;
+	v1.push_back("a");
+	Strings v2;
+	v2.push_back("b");
+	v2.push_back("c");
+	v2.push_back("d");
+
+	swap(v1, v2);
+	ASSERT_EQ(3U, v1.size());
+	EXPECT_EQ("d", v1.back());
+	ASSERT_EQ(1U, v2.size());
+	EXPECT_EQ("a", v2.front());
+}
+
+TEST_F(SmallVectorTest,
+ReverseIterationWorksCorrectly)
+{
+	Strings v;
+	v.push_back("a");
+	v.push_back("b");
+	v.push_back("c");
+	string result;
+	for (Strings::const_reverse_iterator it = v.rbegin(); it != v.rend(); ++it)
+		result += *it;
+	EXPECT_EQ("cba", result);
+}
+
+int main(int argc, char *argv[])
+{
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
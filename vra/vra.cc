@@ -8,12 +8,12 @@
 #undef NDEBUG   // It is necessary for using assertions.
 
 #include <iostream>
+#include <sstream>
+#include <string>
 #include <boost/foreach.hpp>
 #include <cl/easy.hh>
 
 #include "ValueAnalysis.h"
-#include "LoopFinder.h"
-#include "GlobAnalysis.h"
 
 // required by the gcc plug-in API
 extern "C" {
@@ -23,22 +23,32 @@ extern "C" {
 using CodeStorage::Fnc;
 using CodeStorage::Storage;
 
-void clEasyRun(const Storage &stor, const char *)
+void clEasyRun(const Storage &stor, const char *configString)
 {
-	LoopFinder::computeLoopAnalysis(stor);
-	// LoopFinder::printLoopAnalysis(std::cout);
-
-	GlobAnalysis::computeGlobAnalysis(stor);
-	// GlobAnalysis::printGlobAnalysis(std::cout);
-
-	BOOST_FOREACH(const Fnc* pFnc, stor.fncs) {
-		const Fnc &fnc = *pFnc;
+	// The ranges are propagated along def-use chains if "sparse" is given in
+	// the comma-separated config string.
+	bool sparse = false;
+	std::istringstream configStream(configString);
+	std::string option;
+	while (std::getline(configStream, option, ',')) {
+		if (option == "sparse")
+			sparse = true;
+	}
 
-		if (!isDefined(fnc))
-			continue;
+	ValueAnalysis::FncToAnalysisMap fncToAnalysis;
+	ValueAnalysis::computeAnalysisForStorage(stor, sparse, fncToAnalysis);
 
-		ValueAnalysis::computeAnalysisForFnc(fnc);
+	// Prints the result in the order given by the call graph, so that the output
+	// does not depend on the scheduling of the threads.
+	BOOST_FOREACH(const Fnc* pFnc, stor.callGraph.topOrder) {
+		ValueAnalysis::FncToAnalysisMap::const_iterator it
+			= fncToAnalysis.find(pFnc);
+		if (it != fncToAnalysis.end())
+			it->second->printRanges(std::cout);
 	}
 
-	ValueAnalysis::printRanges(std::cout, stor);
+	BOOST_FOREACH(const ValueAnalysis::FncToAnalysisMap::value_type &item,
+				  fncToAnalysis) {
+		delete item.second;
+	}
 }